@@ -0,0 +1,476 @@
+//========= Copyright  1996-2001, Valve LLC, All rights reserved. ============
+//
+// Purpose: Microbenchmarks of the callback manager: listener registration
+//			churn, dispatch throughput and call result completion. Messages
+//			and call results come from fake steamclient routines injected with
+//			SteamAPI_SetCallbackSource(), so no Steam is needed.
+//
+//			Usage: callbackmgr_bench [churn|dispatch|completion]
+//
+//			Prints ns/op, manager allocations/op and the p50/p99/p999 of the
+//			per-sample ns/op. Random choices use a fixed seed, so runs are
+//			comparable before and after a change.
+//
+// $NoKeywords: $
+//=============================================================================
+
+#include "steam_api_pch.h"
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#define BENCH_CALLBACK_BASE			k_iSteamUserCallbacks
+#define BENCH_CALLBACK_IDS			8
+#define BENCH_CALLRESULT_ID			(k_iSteamGameServerCallbacks + 1)
+#define BENCH_PAYLOAD_SIZE			32
+#define BENCH_PIPE					1
+
+// Listeners kept registered while churn runs, so the table isn't empty
+#define BENCH_RESIDENT_LISTENERS	1024
+
+// Churn ops between frames that apply queued (un)registrations
+#define BENCH_CHURN_BATCH			256
+
+// Messages dispatched per message count, spread over the frames
+#define BENCH_DISPATCH_MESSAGES		2000000
+
+// Completions per frame and frames per outstanding handle count
+#define BENCH_COMPLETIONS_PER_FRAME	1000
+#define BENCH_COMPLETION_FRAMES		200
+
+typedef std::chrono::steady_clock BenchClock;
+
+//-----------------------------------------------------------------------------
+//
+// Fake steamclient routines
+//
+//-----------------------------------------------------------------------------
+
+// Plain messages left in the current frame
+static int								s_nMessagesLeft = 0;
+static int								s_iNextCallback = 0;
+
+// Calls completed in the current frame, go out before plain messages
+static std::vector<SteamAPICall_t>		s_CompletedCalls;
+static size_t							s_iNextCompletedCall = 0;
+static bool								s_bLastWasCompletion = false;
+
+static uint8							s_rgubPayload[BENCH_PAYLOAD_SIZE];
+static SteamAPICallCompleted_t			s_Completed;
+
+//-----------------------------------------------------------------------------
+// Purpose:
+//-----------------------------------------------------------------------------
+static bool Bench_BGetCallback(HSteamPipe hSteamPipe, CallbackMsg_t *pCallbackMsg)
+{
+	pCallbackMsg->m_hSteamUser = hSteamPipe;
+
+	if (s_iNextCompletedCall < s_CompletedCalls.size())
+	{
+		s_Completed.m_hAsyncCall = s_CompletedCalls[s_iNextCompletedCall];
+		s_bLastWasCompletion = true;
+
+		pCallbackMsg->m_iCallback = SteamAPICallCompleted_t::k_iCallback;
+		pCallbackMsg->m_pubParam = reinterpret_cast<uint8*>(&s_Completed);
+		pCallbackMsg->m_cubParam = sizeof(s_Completed);
+		return true;
+	}
+
+	if (!s_nMessagesLeft)
+		return false;
+
+	s_bLastWasCompletion = false;
+
+	pCallbackMsg->m_iCallback = BENCH_CALLBACK_BASE + s_iNextCallback;
+	pCallbackMsg->m_pubParam = s_rgubPayload;
+	pCallbackMsg->m_cubParam = sizeof(s_rgubPayload);
+
+	s_iNextCallback = (s_iNextCallback + 1) % BENCH_CALLBACK_IDS;
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose:
+//-----------------------------------------------------------------------------
+static void Bench_FreeLastCallback(HSteamPipe hSteamPipe)
+{
+	if (s_bLastWasCompletion)
+		s_iNextCompletedCall++;
+	else
+		s_nMessagesLeft--;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose:
+//-----------------------------------------------------------------------------
+static bool Bench_GetAPICallResult(HSteamPipe hSteamPipe, SteamAPICall_t hSteamAPICall, void *pCallback, int cubCallback, int iCallbackExpected, bool *pbFailed)
+{
+	memset(pCallback, 0, cubCallback);
+	*pbFailed = false;
+
+	return true;
+}
+
+static const SteamCallbackSource_t s_BenchCallbackSource =
+{
+	&Bench_BGetCallback,
+	&Bench_FreeLastCallback,
+	&Bench_GetAPICallResult,
+};
+
+//-----------------------------------------------------------------------------
+// Purpose: Listener and call result that only count runs
+//-----------------------------------------------------------------------------
+class CBenchListener : public CCallbackBase
+{
+public:
+	CBenchListener() :
+		m_nRuns(0)
+	{
+	}
+
+	void SetCallback(int iCallback)
+	{
+		m_iCallback = iCallback;
+	}
+
+	virtual void Run(void *pvParam)
+	{
+		m_nRuns++;
+	}
+
+	virtual void Run(void *pvParam, bool bIOFailure, SteamAPICall_t hSteamAPICall)
+	{
+		m_nRuns++;
+	}
+
+	virtual int GetCallbackSizeBytes()
+	{
+		return BENCH_PAYLOAD_SIZE;
+	}
+
+	uint64 m_nRuns;
+};
+
+//-----------------------------------------------------------------------------
+//
+// Results
+//
+//-----------------------------------------------------------------------------
+
+struct BenchResult_t
+{
+	uint64				m_nOps;
+	double				m_flNanoseconds;
+	uint64				m_nAllocations;
+
+	// ns/op of each sample, a single op or a frame divided by its ops
+	std::vector<double>	m_Samples;
+};
+
+//-----------------------------------------------------------------------------
+// Purpose: Allocations made by the manager so far
+//-----------------------------------------------------------------------------
+static uint64 GetAllocations()
+{
+	SteamCallbackMgrCounters_t Counters;
+
+	SteamAPI_GetCallbackMgrCounters(&Counters);
+
+	return Counters.m_nAllocations;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose:
+//-----------------------------------------------------------------------------
+static double GetPercentile(const std::vector<double> &Sorted, double flPercentile)
+{
+	size_t i;
+
+	if (Sorted.empty())
+		return 0.0;
+
+	i = std::min(Sorted.size() - 1, (size_t)(flPercentile * Sorted.size()));
+
+	return Sorted[i];
+}
+
+//-----------------------------------------------------------------------------
+// Purpose:
+//-----------------------------------------------------------------------------
+static void PrintResult(const char *pszName, BenchResult_t &Result)
+{
+	std::sort(Result.m_Samples.begin(), Result.m_Samples.end());
+
+	printf("%-32s %10llu %10.1f %10.4f %10.1f %10.1f %10.1f\n", pszName,
+		   (unsigned long long)Result.m_nOps,
+		   Result.m_flNanoseconds / Result.m_nOps,
+		   (double)Result.m_nAllocations / Result.m_nOps,
+		   GetPercentile(Result.m_Samples, 0.50),
+		   GetPercentile(Result.m_Samples, 0.99),
+		   GetPercentile(Result.m_Samples, 0.999));
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Complains if listeners didn't run as often as they were meant to,
+//			the numbers of that benchmark measure something else then
+//-----------------------------------------------------------------------------
+static void CheckRuns(const char *pszName, const std::vector<CBenchListener> &Listeners, uint64 nExpected)
+{
+	uint64 nRuns;
+
+	nRuns = 0;
+	for (size_t i = 0; i < Listeners.size(); i++)
+		nRuns += Listeners[i].m_nRuns;
+
+	if (nRuns != nExpected)
+		fprintf(stderr, "%s: listeners ran %llu times, expected %llu\n", pszName, (unsigned long long)nRuns, (unsigned long long)nExpected);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Runs one frame of the pipe and returns how long it took
+//-----------------------------------------------------------------------------
+static double RunFrame()
+{
+	BenchClock::time_point Start;
+
+	Start = BenchClock::now();
+	Steam_RunCallbacks(BENCH_PIPE, false);
+
+	return std::chrono::duration<double, std::nano>(BenchClock::now() - Start).count();
+}
+
+//-----------------------------------------------------------------------------
+//
+// Benchmarks
+//
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// Purpose: One op is a register and unregister of a listener, with resident
+//			listeners in the table. Queued changes are applied by a frame
+//			every batch, frames aren't counted.
+//-----------------------------------------------------------------------------
+static void BenchChurn(uint64 nOps)
+{
+	std::vector<CBenchListener>	Resident(BENCH_RESIDENT_LISTENERS);
+	std::vector<CBenchListener>	Churned(BENCH_CALLBACK_IDS);
+	BenchResult_t				Result;
+	BenchClock::time_point		Start;
+	uint64						nAllocations;
+	double						flElapsed;
+	int							iCallback;
+
+	for (size_t i = 0; i < Resident.size(); i++)
+		SteamAPI_RegisterCallback(&Resident[i], BENCH_CALLBACK_BASE + (int)(i % BENCH_CALLBACK_IDS));
+
+	RunFrame();
+
+	Result.m_nOps = 0;
+	Result.m_flNanoseconds = 0.0;
+	Result.m_nAllocations = 0;
+	Result.m_Samples.reserve(nOps);
+
+	while (Result.m_nOps < nOps)
+	{
+		nAllocations = GetAllocations();
+
+		for (int i = 0; i < BENCH_CHURN_BATCH && Result.m_nOps < nOps; i++, Result.m_nOps++)
+		{
+			iCallback = (int)(Result.m_nOps % BENCH_CALLBACK_IDS);
+
+			Start = BenchClock::now();
+			SteamAPI_RegisterCallback(&Churned[iCallback], BENCH_CALLBACK_BASE + iCallback);
+			SteamAPI_UnregisterCallback(&Churned[iCallback]);
+			flElapsed = std::chrono::duration<double, std::nano>(BenchClock::now() - Start).count();
+
+			Result.m_flNanoseconds += flElapsed;
+			Result.m_Samples.push_back(flElapsed);
+		}
+
+		Result.m_nAllocations += GetAllocations() - nAllocations;
+
+		RunFrame();
+	}
+
+	for (size_t i = 0; i < Resident.size(); i++)
+		SteamAPI_UnregisterCallback(&Resident[i]);
+
+	RunFrame();
+
+	PrintResult("churn/register+unregister", Result);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: One op is a message handed to its listener, cMessages per frame.
+//			A sample is a frame divided by its messages.
+//-----------------------------------------------------------------------------
+static void BenchDispatch(int cMessages)
+{
+	std::vector<CBenchListener>	Listeners(BENCH_CALLBACK_IDS);
+	BenchResult_t				Result;
+	char						szName[64];
+	uint64						nAllocations;
+	double						flElapsed;
+	int							cFrames;
+
+	for (int i = 0; i < BENCH_CALLBACK_IDS; i++)
+		SteamAPI_RegisterCallback(&Listeners[i], BENCH_CALLBACK_BASE + i);
+
+	// Warm up, applies the registrations too
+	s_nMessagesLeft = cMessages;
+	RunFrame();
+
+	cFrames = std::max(20, std::min(100000, BENCH_DISPATCH_MESSAGES / cMessages));
+
+	Result.m_nOps = 0;
+	Result.m_flNanoseconds = 0.0;
+	Result.m_Samples.reserve(cFrames);
+
+	nAllocations = GetAllocations();
+
+	for (int i = 0; i < cFrames; i++)
+	{
+		s_nMessagesLeft = cMessages;
+		flElapsed = RunFrame();
+
+		Result.m_nOps += cMessages;
+		Result.m_flNanoseconds += flElapsed;
+		Result.m_Samples.push_back(flElapsed / cMessages);
+	}
+
+	Result.m_nAllocations = GetAllocations() - nAllocations;
+
+	for (int i = 0; i < BENCH_CALLBACK_IDS; i++)
+		SteamAPI_UnregisterCallback(&Listeners[i]);
+
+	RunFrame();
+
+	snprintf(szName, sizeof(szName), "dispatch/%d-per-frame", cMessages);
+	CheckRuns(szName, Listeners, Result.m_nOps + cMessages);
+	PrintResult(szName, Result);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: One op is a call result completed and run while cOutstanding are
+//			registered. Completed calls are replaced by new ones between
+//			frames, which isn't counted, so the count stays the same.
+//-----------------------------------------------------------------------------
+static void BenchCompletion(int cOutstanding, std::mt19937 &Random)
+{
+	std::vector<CBenchListener>	CallResults(cOutstanding);
+	std::vector<SteamAPICall_t>	APICalls(cOutstanding);
+	std::vector<int>			Order(cOutstanding);
+	BenchResult_t				Result;
+	SteamAPICall_t				hNextAPICall;
+	char						szName[64];
+	uint64						nAllocations;
+	double						flElapsed;
+	size_t						iOrder;
+	int							cPerFrame;
+	int							iCallResult;
+
+	hNextAPICall = 1;
+
+	for (int i = 0; i < cOutstanding; i++)
+	{
+		CallResults[i].SetCallback(BENCH_CALLRESULT_ID);
+		APICalls[i] = hNextAPICall++;
+		Order[i] = i;
+
+		SteamAPI_RegisterCallResult(&CallResults[i], APICalls[i]);
+	}
+
+	std::shuffle(Order.begin(), Order.end(), Random);
+	iOrder = 0;
+
+	cPerFrame = std::min(cOutstanding, BENCH_COMPLETIONS_PER_FRAME);
+
+	Result.m_nOps = 0;
+	Result.m_flNanoseconds = 0.0;
+	Result.m_nAllocations = 0;
+	Result.m_Samples.reserve(BENCH_COMPLETION_FRAMES);
+
+	for (int iFrame = 0; iFrame < BENCH_COMPLETION_FRAMES; iFrame++)
+	{
+		s_CompletedCalls.clear();
+		s_iNextCompletedCall = 0;
+
+		for (int i = 0; i < cPerFrame; i++)
+		{
+			if (iOrder == Order.size())
+			{
+				std::shuffle(Order.begin(), Order.end(), Random);
+				iOrder = 0;
+			}
+
+			s_CompletedCalls.push_back(APICalls[Order[iOrder++]]);
+		}
+
+		nAllocations = GetAllocations();
+		flElapsed = RunFrame();
+		Result.m_nAllocations += GetAllocations() - nAllocations;
+
+		Result.m_nOps += cPerFrame;
+		Result.m_flNanoseconds += flElapsed;
+		Result.m_Samples.push_back(flElapsed / cPerFrame);
+
+		// Replace what was completed
+		for (int i = 0; i < cPerFrame; i++)
+		{
+			iCallResult = Order[iOrder - cPerFrame + i];
+			APICalls[iCallResult] = hNextAPICall++;
+
+			SteamAPI_RegisterCallResult(&CallResults[iCallResult], APICalls[iCallResult]);
+		}
+	}
+
+	s_CompletedCalls.clear();
+	s_iNextCompletedCall = 0;
+
+	for (int i = 0; i < cOutstanding; i++)
+		SteamAPI_UnregisterCallResult(&CallResults[i], APICalls[i]);
+
+	snprintf(szName, sizeof(szName), "completion/%d-outstanding", cOutstanding);
+	CheckRuns(szName, CallResults, Result.m_nOps);
+	PrintResult(szName, Result);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose:
+//-----------------------------------------------------------------------------
+int main(int argc, char **argv)
+{
+	static const int	s_rgcMessagesPerFrame[] = { 1, 10, 100, 1000, 10000, 100000 };
+	static const int	s_rgcOutstanding[] = { 1000, 10000, 100000, 1000000 };
+	const char*			pszFilter;
+	std::mt19937		Random(1);
+
+	pszFilter = (argc > 1) ? argv[1] : "";
+
+	SteamAPI_SetCallbackSource(&s_BenchCallbackSource);
+
+	printf("%-32s %10s %10s %10s %10s %10s %10s\n", "benchmark", "ops", "ns/op", "allocs/op", "p50", "p99", "p999");
+
+	if (strstr("churn", pszFilter))
+		BenchChurn(200000);
+
+	if (strstr("dispatch", pszFilter))
+	{
+		for (int cMessages : s_rgcMessagesPerFrame)
+			BenchDispatch(cMessages);
+	}
+
+	if (strstr("completion", pszFilter))
+	{
+		for (int cOutstanding : s_rgcOutstanding)
+			BenchCompletion(cOutstanding, Random);
+	}
+
+	SteamAPI_SetCallbackSource(nullptr);
+
+	return 0;
+}
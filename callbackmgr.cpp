@@ -7,420 +7,3768 @@
 
 #include "steam_api_pch.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 // Set inside CCallbackMgr constructor and destructor. True if the class has been
 // instantiated and the constructor was called. False if the class object has been
 // destroyed and the destructor was called.
 static bool s_bCallbackManagerInitialized = false;
 
-// Mutex lock for callback dispatch
-static bool s_bRunningCallbacks = false;
+// Heap allocations made by the callback manager and its containers, reported by
+// SteamAPI_GetCallbackMgrCounters().
+static std::atomic<uint64> s_nCallbackAllocations(0);
+static std::atomic<uint64> s_cubCallbackAllocated(0);
+
+//-----------------------------------------------------------------------------
+// Purpose: Accounts one heap allocation
+//-----------------------------------------------------------------------------
+static inline void CountCallbackAllocation(size_t cubSize)
+{
+	s_nCallbackAllocations.fetch_add(1, std::memory_order_relaxed);
+	s_cubCallbackAllocated.fetch_add(cubSize, std::memory_order_relaxed);
+}
 
 //-----------------------------------------------------------------------------
 // 
-// Callback manager class
+// Callback dispatch table
 // 
 //-----------------------------------------------------------------------------
 
+// Steam callback identifiers are composed of the interface base (k_i*Callbacks,
+// a multiple of 100) plus an offset of the callback within that interface.
+#define CALLBACK_ID_INTERFACE_STRIDE	100
+#define CALLBACK_ID_MAX_INTERFACES		128
+
 //-----------------------------------------------------------------------------
-// Purpose: Steam callbacks
+// Purpose: Entry of the dispatch table. Everything dispatch needs is kept in
+//			place, so the loop never has to ask the listener. CCallbackBase 
+//			listeners are run through RunCallbackBase(), listeners registered 
+//			with SteamAPI_RegisterStaticCallback() through their own thunk.
 //-----------------------------------------------------------------------------
-typedef bool (*pfnSteam_BGetCallback_t)(HSteamPipe hSteamPipe, CallbackMsg_t *pCallbackMsg);
-typedef void (*pfnSteam_FreeLastCallback_t)(HSteamPipe hSteamPipe);
-typedef bool (*pfnSteam_GetAPICallResult_t)(HSteamPipe hSteamPipe, SteamAPICall_t hSteamAPICall, void* pCallback, int cubCallback, int iCallbackExpected, bool* pbFailed);
-typedef bool (*pfnSteam_CallbackDispatchMsg_t)(CallbackMsg_t* pCallbackMessage, bool bGameServerCallbacks);
+struct CallbackListener_t
+{
+	void*					m_pContext;
+	SteamCallbackThunk_t	m_pfnThunk;
+
+	// Payload smaller than this is not delivered, 0 for CCallbackBase listeners
+	int						m_cubParam;
+	bool					m_bGameServer;
+
+	// Only messages of this pipe are delivered, 0 for messages of any pipe
+	HSteamPipe				m_hSteamPipe;
+
+	bool IsSame(const CallbackListener_t &Other) const
+	{
+		return m_pContext == Other.m_pContext && m_pfnThunk == Other.m_pfnThunk;
+	}
+};
 
 //-----------------------------------------------------------------------------
-// Purpose: Callback management class
+// Purpose: Thunk of CCallbackBase listeners
 //-----------------------------------------------------------------------------
-class CCallbackMgr
+static void RunCallbackBase(void *pContext, void *pvParam)
 {
-private:
-	template<bool bGameServer>
-	using SteamAPICallback = CCallback<CCallbackMgr, SteamAPICallCompleted_t, bGameServer>;
+	static_cast<CCallbackBase*>(pContext)->Run(pvParam);
+}
 
-	template<class T>
-	using CallbackMultimap = std::multimap<T, CCallbackBase*>;
+//-----------------------------------------------------------------------------
+// Purpose: Dispatch table entry of a CCallbackBase listener
+//-----------------------------------------------------------------------------
+static CallbackListener_t MakeCallbackBaseListener(CCallbackBase *pCallback, bool bGameServer)
+{
+	CallbackListener_t Listener;
 
-public:
-	CCallbackMgr();
-	~CCallbackMgr();
+	Listener.m_pContext = pCallback;
+	Listener.m_pfnThunk = &RunCallbackBase;
+	Listener.m_cubParam = 0;
+	Listener.m_bGameServer = bGameServer;
+	Listener.m_hSteamPipe = 0;
 
+	return Listener;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Two-level table of listeners indexed by the callback identifier. 
+//			First level is the interface (m_iCallback / 100), second level is
+//			the offset inside of that interface. Interface blocks are allocated
+//			on the first registration and never move.
+// Note:	Lists of listeners are copy-on-write. Dispatchers read them without
+//			any lock, a change builds a new list and swaps the pointer in. The
+//			replaced lists are kept until Reclaim() is told that no dispatcher
+//			can be looking at them anymore. Changes must be serialized.
+//-----------------------------------------------------------------------------
+class CCallbackDispatchTable
+{
 public:
-	void Register(CCallbackBase *pCallback, int iCallback);
-	void Unregister(CCallbackBase *pCallback);
+	using ListenerVector = std::vector<CallbackListener_t>;
+	using ListenerSlot = std::atomic<const ListenerVector*>;
 
-	void RegisterCallResult(CCallbackBase *pCallback, SteamAPICall_t hAPICall);
-	void UnregisterCallResult(CCallbackBase *pCallback, SteamAPICall_t hAPICall);
+	// Identifiers outside of the dense range, sorted by the identifier
+	using OverflowVector = std::vector<std::pair<int, ListenerSlot*>>;
 
-	void RegisterInterfaceFuncs(HMODULE hModule);
+public:
+	CCallbackDispatchTable();
+	~CCallbackDispatchTable();
 
-	void OnSteamAPICallCompleted(SteamAPICallCompleted_t *pCompletedSteamAPICall);
+public:
+	// Writer side
+	void Insert(int iCallback, const CallbackListener_t &Listener);
+	void Remove(int iCallback, const CallbackListener_t &Listener);
+	void Retire(uint64 nEpoch);
+	void Reclaim(uint64 nOldestEpoch);
+	void Clear();
 
-	// Callback dispatch
-	void RunCallbacks(HSteamPipe hSteamPipe, bool bGameServerCallbacks);
-	void DispatchCallback(CallbackMsg_t *pCallbackMsg, bool bGameServerCallbacks);
-	void DispatchCallbackTryCatch(CallbackMsg_t *pCallbackMsg, bool bGameServerCallbacks);
-	void DispatchCallbackNoTryCatch(CallbackMsg_t *pCallbackMsg, bool bGameServerCallbacks);
+	// Dispatcher side
+	const ListenerVector* Find(int iCallback) const;
 
-public:
-	// Call maps
-	CallbackMultimap<int>				m_CallbackMap;
-	CallbackMultimap<SteamAPICall_t>	m_APICallMap;
+private:
+	ListenerSlot* FindSlot(int iCallback) const;
+	ListenerSlot* FindOrCreateSlot(int iCallback);
+	void Publish(ListenerSlot *pSlot, ListenerVector *pListeners);
 
-	// Callback steamclient API
-	pfnSteam_BGetCallback_t 			pfnSteam_BGetCallback;
-	pfnSteam_FreeLastCallback_t 		pfnSteam_FreeLastCallback;
-	pfnSteam_GetAPICallResult_t 		pfnSteam_GetAPICallResult;
+private:
+	struct RetiredLists_t
+	{
+		uint64					m_nEpoch;
+		const ListenerVector*	m_pListeners;
+		const OverflowVector*	m_pOverflow;
+	};
 
-	// Communication
-	HSteamUser 							m_hSteamUser;
-	HSteamPipe 							m_hSteamPipe;
+private:
+	// One block of CALLBACK_ID_INTERFACE_STRIDE listener slots per interface
+	std::atomic<ListenerSlot*>			m_pInterfaceBlocks[CALLBACK_ID_MAX_INTERFACES];
 
-	// Callbacks
-	pfnSteam_CallbackDispatchMsg_t 		pfnSteam_CallbackDispatchMsg;
-	SteamAPICallback<false>				m_SteamCallback;
-	SteamAPICallback<true>				m_SteamGameServerCallback;
+	// Slots of identifiers that don't fit into the dense range
+	std::atomic<const OverflowVector*>	m_pOverflow;
+
+	// Replaced lists, those not tagged by Retire() yet have epoch 0
+	std::vector<RetiredLists_t>			m_RetiredLists;
 };
 
 //-----------------------------------------------------------------------------
 // Purpose: Constructor
 //-----------------------------------------------------------------------------
-CCallbackMgr::CCallbackMgr() :
-	// Callbacks for game server and steam client
-	m_SteamCallback(nullptr, nullptr),
-	m_SteamGameServerCallback(nullptr, nullptr), 
-
-	// Exported callback entries from steamclient module
-	pfnSteam_BGetCallback(nullptr), 
-	pfnSteam_FreeLastCallback(nullptr),
-	pfnSteam_GetAPICallResult(nullptr),
-	pfnSteam_CallbackDispatchMsg(nullptr),
-
-	// Communication to the steam client
-	m_hSteamPipe(NULL),
-	m_hSteamUser(NULL)
+CCallbackDispatchTable::CCallbackDispatchTable() :
+	m_pOverflow(nullptr)
 {
-	// API call maps
-	m_CallbackMap.clear();
-	m_APICallMap.clear();
-
-	s_bCallbackManagerInitialized = true;
+	for (int i = 0; i < CALLBACK_ID_MAX_INTERFACES; i++)
+		m_pInterfaceBlocks[i] = nullptr;
 }
 
 //-----------------------------------------------------------------------------
 // Purpose: Destructor
 //-----------------------------------------------------------------------------
-CCallbackMgr::~CCallbackMgr()
+CCallbackDispatchTable::~CCallbackDispatchTable()
 {
-	s_bCallbackManagerInitialized = false;
+	Clear();
 }
 
 //-----------------------------------------------------------------------------
-// Purpose: Adds new callback entry to the map
+// Purpose: Appends listener at the end of the list, so listeners are dispatched
+//			in the same order as they were registered.
 //-----------------------------------------------------------------------------
-void CCallbackMgr::Register(CCallbackBase* pCallback, int iCallback)
+void CCallbackDispatchTable::Insert(int iCallback, const CallbackListener_t &Listener)
 {
-	// Tell that we are registered
-	pCallback->m_nCallbackFlags |= pCallback->k_ECallbackFlagsRegistered;
-	pCallback->m_iCallback = iCallback;
+	ListenerSlot*			pSlot;
+	const ListenerVector*	pOld;
+	ListenerVector*			pNew;
 
-	m_CallbackMap.insert(std::make_pair(iCallback, pCallback));
+	pSlot = FindOrCreateSlot(iCallback);
+	pOld = pSlot->load(std::memory_order_relaxed);
+
+	CountCallbackAllocation(sizeof(ListenerVector) + ((pOld ? pOld->size() : 0) + 1) * sizeof(CallbackListener_t));
+	pNew = pOld ? new ListenerVector(*pOld) : new ListenerVector();
+	pNew->push_back(Listener);
+
+	Publish(pSlot, pNew);
 }
 
 //-----------------------------------------------------------------------------
-// Purpose: Looks for a specific callback inside the map, and if there's a match, 
-//			matched callback entry will be erased from the map.
+// Purpose: Removes listener from the list, order of the rest is kept.
 //-----------------------------------------------------------------------------
-void CCallbackMgr::Unregister(CCallbackBase *pCallback)
+void CCallbackDispatchTable::Remove(int iCallback, const CallbackListener_t &Listener)
 {
-	// If already unregistered there's no need to do it again
-	if (!(pCallback->m_nCallbackFlags & CCallbackBase::k_ECallbackFlagsRegistered))
+	ListenerSlot*			pSlot;
+	const ListenerVector*	pOld;
+	ListenerVector*			pNew;
+
+	pSlot = FindSlot(iCallback);
+	if (!pSlot)
 		return;
 
-	// Mark as unregistered so we don't then process unregisterd callback
-	pCallback->m_nCallbackFlags &= ~CCallbackBase::k_ECallbackFlagsRegistered;
+	pOld = pSlot->load(std::memory_order_relaxed);
+	if (!pOld)
+		return;
 
-	// Find matched callback and unregister it from the list
-	auto Iter = m_CallbackMap.find(pCallback->GetICallback());
-	if (Iter != m_CallbackMap.end())
+	auto Iter = std::find_if(pOld->begin(), pOld->end(), [&Listener](const CallbackListener_t &Entry)
 	{
-		if (Iter->second == pCallback)
-		{
-			m_CallbackMap.erase(Iter);
-		}
-	}
-}
+		return Entry.IsSame(Listener);
+	});
+	if (Iter == pOld->end())
+		return;
 
-//-----------------------------------------------------------------------------
-// Purpose: Adds new call result to the map
-//-----------------------------------------------------------------------------
-void CCallbackMgr::RegisterCallResult(CCallbackBase* pCallback, SteamAPICall_t hAPICall)
-{
-	m_APICallMap.insert(std::make_pair(hAPICall, pCallback));
+	CountCallbackAllocation(sizeof(ListenerVector) + (pOld->size() - 1) * sizeof(CallbackListener_t));
+	pNew = new ListenerVector();
+	pNew->reserve(pOld->size() - 1);
+	pNew->insert(pNew->end(), pOld->begin(), Iter);
+	pNew->insert(pNew->end(), Iter + 1, pOld->end());
+
+	Publish(pSlot, pNew);
 }
 
 //-----------------------------------------------------------------------------
-// Purpose: Looks for a specific APICall handle entry and erases it from the map.
+// Purpose: Swaps the new list in, the replaced one is retired.
 //-----------------------------------------------------------------------------
-void CCallbackMgr::UnregisterCallResult(CCallbackBase *pCallback, SteamAPICall_t hAPICall)
+void CCallbackDispatchTable::Publish(ListenerSlot *pSlot, ListenerVector *pListeners)
 {
-	// If already unregistered there's no need to do it again
-	if (!(pCallback->m_nCallbackFlags & CCallbackBase::k_ECallbackFlagsRegistered))
-		return;
-
-	// Mark as unregistered so we don't then process unregisterd api call
-	pCallback->m_nCallbackFlags &= ~CCallbackBase::k_ECallbackFlagsRegistered;
-
-	// Find matched api call and unregister it from the list
-	auto Iter = m_APICallMap.find(pCallback->GetICallback());
-	if (Iter != m_APICallMap.end())
-	{
-		if (Iter->second == pCallback)
-		{
-			m_APICallMap.erase(Iter);
-		}
-	}
+	const ListenerVector* pOld;
 
+	pOld = pSlot->exchange(pListeners);
+	if (pOld)
+		m_RetiredLists.push_back({ 0, pOld, nullptr });
 }
 
 //-----------------------------------------------------------------------------
-// Purpose: Register internal steamclient callback API and each callback object.
+// Purpose: Tags lists replaced since the last call with the registry epoch 
+//			that was current while they were still published.
 //-----------------------------------------------------------------------------
-void CCallbackMgr::RegisterInterfaceFuncs(HMODULE hModule)
+void CCallbackDispatchTable::Retire(uint64 nEpoch)
 {
-	pfnSteam_BGetCallback = reinterpret_cast<pfnSteam_BGetCallback_t>(GetProcAddress(hModule, "Steam_BGetCallback"));
-	pfnSteam_FreeLastCallback = reinterpret_cast<pfnSteam_FreeLastCallback_t>(GetProcAddress(hModule, "Steam_FreeLastCallback"));
-	pfnSteam_GetAPICallResult = reinterpret_cast<pfnSteam_GetAPICallResult_t>(GetProcAddress(hModule, "Steam_GetAPICallResult"));
-
-	// Manually register callbacks for both clients
-	m_SteamCallback.Register(this, &CCallbackMgr::OnSteamAPICallCompleted);
-	m_SteamGameServerCallback.Register(this, &CCallbackMgr::OnSteamAPICallCompleted);
+	for (size_t i = m_RetiredLists.size(); i-- > 0 && !m_RetiredLists[i].m_nEpoch; )
+		m_RetiredLists[i].m_nEpoch = nEpoch;
 }
 
 //-----------------------------------------------------------------------------
-// Purpose: Routine that is called on APICall completion. It's responsible for
-//			executing the callback and then for unregistering it.
+// Purpose: Frees retired lists of epochs before nOldestEpoch, no dispatcher 
+//			can have them anymore.
 //-----------------------------------------------------------------------------
-void CCallbackMgr::OnSteamAPICallCompleted(SteamAPICallCompleted_t *pCompletedSteamAPICall)
+void CCallbackDispatchTable::Reclaim(uint64 nOldestEpoch)
 {
-	void*			pCallbackData;
-	bool			bIOFailed;
-	CCallbackBase*	pCallbackBase;
-	int				iCallbackSize;
-	SteamAPICall_t	hAPICall;
+	size_t nKept;
 
-	hAPICall = pCompletedSteamAPICall->m_hAsyncCall;
-	
-	auto APICall = m_APICallMap.find(hAPICall);
-	if (APICall == m_APICallMap.end())
-		return;
+	nKept = 0;
 
-	pCallbackBase = APICall->second;
-	iCallbackSize = pCallbackBase->GetCallbackSizeBytes();
-	bIOFailed = false;
+	for (size_t i = 0; i < m_RetiredLists.size(); i++)
+	{
+		const RetiredLists_t& Retired = m_RetiredLists[i];
 
-	pCallbackData = malloc(iCallbackSize);
+		if (!Retired.m_nEpoch || Retired.m_nEpoch >= nOldestEpoch)
+		{
+			m_RetiredLists[nKept++] = Retired;
+			continue;
+		}
 
-	// Try to dispatch the callback
-	if (pfnSteam_GetAPICallResult(m_hSteamPipe, hAPICall, pCallbackData, iCallbackSize, pCallbackBase->GetICallback(), &bIOFailed))
-	{
-		pCallbackBase->Run(pCallbackData, bIOFailed, hAPICall);
+		delete Retired.m_pListeners;
+		delete Retired.m_pOverflow;
 	}
 
-	free(pCallbackData);
-
-	// We don't need it no more
-	UnregisterCallResult(pCallbackBase, hAPICall);
+	m_RetiredLists.resize(nKept);
 }
 
 //-----------------------------------------------------------------------------
-// Purpose: Dispatches all sheduled callbacks depending on the communcation 
-//			pipe. Whenether callbacks are dispatched is controlled by internal
-//			steamclient API - pfnSteam_BGetCallback() function. After the callback
-//			is dispatched, it's freed by calling pfnSteam_FreeLastCallback().
+// Purpose: Frees all interface blocks, overflow entries and retired lists. 
+//			Nobody may be dispatching.
 //-----------------------------------------------------------------------------
-void CCallbackMgr::RunCallbacks(HSteamPipe hSteamPipe, bool bGameServerCallbacks)
+void CCallbackDispatchTable::Clear()
 {
-	CallbackMsg_t CallbackMsg;
+	ListenerSlot*			pBlock;
+	const OverflowVector*	pOverflow;
 
-	if (!pfnSteam_BGetCallback || !pfnSteam_FreeLastCallback)
-		return;
+	for (int i = 0; i < CALLBACK_ID_MAX_INTERFACES; i++)
+	{
+		pBlock = m_pInterfaceBlocks[i].exchange(nullptr);
+		if (!pBlock)
+			continue;
 
-	// Cannot dispatch when already running
-	if (s_bRunningCallbacks != false)
-		return;
+		for (int j = 0; j < CALLBACK_ID_INTERFACE_STRIDE; j++)
+			delete pBlock[j].load();
 
-	s_bRunningCallbacks = true;
-	m_hSteamPipe = hSteamPipe;
+		delete[] pBlock;
+	}
 
-	// Execute callbacks till there's no more left
-	while (pfnSteam_BGetCallback(hSteamPipe, &CallbackMsg))
+	pOverflow = m_pOverflow.exchange(nullptr);
+	if (pOverflow)
 	{
-		m_hSteamUser = CallbackMsg.m_hSteamUser;
-
-		// Call exception or non-exception cared callback dispatcher
-		DispatchCallback(&CallbackMsg, bGameServerCallbacks);
+		for (const auto& Entry : *pOverflow)
+		{
+			delete Entry.second->load();
+			delete Entry.second;
+		}
 
-		if (pfnSteam_FreeLastCallback)
-			pfnSteam_FreeLastCallback(hSteamPipe);
+		delete pOverflow;
 	}
 
-	m_hSteamPipe = NULL;
-	s_bRunningCallbacks = false;
+	Reclaim(UINT64_MAX);
 }
 
 //-----------------------------------------------------------------------------
-// Purpose: Executes exception-care or nonexception-care dispatch routine.
+// Purpose: Returns list of listeners for the callback identifier, or nullptr
+//			if there's none. Stays valid while the caller holds the registry 
+//			epoch it had when calling this.
 //-----------------------------------------------------------------------------
-void CCallbackMgr::DispatchCallback(CallbackMsg_t *pCallbackMsg, bool bGameServerCallbacks)
+const CCallbackDispatchTable::ListenerVector* CCallbackDispatchTable::Find(int iCallback) const
 {
-	if (g_bCatchExceptionsInCallbacks != false)
-	{
-		DispatchCallbackTryCatch(pCallbackMsg, bGameServerCallbacks);
-	}
-	else
-	{
-		DispatchCallbackNoTryCatch(pCallbackMsg, bGameServerCallbacks);
-	}
+	ListenerSlot* pSlot;
+
+	pSlot = FindSlot(iCallback);
+	if (!pSlot)
+		return nullptr;
+
+	return pSlot->load();
 }
 
 //-----------------------------------------------------------------------------
-// Purpose: Dispatches all sheduled callbacks with try & catch exception handling.
+// Purpose: Returns slot of the callback identifier, or nullptr if nothing has
+//			ever been registered for it.
 //-----------------------------------------------------------------------------
-void CCallbackMgr::DispatchCallbackTryCatch(CallbackMsg_t *pCallbackMsg, bool bGameServerCallbacks)
+CCallbackDispatchTable::ListenerSlot* CCallbackDispatchTable::FindSlot(int iCallback) const
 {
-	CCallbackBase*	pCallback;
-	bool			bGameServer;
+	ListenerSlot*			pBlock;
+	const OverflowVector*	pOverflow;
+	int						iInterface;
 
-	try
+	iInterface = iCallback / CALLBACK_ID_INTERFACE_STRIDE;
+
+	if (iCallback >= 0 && iInterface < CALLBACK_ID_MAX_INTERFACES)
 	{
-		bGameServer = false;
+		pBlock = m_pInterfaceBlocks[iInterface].load();
+		if (!pBlock)
+			return nullptr;
 
-		// Look for callbacks with identical indexes and try to dispatch them
-		auto Iter = m_CallbackMap.find(pCallbackMsg->m_iCallback);
-		if (Iter != m_CallbackMap.end())
-		{
-			pCallback = Iter->second;
+		return &pBlock[iCallback % CALLBACK_ID_INTERFACE_STRIDE];
+	}
 
-			if (bGameServerCallbacks == ((pCallback->m_nCallbackFlags & CCallbackBase::k_ECallbackFlagsGameServer) >> 1))
-			{
-				bGameServer = true;
-				pCallback->Run(pCallbackMsg->m_pubParam);
-			}
-		}
+	pOverflow = m_pOverflow.load();
+	if (!pOverflow)
+		return nullptr;
 
-		if (pfnSteam_CallbackDispatchMsg)
-			pfnSteam_CallbackDispatchMsg(pCallbackMsg, bGameServer != false);
-	}
-	catch (...)
+	auto Iter = std::lower_bound(pOverflow->begin(), pOverflow->end(), iCallback, [](const OverflowVector::value_type &Entry, int iKey)
 	{
-#ifdef REGS_FIXES
-		__debugbreak();
-#endif
-	}
+		return Entry.first < iKey;
+	});
+	if (Iter == pOverflow->end() || Iter->first != iCallback)
+		return nullptr;
+
+	return Iter->second;
 }
 
 //-----------------------------------------------------------------------------
-// Purpose: Dispatches all sheduled callbacks without try & catch exception 
-//			handling. 
+// Purpose: Same as FindSlot(), but allocates the slot if needed. Slots are 
+//			never freed before Clear().
 //-----------------------------------------------------------------------------
-void CCallbackMgr::DispatchCallbackNoTryCatch(CallbackMsg_t *pCallbackMsg, bool bGameServerCallbacks)
+CCallbackDispatchTable::ListenerSlot* CCallbackDispatchTable::FindOrCreateSlot(int iCallback)
 {
-	CCallbackBase*	pCallback;
-	bool			bGameServer;
-	
-	bGameServer = false;
+	ListenerSlot*			pSlot;
+	ListenerSlot*			pBlock;
+	const OverflowVector*	pOverflow;
+	OverflowVector*			pNewOverflow;
+	int						iInterface;
 
-	// Look for callbacks with identical indexes and try to dispatch them
-	auto Iter = m_CallbackMap.find(pCallbackMsg->m_iCallback);
-	if (Iter != m_CallbackMap.end())
+	pSlot = FindSlot(iCallback);
+	if (pSlot)
+		return pSlot;
+
+	iInterface = iCallback / CALLBACK_ID_INTERFACE_STRIDE;
+
+	if (iCallback >= 0 && iInterface < CALLBACK_ID_MAX_INTERFACES)
 	{
-		pCallback = Iter->second;
+		CountCallbackAllocation(sizeof(ListenerSlot) * CALLBACK_ID_INTERFACE_STRIDE);
+		pBlock = new ListenerSlot[CALLBACK_ID_INTERFACE_STRIDE];
 
-		if (bGameServerCallbacks == (((pCallback->m_nCallbackFlags & CCallbackBase::k_ECallbackFlagsGameServer) >> 1) == 1))
-		{
-			bGameServer = true;
-			pCallback->Run(pCallbackMsg->m_pubParam);
-		}
+		for (int i = 0; i < CALLBACK_ID_INTERFACE_STRIDE; i++)
+			pBlock[i].store(nullptr, std::memory_order_relaxed);
+
+		m_pInterfaceBlocks[iInterface].store(pBlock);
+
+		return &pBlock[iCallback % CALLBACK_ID_INTERFACE_STRIDE];
 	}
 
-	if (pfnSteam_CallbackDispatchMsg)
-		pfnSteam_CallbackDispatchMsg(pCallbackMsg, bGameServer != false);
+	// The sorted index is copy-on-write as well
+	CountCallbackAllocation(sizeof(ListenerSlot) + sizeof(OverflowVector));
+	pSlot = new ListenerSlot(nullptr);
+
+	pOverflow = m_pOverflow.load(std::memory_order_relaxed);
+	pNewOverflow = pOverflow ? new OverflowVector(*pOverflow) : new OverflowVector();
+
+	auto Iter = std::lower_bound(pNewOverflow->begin(), pNewOverflow->end(), iCallback, [](const OverflowVector::value_type &Entry, int iKey)
+	{
+		return Entry.first < iKey;
+	});
+	pNewOverflow->insert(Iter, { iCallback, pSlot });
+
+	m_pOverflow.store(pNewOverflow);
+	if (pOverflow)
+		m_RetiredLists.push_back({ 0, nullptr, pOverflow });
+
+	return pSlot;
 }
 
 //-----------------------------------------------------------------------------
 // 
-// Callback manager C interface
+// Outstanding API call index
 // 
 //-----------------------------------------------------------------------------
 
+// Capacity of the index is always a power of two, never below this value
+#define APICALL_INDEX_MIN_CAPACITY		64
+
 //-----------------------------------------------------------------------------
-// Purpose: Singleton access
+// Purpose: Open-addressing hash index of outstanding SteamAPICall_t handles
+//			using Robin Hood probing. Entries live in one flat array, so 
+//			registering a call result doesn't allocate unless the index has to
+//			grow. Removal shifts the following run of entries backwards instead
+//			of leaving tombstones behind, and the array shrinks back once a
+//			burst of call results has been completed.
 //-----------------------------------------------------------------------------
-CCallbackMgr *GCallbackMgr()
+class CAPICallIndex
 {
-	static CCallbackMgr CallbackManager;
-	return &CallbackManager;
-}
+public:
+	struct Entry_t
+	{
+		SteamAPICall_t	m_hAPICall;
+		CCallbackBase*	m_pCallback;
+
+		// Taken at registration, the listener may be gone once the call completes
+		int				m_iCallback;
+		int				m_cubCallback;
+
+		// Set instead of the listener for handles added to a call result group
+		uint32			m_hGroup;
+		int				m_iGroupIndex;
+
+		// Distance from the home slot plus one, zero if the slot is empty
+		uint32			m_nProbeLength;
+	};
+
+public:
+	CAPICallIndex();
+	~CAPICallIndex();
+
+public:
+	void Insert(SteamAPICall_t hAPICall, CCallbackBase *pCallback, int iCallback, int cubCallback);
+	void InsertGroup(SteamAPICall_t hAPICall, uint32 hGroup, int iGroupIndex);
+	bool Remove(SteamAPICall_t hAPICall, CCallbackBase *pCallback);
+	uint32 RemoveIf(bool (*pfnRemove)(const Entry_t &Entry, void *pContext), void *pContext);
+	void Clear();
+
+	CCallbackBase* Find(SteamAPICall_t hAPICall) const;
+	const Entry_t* FindEntry(SteamAPICall_t hAPICall) const;
+
+	uint32 Count() const { return m_nCount; }
+
+private:
+	void Add(const Entry_t &Entry);
+	void Resize(uint32 nCapacity);
+	void InsertNoGrow(Entry_t Entry);
+	int FindSlot(SteamAPICall_t hAPICall, CCallbackBase *pCallback) const;
+
+	static uint32 HashAPICall(SteamAPICall_t hAPICall);
+
+private:
+	Entry_t*	m_pEntries;
+	uint32		m_nCapacity;
+	uint32		m_nCount;
+};
 
 //-----------------------------------------------------------------------------
-// Purpose: Adds new callback to the already existing map.
+// Purpose: Constructor
 //-----------------------------------------------------------------------------
-void CallbackMgr_RegisterCallback(CCallbackBase *pCallback, int iCallback)
+CAPICallIndex::CAPICallIndex() :
+	m_pEntries(nullptr),
+	m_nCapacity(0),
+	m_nCount(0)
 {
-	GCallbackMgr()->Register(pCallback, iCallback);
 }
 
 //-----------------------------------------------------------------------------
-// Purpose: Finds already existing callback inside the map and erases it.
+// Purpose: Destructor
 //-----------------------------------------------------------------------------
-void CallbackMgr_UnregisterCallback(CCallbackBase *pCallback)
+CAPICallIndex::~CAPICallIndex()
 {
-	if (s_bCallbackManagerInitialized != true)
-		return;
-
-	GCallbackMgr()->Unregister(pCallback);
+	delete[] m_pEntries;
 }
 
 //-----------------------------------------------------------------------------
-// Purpose: Adds new call result to the already existing map.
+// Purpose: Adds new handle to the index. The same handle can be present more
+//			than once, each time with a different listener.
 //-----------------------------------------------------------------------------
-void CallbackMgr_RegisterCallResult(CCallbackBase *pCallback, SteamAPICall_t hAPICall)
+void CAPICallIndex::Insert(SteamAPICall_t hAPICall, CCallbackBase *pCallback, int iCallback, int cubCallback)
 {
-	GCallbackMgr()->RegisterCallResult(pCallback, hAPICall);
+	Entry_t Entry;
+
+	Entry.m_hAPICall = hAPICall;
+	Entry.m_pCallback = pCallback;
+	Entry.m_iCallback = iCallback;
+	Entry.m_cubCallback = cubCallback;
+	Entry.m_hGroup = 0;
+	Entry.m_iGroupIndex = -1;
+
+	Add(Entry);
 }
 
 //-----------------------------------------------------------------------------
-// Purpose: Unregisters API call result from the map.
+// Purpose: Adds handle owned by a call result group to the index.
 //-----------------------------------------------------------------------------
-void CallbackMgr_UnregisterCallResult(CCallbackBase *pCallback, SteamAPICall_t hAPICall)
+void CAPICallIndex::InsertGroup(SteamAPICall_t hAPICall, uint32 hGroup, int iGroupIndex)
 {
-	if (s_bCallbackManagerInitialized != true)
-		return;
+	Entry_t Entry;
 
-	GCallbackMgr()->UnregisterCallResult(pCallback, hAPICall);
+	Entry.m_hAPICall = hAPICall;
+	Entry.m_pCallback = nullptr;
+	Entry.m_iCallback = 0;
+	Entry.m_cubCallback = 0;
+	Entry.m_hGroup = hGroup;
+	Entry.m_iGroupIndex = iGroupIndex;
+
+	Add(Entry);
 }
 
 //-----------------------------------------------------------------------------
-// Purpose: Dispatches a set of callbacks on specific pipe.
+// Purpose: Grows the index if needed and inserts the entry.
 //-----------------------------------------------------------------------------
-void CallbackMgr_RunCallbacks(HSteamPipe SteamPipe, bool bGameServerCallbacks)
+void CAPICallIndex::Add(const Entry_t &Entry)
 {
-	GCallbackMgr()->RunCallbacks(SteamPipe, bGameServerCallbacks);
+	// Keep the load factor under 7/8
+	if (!m_nCapacity)
+		Resize(APICALL_INDEX_MIN_CAPACITY);
+	else if ((m_nCount + 1) * 8 > m_nCapacity * 7)
+		Resize(m_nCapacity * 2);
+
+	Entry_t NewEntry = Entry;
+	NewEntry.m_nProbeLength = 1;
+
+	InsertNoGrow(NewEntry);
+	m_nCount++;
 }
 
 //-----------------------------------------------------------------------------
-// Purpose: Registers interface routines located inside specified module.
+// Purpose: Removes handle owned by the listener from the index. If pCallback 
+//			is nullptr, first entry with matching handle is removed. Returns 
+//			false if there was nothing to remove.
 //-----------------------------------------------------------------------------
-void CallbackMgr_RegisterInterfaceFuncs(HMODULE hModule)
+bool CAPICallIndex::Remove(SteamAPICall_t hAPICall, CCallbackBase *pCallback)
 {
-	GCallbackMgr()->RegisterInterfaceFuncs(hModule);
+	uint32	nMask, nSlot, nNext;
+	int		iSlot;
+
+	iSlot = FindSlot(hAPICall, pCallback);
+	if (iSlot < 0)
+		return false;
+
+	nMask = m_nCapacity - 1;
+	nSlot = (uint32)iSlot;
+	nNext = (nSlot + 1) & nMask;
+
+	// Shift the rest of the cluster one slot back, entries that are already in
+	// their home slot terminate it.
+	while (m_pEntries[nNext].m_nProbeLength > 1)
+	{
+		m_pEntries[nSlot] = m_pEntries[nNext];
+		m_pEntries[nSlot].m_nProbeLength--;
+
+		nSlot = nNext;
+		nNext = (nNext + 1) & nMask;
+	}
+
+	m_pEntries[nSlot].m_hAPICall = k_uAPICallInvalid;
+	m_pEntries[nSlot].m_pCallback = nullptr;
+	m_pEntries[nSlot].m_hGroup = 0;
+	m_pEntries[nSlot].m_nProbeLength = 0;
+
+	m_nCount--;
+
+	// Give the memory back after a burst, halving keeps the load factor far
+	// enough from the grow threshold so we don't bounce between the two.
+	if (m_nCapacity > APICALL_INDEX_MIN_CAPACITY && m_nCount * 8 < m_nCapacity)
+		Resize(m_nCapacity / 2);
+
+	return true;
 }
 
 //-----------------------------------------------------------------------------
-// Purpose: Returns handle to steam user used by callback manager.
+// Purpose: Removes every entry the routine returns true for, rehashing the rest
+//			in place. Returns how many were removed.
 //-----------------------------------------------------------------------------
-HSteamUser CallbackMgr_GetHSteamUserCurrent()
+uint32 CAPICallIndex::RemoveIf(bool (*pfnRemove)(const Entry_t &Entry, void *pContext), void *pContext)
 {
-	return GCallbackMgr()->m_hSteamUser;
-}
\ No newline at end of file
+	Entry_t*	pOldEntries;
+	uint32		nRemoved;
+
+	if (!m_nCount)
+		return 0;
+
+	pOldEntries = m_pEntries;
+	nRemoved = 0;
+
+	CountCallbackAllocation(sizeof(Entry_t) * m_nCapacity);
+	m_pEntries = new Entry_t[m_nCapacity]();
+	m_nCount = 0;
+
+	for (uint32 i = 0; i < m_nCapacity; i++)
+	{
+		if (!pOldEntries[i].m_nProbeLength)
+			continue;
+
+		if (pfnRemove(pOldEntries[i], pContext))
+		{
+			nRemoved++;
+			continue;
+		}
+
+		pOldEntries[i].m_nProbeLength = 1;
+		InsertNoGrow(pOldEntries[i]);
+		m_nCount++;
+	}
+
+	delete[] pOldEntries;
+
+	return nRemoved;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Removes all entries and frees the memory.
+//-----------------------------------------------------------------------------
+void CAPICallIndex::Clear()
+{
+	delete[] m_pEntries;
+
+	m_pEntries = nullptr;
+	m_nCapacity = 0;
+	m_nCount = 0;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Returns first listener waiting for the handle, nullptr if none.
+//-----------------------------------------------------------------------------
+CCallbackBase* CAPICallIndex::Find(SteamAPICall_t hAPICall) const
+{
+	int iSlot;
+
+	iSlot = FindSlot(hAPICall, nullptr);
+	if (iSlot < 0)
+		return nullptr;
+
+	return m_pEntries[iSlot].m_pCallback;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Returns first entry of the handle, nullptr if none. Only valid until
+//			the index is modified.
+//-----------------------------------------------------------------------------
+const CAPICallIndex::Entry_t* CAPICallIndex::FindEntry(SteamAPICall_t hAPICall) const
+{
+	int iSlot;
+
+	iSlot = FindSlot(hAPICall, nullptr);
+	if (iSlot < 0)
+		return nullptr;
+
+	return &m_pEntries[iSlot];
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Rehashes all entries into a new array of nCapacity slots.
+//-----------------------------------------------------------------------------
+void CAPICallIndex::Resize(uint32 nCapacity)
+{
+	Entry_t*	pOldEntries;
+	uint32		nOldCapacity;
+
+	pOldEntries = m_pEntries;
+	nOldCapacity = m_nCapacity;
+
+	CountCallbackAllocation(sizeof(Entry_t) * nCapacity);
+	m_pEntries = new Entry_t[nCapacity]();
+	m_nCapacity = nCapacity;
+
+	for (uint32 i = 0; i < nOldCapacity; i++)
+	{
+		if (!pOldEntries[i].m_nProbeLength)
+			continue;
+
+		pOldEntries[i].m_nProbeLength = 1;
+		InsertNoGrow(pOldEntries[i]);
+	}
+
+	delete[] pOldEntries;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Robin Hood insertion. Entry that is closer to its home slot gives
+//			way to the one we're inserting, which keeps probe lengths short.
+//-----------------------------------------------------------------------------
+void CAPICallIndex::InsertNoGrow(Entry_t Entry)
+{
+	uint32 nMask, nSlot;
+
+	nMask = m_nCapacity - 1;
+	nSlot = HashAPICall(Entry.m_hAPICall) & nMask;
+
+	while (m_pEntries[nSlot].m_nProbeLength)
+	{
+		if (m_pEntries[nSlot].m_nProbeLength < Entry.m_nProbeLength)
+			std::swap(m_pEntries[nSlot], Entry);
+
+		nSlot = (nSlot + 1) & nMask;
+		Entry.m_nProbeLength++;
+	}
+
+	m_pEntries[nSlot] = Entry;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Returns slot of the handle owned by the listener (any listener if
+//			nullptr), or -1 if not found.
+//-----------------------------------------------------------------------------
+int CAPICallIndex::FindSlot(SteamAPICall_t hAPICall, CCallbackBase *pCallback) const
+{
+	uint32 nMask, nSlot, nProbeLength;
+
+	if (!m_nCount)
+		return -1;
+
+	nMask = m_nCapacity - 1;
+	nSlot = HashAPICall(hAPICall) & nMask;
+
+	for (nProbeLength = 1; ; nProbeLength++)
+	{
+		const Entry_t& Entry = m_pEntries[nSlot];
+
+		// Empty slot, or an entry that is closer to home than we would be,
+		// means the handle cannot be any further.
+		if (Entry.m_nProbeLength < nProbeLength)
+			return -1;
+
+		if (Entry.m_hAPICall == hAPICall && (!pCallback || Entry.m_pCallback == pCallback))
+			return (int)nSlot;
+
+		nSlot = (nSlot + 1) & nMask;
+	}
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: 64-bit finalizer mix, API call handles are sequential in their low
+//			bits so they need to be spread before masking.
+//-----------------------------------------------------------------------------
+uint32 CAPICallIndex::HashAPICall(SteamAPICall_t hAPICall)
+{
+	uint64 h = hAPICall;
+
+	h ^= h >> 33;
+	h *= 0xff51afd7ed558ccdull;
+	h ^= h >> 33;
+	h *= 0xc4ceb9fe1a85ec53ull;
+	h ^= h >> 33;
+
+	return (uint32)h;
+}
+
+//-----------------------------------------------------------------------------
+// 
+// Call result scratch arena
+// 
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// Purpose: Reusable buffer that call result payloads are fetched into. It is
+//			grown when a call result is registered, to the size of the largest
+//			payload seen so far, so that completing a call never has to go to
+//			the heap. Growing is postponed while the buffer is handed out, the
+//			listener that owns it may register another call result from Run().
+//-----------------------------------------------------------------------------
+class CCallbackScratchArena
+{
+public:
+	CCallbackScratchArena();
+	~CCallbackScratchArena();
+
+public:
+	void Reserve(int cubSize);
+
+	void* Acquire(int cubSize);
+	void Release(void *pBuffer, int cubSize);
+
+	uint64 GetBytesAvoided() const { return m_cubBytesAvoided.load(std::memory_order_relaxed); }
+
+private:
+	void Grow(int cubSize);
+
+private:
+	uint8*	m_pBuffer;
+	int		m_cubBuffer;
+
+	// Size requested by Reserve() while the buffer was in use
+	int		m_cubPending;
+	bool	m_bInUse;
+
+	// Total size of payloads that didn't need a heap allocation
+	std::atomic<uint64>	m_cubBytesAvoided;
+};
+
+//-----------------------------------------------------------------------------
+// Purpose: Constructor
+//-----------------------------------------------------------------------------
+CCallbackScratchArena::CCallbackScratchArena() :
+	m_pBuffer(nullptr),
+	m_cubBuffer(0),
+	m_cubPending(0),
+	m_bInUse(false),
+	m_cubBytesAvoided(0)
+{
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Destructor
+//-----------------------------------------------------------------------------
+CCallbackScratchArena::~CCallbackScratchArena()
+{
+	free(m_pBuffer);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Makes sure that a payload of cubSize bytes fits into the buffer.
+//-----------------------------------------------------------------------------
+void CCallbackScratchArena::Reserve(int cubSize)
+{
+	if (cubSize <= m_cubBuffer)
+		return;
+
+	if (m_bInUse)
+	{
+		m_cubPending = std::max(m_cubPending, cubSize);
+		return;
+	}
+
+	Grow(cubSize);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Hands out the buffer. Falls back to the heap if the buffer is busy
+//			or too small, which only happens for sizes that weren't reserved.
+//-----------------------------------------------------------------------------
+void* CCallbackScratchArena::Acquire(int cubSize)
+{
+	if (m_bInUse || cubSize > m_cubBuffer)
+	{
+		CountCallbackAllocation(cubSize);
+		return malloc(cubSize);
+	}
+
+	m_bInUse = true;
+	m_cubBytesAvoided.fetch_add(cubSize, std::memory_order_relaxed);
+
+	return m_pBuffer;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Returns the buffer obtained by Acquire().
+//-----------------------------------------------------------------------------
+void CCallbackScratchArena::Release(void *pBuffer, int cubSize)
+{
+	if (pBuffer != m_pBuffer)
+	{
+		free(pBuffer);
+		return;
+	}
+
+	m_bInUse = false;
+
+	if (m_cubPending > m_cubBuffer)
+		Grow(m_cubPending);
+
+	m_cubPending = 0;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Reallocates the buffer, contents are not preserved.
+//-----------------------------------------------------------------------------
+void CCallbackScratchArena::Grow(int cubSize)
+{
+	free(m_pBuffer);
+
+	CountCallbackAllocation(cubSize);
+	m_pBuffer = reinterpret_cast<uint8*>(malloc(cubSize));
+	m_cubBuffer = m_pBuffer ? cubSize : 0;
+}
+
+//-----------------------------------------------------------------------------
+// 
+// Coroutine frame pool
+// 
+//-----------------------------------------------------------------------------
+
+// Frames are rounded up to a power of two, from the smallest class up
+#define COROUTINE_FRAME_MIN_BYTES		128
+#define COROUTINE_FRAME_CLASSES			6
+
+// Frames of one class kept for reuse, the rest goes back to the heap
+#define COROUTINE_FRAME_MAX_CACHED		256
+
+//-----------------------------------------------------------------------------
+// Purpose: Free lists of coroutine frames, one per size class. Frames that are
+//			larger than the largest class are taken from the heap every time.
+//-----------------------------------------------------------------------------
+class CCoroutineFramePool
+{
+public:
+	CCoroutineFramePool();
+	~CCoroutineFramePool();
+
+public:
+	void* Alloc(uint32 cubFrame);
+	void Free(void *pFrame, uint32 cubFrame);
+
+private:
+	static int GetSizeClass(uint32 cubFrame);
+
+private:
+	struct FreeFrame_t
+	{
+		FreeFrame_t*	m_pNext;
+	};
+
+	struct SizeClass_t
+	{
+		std::mutex		m_Lock;
+		FreeFrame_t*	m_pFree;
+		int				m_cFree;
+	};
+
+	SizeClass_t	m_rgClasses[COROUTINE_FRAME_CLASSES];
+};
+
+//-----------------------------------------------------------------------------
+// Purpose: Constructor
+//-----------------------------------------------------------------------------
+CCoroutineFramePool::CCoroutineFramePool()
+{
+	for (int i = 0; i < COROUTINE_FRAME_CLASSES; i++)
+	{
+		m_rgClasses[i].m_pFree = nullptr;
+		m_rgClasses[i].m_cFree = 0;
+	}
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Destructor
+//-----------------------------------------------------------------------------
+CCoroutineFramePool::~CCoroutineFramePool()
+{
+	FreeFrame_t* pNext;
+
+	for (int i = 0; i < COROUTINE_FRAME_CLASSES; i++)
+	{
+		for (FreeFrame_t* pFrame = m_rgClasses[i].m_pFree; pFrame; pFrame = pNext)
+		{
+			pNext = pFrame->m_pNext;
+			free(pFrame);
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Returns index of the smallest class the frame fits into, or -1.
+//-----------------------------------------------------------------------------
+int CCoroutineFramePool::GetSizeClass(uint32 cubFrame)
+{
+	uint32 cubClass = COROUTINE_FRAME_MIN_BYTES;
+
+	for (int i = 0; i < COROUTINE_FRAME_CLASSES; i++, cubClass <<= 1)
+	{
+		if (cubFrame <= cubClass)
+			return i;
+	}
+
+	return -1;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Takes a frame off the free list of its class, allocates when empty.
+//-----------------------------------------------------------------------------
+void* CCoroutineFramePool::Alloc(uint32 cubFrame)
+{
+	FreeFrame_t*	pFrame;
+	int				iClass;
+
+	iClass = GetSizeClass(cubFrame);
+
+	if (iClass < 0)
+	{
+		CountCallbackAllocation(cubFrame);
+		return malloc(cubFrame);
+	}
+
+	{
+		std::lock_guard<std::mutex> Lock(m_rgClasses[iClass].m_Lock);
+
+		pFrame = m_rgClasses[iClass].m_pFree;
+
+		if (pFrame)
+		{
+			m_rgClasses[iClass].m_pFree = pFrame->m_pNext;
+			m_rgClasses[iClass].m_cFree--;
+			return pFrame;
+		}
+	}
+
+	// Whole class is allocated, so the frame can go to any size of the class
+	CountCallbackAllocation(COROUTINE_FRAME_MIN_BYTES << iClass);
+	return malloc(COROUTINE_FRAME_MIN_BYTES << iClass);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Puts the frame on the free list of its class.
+//-----------------------------------------------------------------------------
+void CCoroutineFramePool::Free(void *pFrame, uint32 cubFrame)
+{
+	int iClass;
+
+	if (!pFrame)
+		return;
+
+	iClass = GetSizeClass(cubFrame);
+
+	if (iClass >= 0)
+	{
+		std::lock_guard<std::mutex> Lock(m_rgClasses[iClass].m_Lock);
+
+		if (m_rgClasses[iClass].m_cFree < COROUTINE_FRAME_MAX_CACHED)
+		{
+			FreeFrame_t* pFree = static_cast<FreeFrame_t*>(pFrame);
+
+			pFree->m_pNext = m_rgClasses[iClass].m_pFree;
+			m_rgClasses[iClass].m_pFree = pFree;
+			m_rgClasses[iClass].m_cFree++;
+			return;
+		}
+	}
+
+	free(pFrame);
+}
+
+// Shared by all coroutines of the process
+static CCoroutineFramePool s_CoroutineFramePool;
+
+//-----------------------------------------------------------------------------
+// 
+// Callback message ring
+// 
+//-----------------------------------------------------------------------------
+
+// Initial amount of slots in a ring, always a power of two
+#define CALLBACK_RING_MIN_SLOTS		64
+
+// Budgeted dispatch stops pulling from the pipe once this many messages wait
+// in the backlog, the rest stays queued in steamclient.
+#define CALLBACK_BACKLOG_MAX_MESSAGES	4096
+
+//-----------------------------------------------------------------------------
+// Purpose: FIFO of callback messages copied out of the steamclient pipe. Each 
+//			slot keeps its payload buffer after being consumed, so once the ring
+//			has seen the largest message of every slot, queueing doesn't 
+//			allocate anymore.
+//-----------------------------------------------------------------------------
+class CCallbackMsgRing
+{
+public:
+	struct Slot_t
+	{
+		HSteamUser	m_hSteamUser;
+		int			m_iCallback;
+		int			m_cubParam;
+
+		uint8*		m_pubParam;
+		int			m_cubCapacity;
+	};
+
+public:
+	CCallbackMsgRing();
+	~CCallbackMsgRing();
+
+public:
+	void PushBack(const CallbackMsg_t *pCallbackMsg);
+	void PopFront();
+
+	// Message pointing into the front slot, valid until PopFront()
+	void Front(CallbackMsg_t *pCallbackMsg) const;
+
+	bool IsEmpty() const { return m_nHead == m_nTail; }
+	uint32 Count() const { return m_nTail - m_nHead; }
+
+private:
+	void Grow();
+
+private:
+	Slot_t*	m_pSlots;
+	uint32	m_nSlots;
+
+	// Free running indices, masked on access
+	uint32	m_nHead;
+	uint32	m_nTail;
+};
+
+//-----------------------------------------------------------------------------
+// Purpose: Constructor
+//-----------------------------------------------------------------------------
+CCallbackMsgRing::CCallbackMsgRing() :
+	m_pSlots(nullptr),
+	m_nSlots(0),
+	m_nHead(0),
+	m_nTail(0)
+{
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Destructor
+//-----------------------------------------------------------------------------
+CCallbackMsgRing::~CCallbackMsgRing()
+{
+	for (uint32 i = 0; i < m_nSlots; i++)
+		free(m_pSlots[i].m_pubParam);
+
+	delete[] m_pSlots;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Copies the message and its payload at the end of the ring.
+//-----------------------------------------------------------------------------
+void CCallbackMsgRing::PushBack(const CallbackMsg_t *pCallbackMsg)
+{
+	Slot_t* pSlot;
+
+	if (Count() == m_nSlots)
+		Grow();
+
+	pSlot = &m_pSlots[m_nTail & (m_nSlots - 1)];
+
+	if (pCallbackMsg->m_cubParam > pSlot->m_cubCapacity)
+	{
+		free(pSlot->m_pubParam);
+		CountCallbackAllocation(pCallbackMsg->m_cubParam);
+		pSlot->m_pubParam = reinterpret_cast<uint8*>(malloc(pCallbackMsg->m_cubParam));
+		pSlot->m_cubCapacity = pCallbackMsg->m_cubParam;
+	}
+
+	pSlot->m_hSteamUser = pCallbackMsg->m_hSteamUser;
+	pSlot->m_iCallback = pCallbackMsg->m_iCallback;
+	pSlot->m_cubParam = pCallbackMsg->m_cubParam;
+
+	if (pCallbackMsg->m_cubParam > 0)
+		memcpy(pSlot->m_pubParam, pCallbackMsg->m_pubParam, pCallbackMsg->m_cubParam);
+
+	m_nTail++;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Consumes the front message. The slot keeps its payload buffer.
+//-----------------------------------------------------------------------------
+void CCallbackMsgRing::PopFront()
+{
+	if (!IsEmpty())
+		m_nHead++;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Fills pCallbackMsg with the front message.
+//-----------------------------------------------------------------------------
+void CCallbackMsgRing::Front(CallbackMsg_t *pCallbackMsg) const
+{
+	const Slot_t* pSlot;
+
+	pSlot = &m_pSlots[m_nHead & (m_nSlots - 1)];
+
+	pCallbackMsg->m_hSteamUser = pSlot->m_hSteamUser;
+	pCallbackMsg->m_iCallback = pSlot->m_iCallback;
+	pCallbackMsg->m_pubParam = pSlot->m_pubParam;
+	pCallbackMsg->m_cubParam = pSlot->m_cubParam;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Doubles the amount of slots, queued messages keep their order.
+//-----------------------------------------------------------------------------
+void CCallbackMsgRing::Grow()
+{
+	Slot_t*	pSlots;
+	uint32	nSlots, nCount;
+
+	nSlots = m_nSlots ? m_nSlots * 2 : CALLBACK_RING_MIN_SLOTS;
+	nCount = Count();
+
+	CountCallbackAllocation(sizeof(Slot_t) * nSlots);
+	pSlots = new Slot_t[nSlots]();
+
+	// Slots are moved together with their payload buffers, starting at head
+	for (uint32 i = 0; i < m_nSlots; i++)
+		pSlots[i] = m_pSlots[(m_nHead + i) & (m_nSlots - 1)];
+
+	delete[] m_pSlots;
+
+	m_pSlots = pSlots;
+	m_nSlots = nSlots;
+	m_nHead = 0;
+	m_nTail = nCount;
+}
+
+
+//-----------------------------------------------------------------------------
+// 
+// Callback pump ring
+// 
+//-----------------------------------------------------------------------------
+
+// Messages the pump thread can queue ahead of the dispatching thread
+#define CALLBACK_PUMP_RING_SLOTS		1024
+
+// Payload buffer preallocated for every slot of the pump ring
+#define CALLBACK_PUMP_SLOT_BYTES		256
+
+// Shortest sleep of the pump thread while the pipe is empty
+#define CALLBACK_PUMP_MIN_INTERVAL_US	50
+
+//-----------------------------------------------------------------------------
+// Purpose: Lock-free single producer, single consumer ring of callback messages.
+//			The producer is the pump thread of a pipe, the consumer is the thread
+//			calling RunCallbacks() for it. Slots are preallocated, the producer 
+//			only reallocates a payload buffer of a slot it owns when a message
+//			doesn't fit. When the ring is full, messages stay inside steamclient.
+//-----------------------------------------------------------------------------
+class CCallbackPumpRing
+{
+public:
+	CCallbackPumpRing();
+	~CCallbackPumpRing();
+
+public:
+	// Producer side
+	bool IsFull() const;
+	bool PushBack(const CallbackMsg_t *pCallbackMsg);
+
+	// Consumer side, message points into the slot until PopFront()
+	bool Front(CallbackMsg_t *pCallbackMsg) const;
+	void PopFront();
+
+private:
+	CCallbackMsgRing::Slot_t*	m_pSlots;
+
+	// Free running indices, kept on separate cache lines so the two threads
+	// don't keep stealing the line from each other.
+	alignas(64) std::atomic<uint32>	m_nHead;
+	alignas(64) std::atomic<uint32>	m_nTail;
+};
+
+//-----------------------------------------------------------------------------
+// Purpose: Constructor
+//-----------------------------------------------------------------------------
+CCallbackPumpRing::CCallbackPumpRing() :
+	m_nHead(0),
+	m_nTail(0)
+{
+	CountCallbackAllocation(sizeof(CCallbackMsgRing::Slot_t) * CALLBACK_PUMP_RING_SLOTS);
+	m_pSlots = new CCallbackMsgRing::Slot_t[CALLBACK_PUMP_RING_SLOTS]();
+
+	for (uint32 i = 0; i < CALLBACK_PUMP_RING_SLOTS; i++)
+	{
+		CountCallbackAllocation(CALLBACK_PUMP_SLOT_BYTES);
+		m_pSlots[i].m_pubParam = reinterpret_cast<uint8*>(malloc(CALLBACK_PUMP_SLOT_BYTES));
+		m_pSlots[i].m_cubCapacity = m_pSlots[i].m_pubParam ? CALLBACK_PUMP_SLOT_BYTES : 0;
+	}
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Destructor
+//-----------------------------------------------------------------------------
+CCallbackPumpRing::~CCallbackPumpRing()
+{
+	for (uint32 i = 0; i < CALLBACK_PUMP_RING_SLOTS; i++)
+		free(m_pSlots[i].m_pubParam);
+
+	delete[] m_pSlots;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Returns true if there's no free slot for the producer.
+//-----------------------------------------------------------------------------
+bool CCallbackPumpRing::IsFull() const
+{
+	return m_nTail.load(std::memory_order_relaxed) - m_nHead.load(std::memory_order_acquire) == CALLBACK_PUMP_RING_SLOTS;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Copies the message into the next free slot and publishes it. Must
+//			only be called when IsFull() returned false. Returns false if the
+//			payload doesn't fit and the slot can't be grown, the message isn't
+//			queued then.
+//-----------------------------------------------------------------------------
+bool CCallbackPumpRing::PushBack(const CallbackMsg_t *pCallbackMsg)
+{
+	CCallbackMsgRing::Slot_t*	pSlot;
+	uint8*						pubParam;
+	uint32						nTail;
+
+	nTail = m_nTail.load(std::memory_order_relaxed);
+	pSlot = &m_pSlots[nTail % CALLBACK_PUMP_RING_SLOTS];
+
+	if (pCallbackMsg->m_cubParam > pSlot->m_cubCapacity)
+	{
+		CountCallbackAllocation(pCallbackMsg->m_cubParam);
+		pubParam = reinterpret_cast<uint8*>(malloc(pCallbackMsg->m_cubParam));
+		if (!pubParam)
+			return false;
+
+		free(pSlot->m_pubParam);
+		pSlot->m_pubParam = pubParam;
+		pSlot->m_cubCapacity = pCallbackMsg->m_cubParam;
+	}
+
+	pSlot->m_hSteamUser = pCallbackMsg->m_hSteamUser;
+	pSlot->m_iCallback = pCallbackMsg->m_iCallback;
+	pSlot->m_cubParam = pCallbackMsg->m_cubParam;
+
+	if (pCallbackMsg->m_cubParam > 0)
+		memcpy(pSlot->m_pubParam, pCallbackMsg->m_pubParam, pCallbackMsg->m_cubParam);
+
+	m_nTail.store(nTail + 1, std::memory_order_release);
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Fills pCallbackMsg with the oldest published message. Returns false
+//			if there's none.
+//-----------------------------------------------------------------------------
+bool CCallbackPumpRing::Front(CallbackMsg_t *pCallbackMsg) const
+{
+	const CCallbackMsgRing::Slot_t*	pSlot;
+	uint32							nHead;
+
+	nHead = m_nHead.load(std::memory_order_relaxed);
+
+	if (nHead == m_nTail.load(std::memory_order_acquire))
+		return false;
+
+	pSlot = &m_pSlots[nHead % CALLBACK_PUMP_RING_SLOTS];
+
+	pCallbackMsg->m_hSteamUser = pSlot->m_hSteamUser;
+	pCallbackMsg->m_iCallback = pSlot->m_iCallback;
+	pCallbackMsg->m_pubParam = pSlot->m_pubParam;
+	pCallbackMsg->m_cubParam = pSlot->m_cubParam;
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Hands the front slot back to the producer.
+//-----------------------------------------------------------------------------
+void CCallbackPumpRing::PopFront()
+{
+	m_nHead.store(m_nHead.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+//-----------------------------------------------------------------------------
+// 
+// Callback statistics
+// 
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// Purpose: Counters of one callback identifier and one kind of delivery. 
+//			Updated by all dispatching threads, hence relaxed atomics.
+//-----------------------------------------------------------------------------
+struct CallbackStatsEntry_t
+{
+	std::atomic<uint64>		m_nCount;
+	std::atomic<uint64>		m_nTotalRunNanoseconds;
+	std::atomic<uint64>		m_nMaxRunNanoseconds;
+	std::atomic<uint64>		m_cubTotalPayload;
+	std::atomic<uint32>		m_rgnHistogram[STEAM_CALLBACK_STATS_HISTOGRAM_BUCKETS];
+};
+
+//-----------------------------------------------------------------------------
+// Purpose: Dispatch statistics, laid out like CCallbackDispatchTable. Every
+//			identifier has an entry for client listeners, game server listeners
+//			and call results. Blocks are allocated the first time an identifier
+//			of the interface is recorded and stay until the manager goes away.
+//			Identifiers outside of the dense range aren't recorded.
+//-----------------------------------------------------------------------------
+class CCallbackStats
+{
+public:
+	enum EKind
+	{
+		k_EKindClient,
+		k_EKindGameServer,
+		k_EKindCallResult,
+
+		k_EKindCount
+	};
+
+public:
+	CCallbackStats();
+	~CCallbackStats();
+
+public:
+	void SetEnabled(bool bEnabled);
+	bool IsEnabled() const;
+
+	void Record(int iCallback, EKind eKind, uint64 nRunNanoseconds, int cubPayload);
+	int Get(SteamCallbackStats_t *pStats, int cMaxStats);
+	void Reset();
+
+private:
+	CallbackStatsEntry_t* FindOrCreate(int iCallback, EKind eKind);
+
+	static int GetHistogramBucket(uint64 nNanoseconds);
+
+private:
+	std::atomic<bool>					m_bEnabled;
+
+	// CALLBACK_ID_INTERFACE_STRIDE * k_EKindCount entries per interface
+	std::atomic<CallbackStatsEntry_t*>	m_pInterfaceBlocks[CALLBACK_ID_MAX_INTERFACES];
+};
+
+//-----------------------------------------------------------------------------
+// Purpose: Constructor
+//-----------------------------------------------------------------------------
+CCallbackStats::CCallbackStats() :
+	m_bEnabled(false)
+{
+	for (int i = 0; i < CALLBACK_ID_MAX_INTERFACES; i++)
+		m_pInterfaceBlocks[i] = nullptr;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Destructor
+//-----------------------------------------------------------------------------
+CCallbackStats::~CCallbackStats()
+{
+	for (int i = 0; i < CALLBACK_ID_MAX_INTERFACES; i++)
+		delete[] m_pInterfaceBlocks[i].load();
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Turns recording on or off. Counters are kept while disabled.
+//-----------------------------------------------------------------------------
+void CCallbackStats::SetEnabled(bool bEnabled)
+{
+	m_bEnabled.store(bEnabled, std::memory_order_relaxed);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Dispatchers check this before reading the clock
+//-----------------------------------------------------------------------------
+bool CCallbackStats::IsEnabled() const
+{
+	return m_bEnabled.load(std::memory_order_relaxed);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Accounts one delivery of the identifier.
+//-----------------------------------------------------------------------------
+void CCallbackStats::Record(int iCallback, EKind eKind, uint64 nRunNanoseconds, int cubPayload)
+{
+	CallbackStatsEntry_t*	pEntry;
+	uint64					nMax;
+
+	pEntry = FindOrCreate(iCallback, eKind);
+	if (!pEntry)
+		return;
+
+	pEntry->m_nCount.fetch_add(1, std::memory_order_relaxed);
+	pEntry->m_nTotalRunNanoseconds.fetch_add(nRunNanoseconds, std::memory_order_relaxed);
+	pEntry->m_cubTotalPayload.fetch_add(cubPayload, std::memory_order_relaxed);
+	pEntry->m_rgnHistogram[GetHistogramBucket(nRunNanoseconds)].fetch_add(1, std::memory_order_relaxed);
+
+	nMax = pEntry->m_nMaxRunNanoseconds.load(std::memory_order_relaxed);
+	while (nRunNanoseconds > nMax && !pEntry->m_nMaxRunNanoseconds.compare_exchange_weak(nMax, nRunNanoseconds, std::memory_order_relaxed))
+		;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Copies up to cMaxStats entries that have recorded anything, ordered
+//			by identifier. Returns number of such entries, which may be more 
+//			than cMaxStats.
+//-----------------------------------------------------------------------------
+int CCallbackStats::Get(SteamCallbackStats_t *pStats, int cMaxStats)
+{
+	CallbackStatsEntry_t*	pBlock;
+	CallbackStatsEntry_t*	pEntry;
+	SteamCallbackStats_t*	pOut;
+	int						cStats;
+
+	cStats = 0;
+
+	for (int i = 0; i < CALLBACK_ID_MAX_INTERFACES; i++)
+	{
+		pBlock = m_pInterfaceBlocks[i].load(std::memory_order_acquire);
+		if (!pBlock)
+			continue;
+
+		for (int j = 0; j < CALLBACK_ID_INTERFACE_STRIDE * k_EKindCount; j++)
+		{
+			pEntry = &pBlock[j];
+
+			if (pEntry->m_nCount.load(std::memory_order_relaxed) == 0)
+				continue;
+
+			if (pStats && cStats < cMaxStats)
+			{
+				pOut = &pStats[cStats];
+
+				pOut->m_iCallback = i * CALLBACK_ID_INTERFACE_STRIDE + j / k_EKindCount;
+				pOut->m_bGameServer = (j % k_EKindCount) == k_EKindGameServer;
+				pOut->m_bCallResult = (j % k_EKindCount) == k_EKindCallResult;
+				pOut->m_nCount = pEntry->m_nCount.load(std::memory_order_relaxed);
+				pOut->m_nTotalRunNanoseconds = pEntry->m_nTotalRunNanoseconds.load(std::memory_order_relaxed);
+				pOut->m_nMaxRunNanoseconds = pEntry->m_nMaxRunNanoseconds.load(std::memory_order_relaxed);
+				pOut->m_cubTotalPayload = pEntry->m_cubTotalPayload.load(std::memory_order_relaxed);
+
+				for (int k = 0; k < STEAM_CALLBACK_STATS_HISTOGRAM_BUCKETS; k++)
+					pOut->m_rgnHistogram[k] = pEntry->m_rgnHistogram[k].load(std::memory_order_relaxed);
+			}
+
+			cStats++;
+		}
+	}
+
+	return cStats;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Zeroes all counters. Deliveries recorded at the same time may be
+//			partially kept.
+//-----------------------------------------------------------------------------
+void CCallbackStats::Reset()
+{
+	CallbackStatsEntry_t*	pBlock;
+	CallbackStatsEntry_t*	pEntry;
+
+	for (int i = 0; i < CALLBACK_ID_MAX_INTERFACES; i++)
+	{
+		pBlock = m_pInterfaceBlocks[i].load(std::memory_order_acquire);
+		if (!pBlock)
+			continue;
+
+		for (int j = 0; j < CALLBACK_ID_INTERFACE_STRIDE * k_EKindCount; j++)
+		{
+			pEntry = &pBlock[j];
+
+			pEntry->m_nCount.store(0, std::memory_order_relaxed);
+			pEntry->m_nTotalRunNanoseconds.store(0, std::memory_order_relaxed);
+			pEntry->m_nMaxRunNanoseconds.store(0, std::memory_order_relaxed);
+			pEntry->m_cubTotalPayload.store(0, std::memory_order_relaxed);
+
+			for (int k = 0; k < STEAM_CALLBACK_STATS_HISTOGRAM_BUCKETS; k++)
+				pEntry->m_rgnHistogram[k].store(0, std::memory_order_relaxed);
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Returns entry of the identifier, allocating block of its interface
+//			if needed. Returns nullptr for identifiers outside of the range.
+//-----------------------------------------------------------------------------
+CallbackStatsEntry_t* CCallbackStats::FindOrCreate(int iCallback, EKind eKind)
+{
+	CallbackStatsEntry_t*	pBlock;
+	CallbackStatsEntry_t*	pNewBlock;
+	int						iInterface;
+
+	if (iCallback < 0)
+		return nullptr;
+
+	iInterface = iCallback / CALLBACK_ID_INTERFACE_STRIDE;
+	if (iInterface >= CALLBACK_ID_MAX_INTERFACES)
+		return nullptr;
+
+	pBlock = m_pInterfaceBlocks[iInterface].load(std::memory_order_acquire);
+
+	if (!pBlock)
+	{
+		CountCallbackAllocation(sizeof(CallbackStatsEntry_t) * CALLBACK_ID_INTERFACE_STRIDE * k_EKindCount);
+		pNewBlock = new CallbackStatsEntry_t[CALLBACK_ID_INTERFACE_STRIDE * k_EKindCount]();
+
+		// Another dispatcher may have been faster
+		if (m_pInterfaceBlocks[iInterface].compare_exchange_strong(pBlock, pNewBlock, std::memory_order_acq_rel))
+			pBlock = pNewBlock;
+		else
+			delete[] pNewBlock;
+	}
+
+	return &pBlock[(iCallback % CALLBACK_ID_INTERFACE_STRIDE) * k_EKindCount + eKind];
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Log-linear bucket of the duration, two buckets per power of two 
+//			starting at 1024ns. See SteamCallbackStats_t.
+//-----------------------------------------------------------------------------
+int CCallbackStats::GetHistogramBucket(uint64 nNanoseconds)
+{
+	int iHighBit;
+	int iBucket;
+
+	if (nNanoseconds < 1024)
+		return 0;
+
+	iHighBit = 63;
+	while (!(nNanoseconds & (1ull << iHighBit)))
+		iHighBit--;
+
+	iBucket = (iHighBit - 10) * 2 + (int)((nNanoseconds >> (iHighBit - 1)) & 1);
+
+	return std::min(iBucket, STEAM_CALLBACK_STATS_HISTOGRAM_BUCKETS - 1);
+}
+
+//-----------------------------------------------------------------------------
+// 
+// Registry inbox
+// 
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// Purpose: Registration request posted by any thread. Carries everything that
+//			is needed to apply it, the listener may be gone by then.
+//-----------------------------------------------------------------------------
+struct CallbackRegistryOp_t
+{
+	enum EOp
+	{
+		k_ERegister,
+		k_EUnregister,
+		k_ERegisterCallResult,
+	};
+
+	EOp							m_eOp;
+	CallbackListener_t			m_Listener;		// m_pContext is the CCallResult for call results
+	int							m_iCallback;
+	SteamAPICall_t				m_hAPICall;
+
+	CallbackRegistryOp_t*		m_pNext;
+};
+
+// Nodes of applied requests, shared by all inboxes. Nodes are only ever pushed
+// one at a time and taken off as a whole list, so there's no ABA to worry about.
+static std::atomic<CallbackRegistryOp_t*> s_pReturnedRegistryOps(nullptr);
+
+//-----------------------------------------------------------------------------
+// Purpose: Nodes the current thread posts requests from. Refilled from the
+//			returned nodes, freed when the thread exits.
+//-----------------------------------------------------------------------------
+class CCallbackRegistryOpCache
+{
+public:
+	~CCallbackRegistryOpCache()
+	{
+		CallbackRegistryOp_t* pNext;
+
+		for (; m_pFree; m_pFree = pNext)
+		{
+			pNext = m_pFree->m_pNext;
+			delete m_pFree;
+		}
+	}
+
+public:
+	CallbackRegistryOp_t* m_pFree = nullptr;
+};
+
+static thread_local CCallbackRegistryOpCache t_RegistryOpCache;
+
+//-----------------------------------------------------------------------------
+// Purpose: Takes a node for a new request, allocating only when no applied
+//			one is left to reuse.
+//-----------------------------------------------------------------------------
+static CallbackRegistryOp_t* AllocRegistryOp()
+{
+	CallbackRegistryOp_t* pOp;
+
+	if (!t_RegistryOpCache.m_pFree && s_pReturnedRegistryOps.load(std::memory_order_relaxed))
+		t_RegistryOpCache.m_pFree = s_pReturnedRegistryOps.exchange(nullptr, std::memory_order_acquire);
+
+	pOp = t_RegistryOpCache.m_pFree;
+	if (pOp)
+	{
+		t_RegistryOpCache.m_pFree = pOp->m_pNext;
+		return pOp;
+	}
+
+	CountCallbackAllocation(sizeof(CallbackRegistryOp_t));
+	return new CallbackRegistryOp_t;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Returns node of an applied request, callable from any thread.
+//-----------------------------------------------------------------------------
+static void FreeRegistryOp(CallbackRegistryOp_t *pOp)
+{
+	pOp->m_pNext = s_pReturnedRegistryOps.load(std::memory_order_relaxed);
+
+	while (!s_pReturnedRegistryOps.compare_exchange_weak(pOp->m_pNext, pOp, std::memory_order_release, std::memory_order_relaxed))
+		;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Lock-free multiple producer, single consumer queue of registration
+//			requests. Producers push onto a list head, the consumer takes the
+//			whole list at once and gets it back in the order it was posted.
+//-----------------------------------------------------------------------------
+class CCallbackRegistryInbox
+{
+public:
+	CCallbackRegistryInbox();
+	~CCallbackRegistryInbox();
+
+public:
+	void Post(CallbackRegistryOp_t::EOp eOp, const CallbackListener_t &Listener, int iCallback, SteamAPICall_t hAPICall);
+	CallbackRegistryOp_t* TakeAll();
+
+	bool IsEmpty() const;
+
+private:
+	std::atomic<CallbackRegistryOp_t*>	m_pHead;
+};
+
+//-----------------------------------------------------------------------------
+// Purpose: Constructor
+//-----------------------------------------------------------------------------
+CCallbackRegistryInbox::CCallbackRegistryInbox() :
+	m_pHead(nullptr)
+{
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Destructor, drops requests nobody got to apply
+//-----------------------------------------------------------------------------
+CCallbackRegistryInbox::~CCallbackRegistryInbox()
+{
+	CallbackRegistryOp_t* pOp;
+	CallbackRegistryOp_t* pNext;
+
+	for (pOp = m_pHead.exchange(nullptr); pOp; pOp = pNext)
+	{
+		pNext = pOp->m_pNext;
+		FreeRegistryOp(pOp);
+	}
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Queues new request, callable from any thread.
+//-----------------------------------------------------------------------------
+void CCallbackRegistryInbox::Post(CallbackRegistryOp_t::EOp eOp, const CallbackListener_t &Listener, int iCallback, SteamAPICall_t hAPICall)
+{
+	CallbackRegistryOp_t* pOp;
+
+	pOp = AllocRegistryOp();
+	pOp->m_eOp = eOp;
+	pOp->m_Listener = Listener;
+	pOp->m_iCallback = iCallback;
+	pOp->m_hAPICall = hAPICall;
+	pOp->m_pNext = m_pHead.load(std::memory_order_relaxed);
+
+	while (!m_pHead.compare_exchange_weak(pOp->m_pNext, pOp, std::memory_order_release, std::memory_order_relaxed))
+		;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Takes every queued request, oldest first. Caller frees them with
+//			FreeRegistryOp().
+//-----------------------------------------------------------------------------
+CallbackRegistryOp_t* CCallbackRegistryInbox::TakeAll()
+{
+	CallbackRegistryOp_t*	pOp;
+	CallbackRegistryOp_t*	pNext;
+	CallbackRegistryOp_t*	pOldest;
+
+	pOp = m_pHead.exchange(nullptr, std::memory_order_acquire);
+
+	// Pushed newest first, turn it around
+	pOldest = nullptr;
+	while (pOp)
+	{
+		pNext = pOp->m_pNext;
+		pOp->m_pNext = pOldest;
+		pOldest = pOp;
+		pOp = pNext;
+	}
+
+	return pOldest;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Returns true if there's nothing to apply.
+//-----------------------------------------------------------------------------
+bool CCallbackRegistryInbox::IsEmpty() const
+{
+	return m_pHead.load(std::memory_order_relaxed) == nullptr;
+}
+
+//-----------------------------------------------------------------------------
+// 
+// Callback pipe context
+// 
+//-----------------------------------------------------------------------------
+
+// Pipes that can be dispatched at the same time. Every game server instance has
+// a pipe of its own, on top of the client, game server and content server ones.
+#define CALLBACK_MAX_PIPE_CONTEXTS	(MAX_GAMESERVER_INSTANCES + 8)
+
+//-----------------------------------------------------------------------------
+// Purpose: Dispatch state of one steamclient pipe. Every pipe has its own 
+//			running flag, current user and scratch buffers, so that different
+//			pipes can be pumped from different threads at the same time.
+//-----------------------------------------------------------------------------
+struct CallbackPipeContext_t
+{
+	// Pipe this context is bound to, NULL if free
+	std::atomic<HSteamPipe>		m_hSteamPipe;
+
+	// Set while the pipe is being dispatched
+	std::atomic<bool>			m_bRunning;
+
+	// Set while FindPipeContext() looks at the idle context to take it over,
+	// dispatch of the bound pipe waits for it instead of failing.
+	std::atomic<bool>			m_bTakeover;
+
+	// User of the message currently being dispatched
+	HSteamUser					m_hSteamUser;
+
+	// Call result payloads are fetched into this buffer
+	CCallbackScratchArena		m_CallResultArena;
+
+	// Messages carried over to the next frame by RunCallbacksBudget()
+	CCallbackMsgRing			m_Backlog;
+
+	// Background pump, set while the pump thread owns the pipe
+	std::atomic<bool>			m_bPumpActive;
+	std::atomic<bool>			m_bPumpStopRequested;
+	std::thread					m_PumpThread;
+	uint32						m_unPumpIntervalMicroseconds;
+
+	// Messages queued by the pump thread, kept after the pump stops until drained
+	CCallbackPumpRing*			m_pPumpRing;
+
+	// Monotonic counters, see SteamAPI_GetCallbackMgrCounters()
+	std::atomic<uint64>			m_nMessagesDispatched;
+	std::atomic<uint64>			m_nCallResultsCompleted;
+	std::atomic<uint64>			m_nCallResultsUnclaimed;
+
+	// Time call results completed on this pipe spent running, while recording
+	// statistics. Taken out of the sample of the message completing them.
+	int64						m_nsCallResultsRun;
+
+	// Context dispatched further up the stack of the same thread
+	CallbackPipeContext_t*		m_pPrevContext;
+
+	// Registry epoch the listener lists in use were read at, 0 outside of them
+	std::atomic<uint64>			m_nRegistryEpoch;
+
+	// Listener whose thunk is running, see RemoveListener()
+	std::atomic<const CallbackListener_t*>	m_pRunningListener;
+};
+
+// Context the current thread is dispatching, nullptr outside of dispatch
+static thread_local CallbackPipeContext_t* t_pDispatchContext = nullptr;
+
+//-----------------------------------------------------------------------------
+// Purpose: Listener unregistered while some dispatcher may still have it in 
+//			the list it's going through. Dispatchers that read their lists at
+//			m_nEpoch or earlier skip it, until then the removal is pending.
+//-----------------------------------------------------------------------------
+struct CallbackRemovedListener_t
+{
+	CallbackListener_t		m_Listener;
+	uint64					m_nEpoch;
+};
+
+// Epoch of a removal that hasn't been applied to the table yet, and of one 
+// that is being applied right now
+#define CALLBACK_EPOCH_PENDING		UINT64_MAX
+#define CALLBACK_EPOCH_APPLYING		(UINT64_MAX - 1)
+
+//-----------------------------------------------------------------------------
+// 
+// Callback manager class
+// 
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// Purpose: Steam callbacks
+//-----------------------------------------------------------------------------
+typedef bool (*pfnSteam_BGetCallback_t)(HSteamPipe hSteamPipe, CallbackMsg_t *pCallbackMsg);
+typedef void (*pfnSteam_FreeLastCallback_t)(HSteamPipe hSteamPipe);
+typedef bool (*pfnSteam_GetAPICallResult_t)(HSteamPipe hSteamPipe, SteamAPICall_t hSteamAPICall, void* pCallback, int cubCallback, int iCallbackExpected, bool* pbFailed);
+typedef bool (*pfnSteam_CallbackDispatchMsg_t)(CallbackMsg_t* pCallbackMessage, bool bGameServerCallbacks);
+
+// Call result groups that can exist at once
+#define CALLBACK_MAX_CALLRESULT_GROUPS	256
+
+// Group handle keeps the slot in its low bits and the generation above them
+#define CALLRESULT_GROUP_SLOT_BITS		8
+#define CALLRESULT_GROUP_SLOT_MASK		((1u << CALLRESULT_GROUP_SLOT_BITS) - 1)
+
+//-----------------------------------------------------------------------------
+// Purpose: Listener owning any number of handles in the call result index. 
+//			The generation is bumped when the group is destroyed, its handles
+//			left in the index are recognized as stale by that and dropped.
+//-----------------------------------------------------------------------------
+struct CallResultGroup_t
+{
+	uint32							m_nGeneration;
+	bool							m_bInUse;
+
+	int								m_iCallback;
+	int								m_cubParam;
+	SteamCallResultGroupThunk_t		m_pfnThunk;
+	void*							m_pContext;
+
+	// Index handed to the next handle added, and handles not completed yet
+	int								m_iNextIndex;
+	int								m_cPending;
+};
+
+//-----------------------------------------------------------------------------
+// Purpose: Callback management class
+//-----------------------------------------------------------------------------
+class CCallbackMgr
+{
+private:
+	template<bool bGameServer>
+	using SteamAPICallback = CCallback<CCallbackMgr, SteamAPICallCompleted_t, bGameServer>;
+
+	using DispatchDeadline = std::chrono::steady_clock::time_point;
+
+public:
+	CCallbackMgr();
+	~CCallbackMgr();
+
+public:
+	void Register(CCallbackBase *pCallback, int iCallback, HSteamPipe hSteamPipe);
+	void Unregister(CCallbackBase *pCallback);
+
+	void RegisterStatic(const SteamCallbackDescriptor_t *pDescriptor, SteamCallbackThunk_t pfnThunk, void *pContext);
+	void UnregisterStatic(const SteamCallbackDescriptor_t *pDescriptor, SteamCallbackThunk_t pfnThunk, void *pContext);
+	void RemoveListener(int iCallback, const CallbackListener_t &Listener);
+
+	void RegisterCallResult(CCallbackBase *pCallback, SteamAPICall_t hAPICall);
+	void UnregisterCallResult(CCallbackBase *pCallback, SteamAPICall_t hAPICall);
+	void ReserveCallResult(int cubCallback);
+
+	// Call result groups
+	HSteamCallResultGroup CreateCallResultGroup(const SteamCallbackDescriptor_t *pDescriptor, SteamCallResultGroupThunk_t pfnThunk, void *pContext);
+	void DestroyCallResultGroup(HSteamCallResultGroup hGroup);
+	int AddToCallResultGroup(HSteamCallResultGroup hGroup, SteamAPICall_t hAPICall);
+	int GetCallResultGroupPending(HSteamCallResultGroup hGroup);
+	CallResultGroup_t* FindCallResultGroup(HSteamCallResultGroup hGroup);
+	static bool IsStaleGroupEntry(const CAPICallIndex::Entry_t &Entry, void *pContext);
+
+	void RegisterInterfaceFuncs(HMODULE hModule);
+	void SetInterfaceFuncs(const SteamCallbackSource_t *pSource);
+	void SetCallbackSource(const SteamCallbackSource_t *pSource);
+
+	void OnSteamAPICallCompleted(SteamAPICallCompleted_t *pCompletedSteamAPICall);
+
+	// Callback dispatch
+	void RunCallbacks(HSteamPipe hSteamPipe, bool bGameServerCallbacks);
+	void RunCallbacksBudget(HSteamPipe hSteamPipe, bool bGameServerCallbacks, uint32 unBudgetMicroseconds);
+	bool DispatchBacklog(CallbackPipeContext_t *pContext, bool bGameServerCallbacks, const DispatchDeadline *pDeadline);
+	bool DispatchPumpRing(CallbackPipeContext_t *pContext, bool bGameServerCallbacks, const DispatchDeadline *pDeadline);
+	void DispatchCallback(CallbackPipeContext_t *pContext, CallbackMsg_t *pCallbackMsg, bool bGameServerCallbacks);
+	void DispatchCallbackTryCatch(CallbackPipeContext_t *pContext, CallbackMsg_t *pCallbackMsg, bool bGameServerCallbacks);
+	void DispatchCallbackNoTryCatch(CallbackPipeContext_t *pContext, CallbackMsg_t *pCallbackMsg, bool bGameServerCallbacks);
+	bool DispatchToListeners(CallbackPipeContext_t *pContext, CallbackMsg_t *pCallbackMsg, bool bGameServerCallbacks);
+
+	// Registry inbox
+	void ApplyListenerInbox();
+	void ApplyCallResultInbox();
+	void ReclaimListeners();
+	void MarkListenerRemoved(const CallbackListener_t &Listener);
+	bool IsListenerRemoved(const CallbackListener_t &Listener, uint64 nEpoch);
+	void WaitForListener(const CallbackListener_t &Listener);
+
+	// Pipe contexts
+	CallbackPipeContext_t* BeginDispatch(HSteamPipe hSteamPipe);
+	void EndDispatch(CallbackPipeContext_t *pContext);
+	CallbackPipeContext_t* FindPipeContext(HSteamPipe hSteamPipe);
+
+	// Background pump
+	bool StartPump(HSteamPipe hSteamPipe, uint32 unPollIntervalMicroseconds);
+	bool ReleasePipe(HSteamPipe hSteamPipe);
+	void DiscardPipeMessages(HSteamPipe hSteamPipe);
+	void StopPump(HSteamPipe hSteamPipe);
+	void StopPump(CallbackPipeContext_t *pContext);
+	void PumpThread(CallbackPipeContext_t *pContext);
+
+	HSteamUser GetHSteamUserCurrent();
+	uint64 GetScratchBytesAvoided();
+	void GetCounters(SteamCallbackMgrCounters_t *pCounters);
+
+public:
+	// Listener table, shared by all pipes. Dispatchers read it without a lock,
+	// the lock only serializes the threads applying the inbox. Every apply
+	// bumps the epoch, lists it replaced are freed once no pipe context holds
+	// an epoch they were published in.
+	std::mutex							m_RegistryLock;
+	CCallbackDispatchTable				m_CallbackTable;
+	CCallbackRegistryInbox				m_ListenerInbox;
+	std::atomic<uint64>					m_nRegistryEpoch;
+
+	// Listeners unregistered while some dispatcher may still see them. Counted
+	// so dispatchers can skip the lock if empty.
+	std::mutex							m_RemovedListenersLock;
+	std::vector<CallbackRemovedListener_t>	m_RemovedListeners;
+	std::atomic<int>					m_cRemovedListeners;
+
+	// Call result index. The lock is never held while a call result runs.
+	std::mutex							m_APICallLock;
+	CAPICallIndex						m_APICallIndex;
+	CCallbackRegistryInbox				m_CallResultInbox;
+
+	// Call result groups, guarded by m_APICallLock as well. Handles left in the
+	// index by destroyed groups are counted, so they can be swept in one pass.
+	CallResultGroup_t					m_rgCallResultGroups[CALLBACK_MAX_CALLRESULT_GROUPS];
+	uint32								m_cStaleGroupEntries;
+
+	// Largest call result payload registered so far
+	std::atomic<int>					m_cubLargestCallResult;
+
+	// Register and unregister calls of any kind made so far
+	std::atomic<uint64>					m_nRegistryOps;
+
+	// Dispatch statistics, disabled by default
+	CCallbackStats						m_CallbackStats;
+
+	// Dispatch state of each pipe
+	CallbackPipeContext_t				m_PipeContexts[CALLBACK_MAX_PIPE_CONTEXTS];
+
+	// Set once running out of contexts has been reported, until one is released
+	std::atomic<bool>					m_bPipeContextsExhausted;
+
+	// Callback steamclient API
+	pfnSteam_BGetCallback_t 			pfnSteam_BGetCallback;
+	pfnSteam_FreeLastCallback_t 		pfnSteam_FreeLastCallback;
+	pfnSteam_GetAPICallResult_t 		pfnSteam_GetAPICallResult;
+
+	// Set when the routines above were injected by SetCallbackSource(), steamclient
+	// modules loaded afterwards don't replace them.
+	bool								m_bExternalSource;
+
+	// Communication, user of the last message dispatched on any pipe
+	std::atomic<HSteamUser>				m_hSteamUser;
+
+	// Callbacks
+	pfnSteam_CallbackDispatchMsg_t 		pfnSteam_CallbackDispatchMsg;
+	SteamAPICallback<false>				m_SteamCallback;
+	SteamAPICallback<true>				m_SteamGameServerCallback;
+};
+
+//-----------------------------------------------------------------------------
+// Purpose: Constructor
+//-----------------------------------------------------------------------------
+CCallbackMgr::CCallbackMgr() :
+	// Callbacks for game server and steam client
+	m_SteamCallback(nullptr, nullptr),
+	m_SteamGameServerCallback(nullptr, nullptr), 
+
+	// Exported callback entries from steamclient module
+	pfnSteam_BGetCallback(nullptr), 
+	pfnSteam_FreeLastCallback(nullptr),
+	pfnSteam_GetAPICallResult(nullptr),
+	m_bExternalSource(false),
+	pfnSteam_CallbackDispatchMsg(nullptr),
+
+	// Communication to the steam client
+	m_hSteamUser(NULL),
+
+	m_cubLargestCallResult(0),
+	m_nRegistryOps(0)
+{
+	// API call maps
+	m_CallbackTable.Clear();
+	m_APICallIndex.Clear();
+
+	for (int i = 0; i < CALLBACK_MAX_CALLRESULT_GROUPS; i++)
+	{
+		m_rgCallResultGroups[i].m_nGeneration = 1;
+		m_rgCallResultGroups[i].m_bInUse = false;
+		m_rgCallResultGroups[i].m_cPending = 0;
+	}
+
+	m_cStaleGroupEntries = 0;
+	m_nRegistryEpoch = 1;
+	m_cRemovedListeners = 0;
+	m_bPipeContextsExhausted = false;
+
+	for (int i = 0; i < CALLBACK_MAX_PIPE_CONTEXTS; i++)
+	{
+		m_PipeContexts[i].m_hSteamPipe = NULL;
+		m_PipeContexts[i].m_bRunning = false;
+		m_PipeContexts[i].m_bTakeover = false;
+		m_PipeContexts[i].m_hSteamUser = NULL;
+		m_PipeContexts[i].m_pPrevContext = nullptr;
+		m_PipeContexts[i].m_nRegistryEpoch = 0;
+		m_PipeContexts[i].m_pRunningListener = nullptr;
+		m_PipeContexts[i].m_bPumpActive = false;
+		m_PipeContexts[i].m_bPumpStopRequested = false;
+		m_PipeContexts[i].m_unPumpIntervalMicroseconds = 0;
+		m_PipeContexts[i].m_pPumpRing = nullptr;
+		m_PipeContexts[i].m_nMessagesDispatched = 0;
+		m_PipeContexts[i].m_nCallResultsCompleted = 0;
+		m_PipeContexts[i].m_nCallResultsUnclaimed = 0;
+		m_PipeContexts[i].m_nsCallResultsRun = 0;
+	}
+
+	s_bCallbackManagerInitialized = true;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Destructor
+//-----------------------------------------------------------------------------
+CCallbackMgr::~CCallbackMgr()
+{
+	s_bCallbackManagerInitialized = false;
+
+	// Pump threads must not outlive us
+	for (int i = 0; i < CALLBACK_MAX_PIPE_CONTEXTS; i++)
+	{
+		StopPump(&m_PipeContexts[i]);
+
+		delete m_PipeContexts[i].m_pPumpRing;
+		m_PipeContexts[i].m_pPumpRing = nullptr;
+	}
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Adds new callback entry to the table. Callable from any thread, the
+//			entry is posted to the inbox and the listener receives messages 
+//			from the next one dispatched on. Bound to hSteamPipe it's only run
+//			for messages of that pipe, 0 runs it for all of them.
+//-----------------------------------------------------------------------------
+void CCallbackMgr::Register(CCallbackBase* pCallback, int iCallback, HSteamPipe hSteamPipe)
+{
+	CallbackListener_t	Listener;
+	bool				bGameServer;
+
+	// Tell that we are registered
+	pCallback->m_nCallbackFlags |= pCallback->k_ECallbackFlagsRegistered;
+	pCallback->m_iCallback = iCallback;
+
+	// Pipes listeners are bound to belong to game server instances
+	if (hSteamPipe)
+		pCallback->m_nCallbackFlags |= CCallbackBase::k_ECallbackFlagsGameServer;
+
+	bGameServer = (pCallback->m_nCallbackFlags & CCallbackBase::k_ECallbackFlagsGameServer) != 0;
+
+	Listener = MakeCallbackBaseListener(pCallback, bGameServer);
+	Listener.m_hSteamPipe = hSteamPipe;
+
+	m_nRegistryOps.fetch_add(1, std::memory_order_relaxed);
+	m_ListenerInbox.Post(CallbackRegistryOp_t::k_ERegister, Listener, iCallback, k_uAPICallInvalid);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Looks for a specific callback inside the table, and if there's a 
+//			match, matched callback entry will be erased from the table.
+//-----------------------------------------------------------------------------
+void CCallbackMgr::Unregister(CCallbackBase *pCallback)
+{
+	// If already unregistered there's no need to do it again
+	if (!(pCallback->m_nCallbackFlags & CCallbackBase::k_ECallbackFlagsRegistered))
+		return;
+
+	// Mark as unregistered so we don't then process unregisterd callback
+	pCallback->m_nCallbackFlags &= ~CCallbackBase::k_ECallbackFlagsRegistered;
+
+	m_nRegistryOps.fetch_add(1, std::memory_order_relaxed);
+
+	// Find matched callback and unregister it from the list
+	RemoveListener(pCallback->GetICallback(), MakeCallbackBaseListener(pCallback, false));
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Adds listener that is run through a non-virtual thunk, see 
+//			CStaticCallback. Same rules as Register() apply.
+//-----------------------------------------------------------------------------
+void CCallbackMgr::RegisterStatic(const SteamCallbackDescriptor_t *pDescriptor, SteamCallbackThunk_t pfnThunk, void *pContext)
+{
+	CallbackListener_t Listener;
+
+	Listener.m_pContext = pContext;
+	Listener.m_pfnThunk = pfnThunk;
+	Listener.m_cubParam = pDescriptor->m_cubParam;
+	Listener.m_bGameServer = pDescriptor->m_bGameServer;
+	Listener.m_hSteamPipe = 0;
+
+	m_nRegistryOps.fetch_add(1, std::memory_order_relaxed);
+	m_ListenerInbox.Post(CallbackRegistryOp_t::k_ERegister, Listener, pDescriptor->m_iCallback, k_uAPICallInvalid);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Removes listener added by RegisterStatic(). Same rules as 
+//			Unregister() apply.
+//-----------------------------------------------------------------------------
+void CCallbackMgr::UnregisterStatic(const SteamCallbackDescriptor_t *pDescriptor, SteamCallbackThunk_t pfnThunk, void *pContext)
+{
+	CallbackListener_t Listener;
+
+	Listener.m_pContext = pContext;
+	Listener.m_pfnThunk = pfnThunk;
+	Listener.m_cubParam = pDescriptor->m_cubParam;
+	Listener.m_bGameServer = pDescriptor->m_bGameServer;
+	Listener.m_hSteamPipe = 0;
+
+	m_nRegistryOps.fetch_add(1, std::memory_order_relaxed);
+	RemoveListener(pDescriptor->m_iCallback, Listener);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Takes the listener out of the table. Once this returns the listener
+//			is not run again and may be destroyed.
+// Note:	The listener is marked as removed first, so dispatchers that still
+//			go through a list containing it skip it, then the removal is 
+//			applied. The registry lock is never held while listeners run, so
+//			this doesn't wait on a dispatcher whose listener may be waiting on
+//			us. From outside of dispatch it then waits for the thunk of the 
+//			listener if some other thread is running it right now. From inside
+//			of a listener it doesn't, a listener that is shared by pipes which
+//			are dispatched on different threads should be unregistered from 
+//			outside of dispatch.
+//-----------------------------------------------------------------------------
+void CCallbackMgr::RemoveListener(int iCallback, const CallbackListener_t &Listener)
+{
+	MarkListenerRemoved(Listener);
+	m_ListenerInbox.Post(CallbackRegistryOp_t::k_EUnregister, Listener, iCallback, k_uAPICallInvalid);
+
+	{
+		std::lock_guard<std::mutex> Lock(m_RegistryLock);
+		ApplyListenerInbox();
+	}
+
+	// Might be our own caller further up the stack
+	if (t_pDispatchContext)
+		return;
+
+	WaitForListener(Listener);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Blocks while the listener runs on any pipe. Dispatchers publish the
+//			listener before they look at the removed ones and notify when it 
+//			returns.
+//-----------------------------------------------------------------------------
+void CCallbackMgr::WaitForListener(const CallbackListener_t &Listener)
+{
+	const CallbackListener_t*	pRunning;
+	bool						bSame;
+
+	for (int i = 0; i < CALLBACK_MAX_PIPE_CONTEXTS; i++)
+	{
+		std::atomic<const CallbackListener_t*>& RunningListener = m_PipeContexts[i].m_pRunningListener;
+
+		for (;;)
+		{
+			// The entry lives in a list that is only freed under the registry
+			// lock, so it can be looked at while holding it.
+			{
+				std::lock_guard<std::mutex> Lock(m_RegistryLock);
+
+				pRunning = RunningListener.load();
+				bSame = pRunning && pRunning->IsSame(Listener);
+			}
+
+			if (!bSame)
+				break;
+
+			RunningListener.wait(pRunning);
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Adds new call result to the index
+//-----------------------------------------------------------------------------
+void CCallbackMgr::RegisterCallResult(CCallbackBase* pCallback, SteamAPICall_t hAPICall)
+{
+	CallbackListener_t	Listener;
+	int					cubCallback;
+
+	if (hAPICall == k_uAPICallInvalid)
+		return;
+
+	cubCallback = pCallback->GetCallbackSizeBytes();
+
+	ReserveCallResult(cubCallback);
+
+	// Completion must not ask the listener, it may be destroyed by then
+	Listener = MakeCallbackBaseListener(pCallback, false);
+	Listener.m_cubParam = cubCallback;
+
+	m_nRegistryOps.fetch_add(1, std::memory_order_relaxed);
+	m_CallResultInbox.Post(CallbackRegistryOp_t::k_ERegisterCallResult, Listener, pCallback->GetICallback(), hAPICall);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Makes sure that a call result payload of cubCallback bytes can be
+//			completed without allocating.
+//-----------------------------------------------------------------------------
+void CCallbackMgr::ReserveCallResult(int cubCallback)
+{
+	// Scratch buffers of the pipes are grown to this size before they start
+	// dispatching, so the completion doesn't have to allocate.
+	int cubLargest = m_cubLargestCallResult.load(std::memory_order_relaxed);
+	while (cubCallback > cubLargest && !m_cubLargestCallResult.compare_exchange_weak(cubLargest, cubCallback))
+		;
+
+	// Registered from inside of a listener, the pipe is already dispatching
+	if (t_pDispatchContext)
+		t_pDispatchContext->m_CallResultArena.Reserve(cubCallback);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Looks for a specific APICall handle entry owned by the listener and
+//			erases it from the index.
+// Note:	Doesn't wait for a completion that is already running on another
+//			thread, see OnSteamAPICallCompleted().
+//-----------------------------------------------------------------------------
+void CCallbackMgr::UnregisterCallResult(CCallbackBase *pCallback, SteamAPICall_t hAPICall)
+{
+	// Call results don't carry k_ECallbackFlagsRegistered (CCallResult never
+	// sets it), so the entry is matched by the handle and listener instead.
+	if (hAPICall == k_uAPICallInvalid)
+		return;
+
+	m_nRegistryOps.fetch_add(1, std::memory_order_relaxed);
+
+	std::lock_guard<std::mutex> Lock(m_APICallLock);
+
+	// Its registration might be still waiting in the inbox
+	ApplyCallResultInbox();
+
+	m_APICallIndex.Remove(hAPICall, pCallback);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Takes a free group slot, returns 0 if all of them are in use.
+//-----------------------------------------------------------------------------
+HSteamCallResultGroup CCallbackMgr::CreateCallResultGroup(const SteamCallbackDescriptor_t *pDescriptor, SteamCallResultGroupThunk_t pfnThunk, void *pContext)
+{
+	CallResultGroup_t* pGroup;
+
+	if (!pDescriptor || !pfnThunk)
+		return 0;
+
+	ReserveCallResult(pDescriptor->m_cubParam);
+
+	m_nRegistryOps.fetch_add(1, std::memory_order_relaxed);
+
+	std::lock_guard<std::mutex> Lock(m_APICallLock);
+
+	for (uint32 i = 0; i < CALLBACK_MAX_CALLRESULT_GROUPS; i++)
+	{
+		pGroup = &m_rgCallResultGroups[i];
+
+		if (pGroup->m_bInUse)
+			continue;
+
+		pGroup->m_bInUse = true;
+		pGroup->m_iCallback = pDescriptor->m_iCallback;
+		pGroup->m_cubParam = pDescriptor->m_cubParam;
+		pGroup->m_pfnThunk = pfnThunk;
+		pGroup->m_pContext = pContext;
+		pGroup->m_iNextIndex = 0;
+		pGroup->m_cPending = 0;
+
+		return (pGroup->m_nGeneration << CALLRESULT_GROUP_SLOT_BITS) | i;
+	}
+
+	return 0;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Releases the group. Its pending handles are not looked for, they are
+//			only counted and swept once they make up half of the index.
+//-----------------------------------------------------------------------------
+void CCallbackMgr::DestroyCallResultGroup(HSteamCallResultGroup hGroup)
+{
+	CallResultGroup_t* pGroup;
+
+	m_nRegistryOps.fetch_add(1, std::memory_order_relaxed);
+
+	std::lock_guard<std::mutex> Lock(m_APICallLock);
+
+	pGroup = FindCallResultGroup(hGroup);
+	if (!pGroup)
+		return;
+
+	m_cStaleGroupEntries += pGroup->m_cPending;
+
+	// Handles of this group left in the index don't match anymore, generation
+	// zero would give handle zero to the slot zero, it's skipped.
+	pGroup->m_bInUse = false;
+	pGroup->m_cPending = 0;
+	pGroup->m_nGeneration = (pGroup->m_nGeneration + 1) & (0xFFFFFFFFu >> CALLRESULT_GROUP_SLOT_BITS);
+
+	if (!pGroup->m_nGeneration)
+		pGroup->m_nGeneration = 1;
+
+	if (m_cStaleGroupEntries >= APICALL_INDEX_MIN_CAPACITY && m_cStaleGroupEntries * 2 >= m_APICallIndex.Count())
+	{
+		m_APICallIndex.RemoveIf(IsStaleGroupEntry, this);
+		m_cStaleGroupEntries = 0;
+	}
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Adds handle to the group. Returns index of the handle within the 
+//			group, which is passed to the thunk on completion, or -1.
+//-----------------------------------------------------------------------------
+int CCallbackMgr::AddToCallResultGroup(HSteamCallResultGroup hGroup, SteamAPICall_t hAPICall)
+{
+	CallResultGroup_t*	pGroup;
+	int					iIndex;
+
+	if (hAPICall == k_uAPICallInvalid)
+		return -1;
+
+	if (t_pDispatchContext)
+		t_pDispatchContext->m_CallResultArena.Reserve(m_cubLargestCallResult.load(std::memory_order_relaxed));
+
+	m_nRegistryOps.fetch_add(1, std::memory_order_relaxed);
+
+	std::lock_guard<std::mutex> Lock(m_APICallLock);
+
+	pGroup = FindCallResultGroup(hGroup);
+	if (!pGroup)
+		return -1;
+
+	iIndex = pGroup->m_iNextIndex++;
+	pGroup->m_cPending++;
+
+	m_APICallIndex.InsertGroup(hAPICall, hGroup, iIndex);
+
+	return iIndex;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Returns how many handles of the group haven't completed yet
+//-----------------------------------------------------------------------------
+int CCallbackMgr::GetCallResultGroupPending(HSteamCallResultGroup hGroup)
+{
+	CallResultGroup_t* pGroup;
+
+	std::lock_guard<std::mutex> Lock(m_APICallLock);
+
+	pGroup = FindCallResultGroup(hGroup);
+	if (!pGroup)
+		return 0;
+
+	return pGroup->m_cPending;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Returns the group of the handle, nullptr if it was destroyed. 
+//			m_APICallLock must be held.
+//-----------------------------------------------------------------------------
+CallResultGroup_t* CCallbackMgr::FindCallResultGroup(HSteamCallResultGroup hGroup)
+{
+	CallResultGroup_t* pGroup;
+
+	pGroup = &m_rgCallResultGroups[hGroup & CALLRESULT_GROUP_SLOT_MASK];
+
+	if (!pGroup->m_bInUse || pGroup->m_nGeneration != (hGroup >> CALLRESULT_GROUP_SLOT_BITS))
+		return nullptr;
+
+	return pGroup;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Index sweep predicate, true for handles of destroyed groups
+//-----------------------------------------------------------------------------
+bool CCallbackMgr::IsStaleGroupEntry(const CAPICallIndex::Entry_t &Entry, void *pContext)
+{
+	CCallbackMgr* pThis = static_cast<CCallbackMgr*>(pContext);
+
+	return Entry.m_hGroup && !pThis->FindCallResultGroup(Entry.m_hGroup);
+}
+
+// Callback routines exported by steamclient, bound by RegisterInterfaceFuncs()
+static SteamCallbackSource_t s_SteamClientCallbackSource;
+
+static SteamSymbol_t s_rgSteamClientCallbackSymbols[] =
+{
+	{ "Steam_BGetCallback",		reinterpret_cast<void**>(&s_SteamClientCallbackSource.m_pfnBGetCallback) },
+	{ "Steam_FreeLastCallback",	reinterpret_cast<void**>(&s_SteamClientCallbackSource.m_pfnFreeLastCallback) },
+	{ "Steam_GetAPICallResult",	reinterpret_cast<void**>(&s_SteamClientCallbackSource.m_pfnGetAPICallResult) },
+};
+
+static SteamSymbolTable_t s_SteamClientCallbackSymbols = { "steamclient", s_rgSteamClientCallbackSymbols, Q_ARRAYSIZE(s_rgSteamClientCallbackSymbols) };
+
+//-----------------------------------------------------------------------------
+// Purpose: Register internal steamclient callback API and each callback object.
+//			Routines are looked up only the first time a module is passed in.
+//-----------------------------------------------------------------------------
+void CCallbackMgr::RegisterInterfaceFuncs(HMODULE hModule)
+{
+	// Injected routines take precedence over any steamclient module
+	if (m_bExternalSource)
+		return;
+
+	Steam_BindSymbols(&s_SteamClientCallbackSymbols, hModule);
+
+	SetInterfaceFuncs(&s_SteamClientCallbackSource);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Sets routines messages and call results are pulled through and
+//			registers each callback object.
+//-----------------------------------------------------------------------------
+void CCallbackMgr::SetInterfaceFuncs(const SteamCallbackSource_t *pSource)
+{
+	pfnSteam_BGetCallback = pSource->m_pfnBGetCallback;
+	pfnSteam_FreeLastCallback = pSource->m_pfnFreeLastCallback;
+	pfnSteam_GetAPICallResult = pSource->m_pfnGetAPICallResult;
+
+	// Manually register callbacks for both clients
+	m_SteamCallback.Register(this, &CCallbackMgr::OnSteamAPICallCompleted);
+	m_SteamGameServerCallback.Register(this, &CCallbackMgr::OnSteamAPICallCompleted);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Replaces steamclient routines with the ones of pSource, so dispatch
+//			can be driven without Steam. nullptr goes back to steamclient, its
+//			routines are resolved again by the next RegisterInterfaceFuncs().
+// Note:	Must not be called while any pipe is being dispatched or pumped.
+//-----------------------------------------------------------------------------
+void CCallbackMgr::SetCallbackSource(const SteamCallbackSource_t *pSource)
+{
+	if (pSource)
+	{
+		m_bExternalSource = true;
+		SetInterfaceFuncs(pSource);
+		return;
+	}
+
+	m_bExternalSource = false;
+
+	pfnSteam_BGetCallback = nullptr;
+	pfnSteam_FreeLastCallback = nullptr;
+	pfnSteam_GetAPICallResult = nullptr;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Routine that is called on APICall completion. It's responsible for
+//			unregistering the callback and then for executing it. Always runs
+//			on the thread dispatching the pipe the call was completed on.
+// Note:	The entry is taken out under m_APICallLock but the listener is run
+//			after it's released. UnregisterCallResult() called on another thread
+//			at the same time can't stop it anymore, so a call result must be
+//			unregistered (and destroyed) on the thread dispatching its pipe.
+//-----------------------------------------------------------------------------
+void CCallbackMgr::OnSteamAPICallCompleted(SteamAPICallCompleted_t *pCompletedSteamAPICall)
+{
+	CallbackPipeContext_t*			pContext;
+	void*							pCallbackData;
+	bool							bIOFailed;
+	CAPICallIndex::Entry_t			Entry;
+	CallResultGroup_t				Group;
+	const CAPICallIndex::Entry_t*	pEntry;
+	CallResultGroup_t*				pGroup;
+	int								iCallback;
+	int								iCallbackSize;
+	SteamAPICall_t					hAPICall;
+
+	pContext = t_pDispatchContext;
+	if (!pContext)
+		return;
+
+	hAPICall = pCompletedSteamAPICall->m_hAsyncCall;
+
+	{
+		std::lock_guard<std::mutex> Lock(m_APICallLock);
+
+		ApplyCallResultInbox();
+
+		pEntry = m_APICallIndex.FindEntry(hAPICall);
+		if (!pEntry)
+		{
+			pContext->m_nCallResultsUnclaimed.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+
+		// We don't need it no more. Drop it before running, so the listener is
+		// free to re-register itself or to be destroyed from inside of Run().
+		Entry = *pEntry;
+		m_APICallIndex.Remove(hAPICall, Entry.m_pCallback);
+
+		if (Entry.m_hGroup)
+		{
+			pGroup = FindCallResultGroup(Entry.m_hGroup);
+
+			// Left behind by a destroyed group
+			if (!pGroup)
+			{
+				if (m_cStaleGroupEntries)
+					m_cStaleGroupEntries--;
+
+				pContext->m_nCallResultsUnclaimed.fetch_add(1, std::memory_order_relaxed);
+				return;
+			}
+
+			// Group may be destroyed from inside of the thunk, it runs with a copy
+			pGroup->m_cPending--;
+			Group = *pGroup;
+		}
+	}
+
+	if (Entry.m_hGroup)
+	{
+		iCallback = Group.m_iCallback;
+		iCallbackSize = Group.m_cubParam;
+	}
+	else
+	{
+		iCallback = Entry.m_iCallback;
+		iCallbackSize = Entry.m_cubCallback;
+	}
+
+	bIOFailed = false;
+
+	pCallbackData = pContext->m_CallResultArena.Acquire(iCallbackSize);
+
+	// Try to dispatch the callback
+	if (pfnSteam_GetAPICallResult(pContext->m_hSteamPipe.load(std::memory_order_relaxed), hAPICall, pCallbackData, iCallbackSize, iCallback, &bIOFailed))
+	{
+		bool bRecordStats = m_CallbackStats.IsEnabled();
+		auto Start = std::chrono::steady_clock::time_point();
+
+		if (bRecordStats)
+			Start = std::chrono::steady_clock::now();
+
+		if (Entry.m_hGroup)
+			Group.m_pfnThunk(Group.m_pContext, pCallbackData, bIOFailed, hAPICall, Entry.m_iGroupIndex);
+		else
+			Entry.m_pCallback->Run(pCallbackData, bIOFailed, hAPICall);
+
+		// The listener may be gone once it has run, iCallback was taken before
+		if (bRecordStats)
+		{
+			int64 nsElapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - Start).count();
+
+			m_CallbackStats.Record(iCallback, CCallbackStats::k_EKindCallResult, nsElapsed, iCallbackSize);
+			pContext->m_nsCallResultsRun += nsElapsed;
+		}
+
+		pContext->m_nCallResultsCompleted.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	pContext->m_CallResultArena.Release(pCallbackData, iCallbackSize);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Dispatches all sheduled callbacks depending on the communcation 
+//			pipe. Whenether callbacks are dispatched is controlled by internal
+//			steamclient API - pfnSteam_BGetCallback() function. After the callback
+//			is dispatched, it's freed by calling pfnSteam_FreeLastCallback().
+//-----------------------------------------------------------------------------
+void CCallbackMgr::RunCallbacks(HSteamPipe hSteamPipe, bool bGameServerCallbacks)
+{
+	CallbackMsg_t			CallbackMsg;
+	CallbackPipeContext_t*	pContext;
+	bool					bPumpActive;
+
+	if (!pfnSteam_BGetCallback || !pfnSteam_FreeLastCallback)
+		return;
+
+	// Cannot dispatch when this pipe is already running
+	pContext = BeginDispatch(hSteamPipe);
+	if (!pContext)
+		return;
+
+	// Sample this first. If the pump stops after, everything it has queued is
+	// still older than what is left in the pipe.
+	bPumpActive = pContext->m_bPumpActive.load(std::memory_order_acquire);
+
+	// Messages left over by a budgeted run were pulled first, so they go first
+	DispatchBacklog(pContext, bGameServerCallbacks, nullptr);
+
+	if (pContext->m_pPumpRing)
+		DispatchPumpRing(pContext, bGameServerCallbacks, nullptr);
+
+	// The pump thread owns the pipe
+	if (bPumpActive)
+	{
+		EndDispatch(pContext);
+		return;
+	}
+
+	// Execute callbacks till there's no more left
+	while (pfnSteam_BGetCallback(hSteamPipe, &CallbackMsg))
+	{
+		pContext->m_hSteamUser = CallbackMsg.m_hSteamUser;
+		m_hSteamUser.store(CallbackMsg.m_hSteamUser, std::memory_order_relaxed);
+
+		// Call exception or non-exception cared callback dispatcher
+		DispatchCallback(pContext, &CallbackMsg, bGameServerCallbacks);
+
+		if (pfnSteam_FreeLastCallback)
+			pfnSteam_FreeLastCallback(hSteamPipe);
+	}
+
+	EndDispatch(pContext);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Budgeted version of RunCallbacks(). Everything that is pending on 
+//			the pipe is copied into the pipe's backlog ring and released back to
+//			steamclient right away, then messages are dispatched in order until
+//			the time budget is spent. Whatever is left is carried over to the
+//			next call. At least one message is dispatched per call, so the 
+//			backlog always drains eventually. Backlog doesn't grow past 
+//			CALLBACK_BACKLOG_MAX_MESSAGES, messages over it are left in the pipe.
+//-----------------------------------------------------------------------------
+void CCallbackMgr::RunCallbacksBudget(HSteamPipe hSteamPipe, bool bGameServerCallbacks, uint32 unBudgetMicroseconds)
+{
+	CallbackMsg_t			CallbackMsg;
+	CallbackPipeContext_t*	pContext;
+
+	if (!pfnSteam_BGetCallback || !pfnSteam_FreeLastCallback)
+		return;
+
+	// Cannot dispatch when this pipe is already running
+	pContext = BeginDispatch(hSteamPipe);
+	if (!pContext)
+		return;
+
+	DispatchDeadline Deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(unBudgetMicroseconds);
+
+	if (!pContext->m_bPumpActive.load(std::memory_order_acquire))
+	{
+		// Leftovers of a stopped pump are older than anything still in the pipe
+		if (pContext->m_pPumpRing)
+		{
+			while (pContext->m_Backlog.Count() < CALLBACK_BACKLOG_MAX_MESSAGES && pContext->m_pPumpRing->Front(&CallbackMsg))
+			{
+				pContext->m_Backlog.PushBack(&CallbackMsg);
+				pContext->m_pPumpRing->PopFront();
+			}
+		}
+
+		// New messages are queued behind the ones carried over from the last frame.
+		// Under sustained overload the backlog is capped, pipe keeps the rest.
+		if (!pContext->m_pPumpRing || !pContext->m_pPumpRing->Front(&CallbackMsg))
+		{
+			while (pContext->m_Backlog.Count() < CALLBACK_BACKLOG_MAX_MESSAGES && pfnSteam_BGetCallback(hSteamPipe, &CallbackMsg))
+			{
+				pContext->m_Backlog.PushBack(&CallbackMsg);
+				pfnSteam_FreeLastCallback(hSteamPipe);
+			}
+		}
+	}
+
+	// Backlog was filled before the pump started, so it goes before the pump ring
+	if (DispatchBacklog(pContext, bGameServerCallbacks, &Deadline) && pContext->m_pPumpRing)
+		DispatchPumpRing(pContext, bGameServerCallbacks, &Deadline);
+
+	EndDispatch(pContext);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Dispatches queued messages from the front of the backlog until it 
+//			is empty or until the deadline passes, nullptr means no deadline. 
+//			Returns true if the backlog has been drained.
+//-----------------------------------------------------------------------------
+bool CCallbackMgr::DispatchBacklog(CallbackPipeContext_t *pContext, bool bGameServerCallbacks, const DispatchDeadline *pDeadline)
+{
+	CallbackMsg_t		CallbackMsg;
+	CCallbackMsgRing*	pRing;
+
+	pRing = &pContext->m_Backlog;
+
+	while (!pRing->IsEmpty())
+	{
+		pRing->Front(&CallbackMsg);
+
+		pContext->m_hSteamUser = CallbackMsg.m_hSteamUser;
+		m_hSteamUser.store(CallbackMsg.m_hSteamUser, std::memory_order_relaxed);
+
+		// Nothing is pushed while dispatching, so the payload stays put
+		DispatchCallback(pContext, &CallbackMsg, bGameServerCallbacks);
+
+		pRing->PopFront();
+
+		if (pDeadline && std::chrono::steady_clock::now() >= *pDeadline)
+			return pRing->IsEmpty();
+	}
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Same as DispatchBacklog(), for messages queued by the pump thread.
+//-----------------------------------------------------------------------------
+bool CCallbackMgr::DispatchPumpRing(CallbackPipeContext_t *pContext, bool bGameServerCallbacks, const DispatchDeadline *pDeadline)
+{
+	CallbackMsg_t		CallbackMsg;
+	CCallbackPumpRing*	pRing;
+
+	pRing = pContext->m_pPumpRing;
+
+	while (pRing->Front(&CallbackMsg))
+	{
+		pContext->m_hSteamUser = CallbackMsg.m_hSteamUser;
+		m_hSteamUser.store(CallbackMsg.m_hSteamUser, std::memory_order_relaxed);
+
+		// The slot isn't handed back to the pump before the dispatch is over
+		DispatchCallback(pContext, &CallbackMsg, bGameServerCallbacks);
+
+		pRing->PopFront();
+
+		if (pDeadline && std::chrono::steady_clock::now() >= *pDeadline)
+			return !pRing->Front(&CallbackMsg);
+	}
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Executes exception-care or nonexception-care dispatch routine.
+//-----------------------------------------------------------------------------
+void CCallbackMgr::DispatchCallback(CallbackPipeContext_t *pContext, CallbackMsg_t *pCallbackMsg, bool bGameServerCallbacks)
+{
+	pContext->m_nMessagesDispatched.fetch_add(1, std::memory_order_relaxed);
+
+	// Remembered getter results don't hold across these
+	switch (pCallbackMsg->m_iCallback)
+	{
+		case SteamServersConnected_t::k_iCallback:
+		case SteamServersDisconnected_t::k_iCallback:
+		case GSPolicyResponse_t::k_iCallback:
+			Steam_InvalidateGetterCache(bGameServerCallbacks);
+			break;
+	}
+
+	if (g_bCatchExceptionsInCallbacks != false)
+	{
+		DispatchCallbackTryCatch(pContext, pCallbackMsg, bGameServerCallbacks);
+	}
+	else
+	{
+		DispatchCallbackNoTryCatch(pContext, pCallbackMsg, bGameServerCallbacks);
+	}
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Dispatches all sheduled callbacks with try & catch exception handling.
+//-----------------------------------------------------------------------------
+void CCallbackMgr::DispatchCallbackTryCatch(CallbackPipeContext_t *pContext, CallbackMsg_t *pCallbackMsg, bool bGameServerCallbacks)
+{
+	bool bGameServer;
+
+	try
+	{
+		bGameServer = DispatchToListeners(pContext, pCallbackMsg, bGameServerCallbacks);
+
+		if (pfnSteam_CallbackDispatchMsg)
+			pfnSteam_CallbackDispatchMsg(pCallbackMsg, bGameServer != false);
+	}
+	catch (...)
+	{
+		// Thrown out of a listener, it's not running anymore
+		pContext->m_pRunningListener.store(nullptr);
+		pContext->m_pRunningListener.notify_all();
+		pContext->m_nRegistryEpoch.store(0, std::memory_order_release);
+
+#ifdef REGS_FIXES
+		__debugbreak();
+#endif
+	}
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Dispatches all sheduled callbacks without try & catch exception 
+//			handling. 
+//-----------------------------------------------------------------------------
+void CCallbackMgr::DispatchCallbackNoTryCatch(CallbackPipeContext_t *pContext, CallbackMsg_t *pCallbackMsg, bool bGameServerCallbacks)
+{
+	bool bGameServer;
+
+	bGameServer = DispatchToListeners(pContext, pCallbackMsg, bGameServerCallbacks);
+
+	if (pfnSteam_CallbackDispatchMsg)
+		pfnSteam_CallbackDispatchMsg(pCallbackMsg, bGameServer != false);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Runs every listener registered for the callback identifier, in the
+//			order they were registered. Returns true if at least one listener
+//			matching the pipe type (game server or client) has been executed.
+//			Pending registrations are applied first. The list of listeners 
+//			then stays put until all of them have run, changes they make are
+//			seen by the next message.
+//-----------------------------------------------------------------------------
+bool CCallbackMgr::DispatchToListeners(CallbackPipeContext_t *pContext, CallbackMsg_t *pCallbackMsg, bool bGameServerCallbacks)
+{
+	const CCallbackDispatchTable::ListenerVector*	pListeners;
+	const CallbackListener_t*						pListener;
+	HSteamPipe										hSteamPipe;
+	uint64											nEpoch;
+	int64											nsCallResultsRun;
+	int64											nsElapsed;
+	bool											bGameServer;
+	bool											bStats;
+	DispatchDeadline								Start;
+
+	bGameServer = false;
+
+	// Applying only swaps lists, it never waits for listeners of other pipes.
+	// If another thread is at it, what it didn't take is left for next message.
+	if (!m_ListenerInbox.IsEmpty())
+	{
+		std::unique_lock<std::mutex> Lock(m_RegistryLock, std::try_to_lock);
+		if (Lock.owns_lock())
+			ApplyListenerInbox();
+	}
+
+	// Published before the list is read, it's not freed while we hold it
+	nEpoch = m_nRegistryEpoch.load();
+	pContext->m_nRegistryEpoch.store(nEpoch);
+
+	pListeners = m_CallbackTable.Find(pCallbackMsg->m_iCallback);
+	if (!pListeners)
+	{
+		pContext->m_nRegistryEpoch.store(0, std::memory_order_release);
+		return false;
+	}
+
+	hSteamPipe = pContext->m_hSteamPipe.load(std::memory_order_relaxed);
+
+	bStats = m_CallbackStats.IsEnabled();
+	if (bStats)
+	{
+		nsCallResultsRun = pContext->m_nsCallResultsRun;
+		Start = std::chrono::steady_clock::now();
+	}
+
+	for (size_t i = 0; i < pListeners->size(); i++)
+	{
+		pListener = &(*pListeners)[i];
+
+		if (pListener->m_bGameServer != bGameServerCallbacks)
+			continue;
+
+		// Bound to another instance
+		if (pListener->m_hSteamPipe && pListener->m_hSteamPipe != hSteamPipe)
+			continue;
+
+		if (pCallbackMsg->m_cubParam < pListener->m_cubParam)
+			continue;
+
+		// Unregistered since the list was read, might not even exist anymore.
+		// Published first, RemoveListener() waits for it.
+		pContext->m_pRunningListener.store(pListener);
+		if (m_cRemovedListeners.load() && IsListenerRemoved(*pListener, nEpoch))
+		{
+			pContext->m_pRunningListener.store(nullptr, std::memory_order_relaxed);
+			continue;
+		}
+
+		bGameServer = true;
+		pListener->m_pfnThunk(pListener->m_pContext, pCallbackMsg->m_pubParam);
+
+		pContext->m_pRunningListener.store(nullptr, std::memory_order_release);
+		pContext->m_pRunningListener.notify_all();
+	}
+
+	pContext->m_nRegistryEpoch.store(0, std::memory_order_release);
+
+	// Covers all listeners of the message. Call results completed by it have 
+	// been recorded on their own already, so their time is left out.
+	if (bStats && bGameServer)
+	{
+		nsElapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - Start).count();
+		nsElapsed -= pContext->m_nsCallResultsRun - nsCallResultsRun;
+
+		m_CallbackStats.Record(pCallbackMsg->m_iCallback, bGameServerCallbacks ? CCallbackStats::k_EKindGameServer : CCallbackStats::k_EKindClient,
+							   std::max<int64>(nsElapsed, 0), pCallbackMsg->m_cubParam);
+	}
+
+	return bGameServer;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Applies queued listener (un)registrations, in the order they were 
+//			posted, then frees what no dispatcher can see anymore. Registry 
+//			lock must be held.
+//-----------------------------------------------------------------------------
+void CCallbackMgr::ApplyListenerInbox()
+{
+	CallbackRegistryOp_t*	pOp;
+	CallbackRegistryOp_t*	pNext;
+	uint64					nEpoch;
+	bool					bRemoved;
+
+	pOp = m_ListenerInbox.TakeAll();
+	if (!pOp)
+		return;
+
+	bRemoved = false;
+
+	for (; pOp; pOp = pNext)
+	{
+		pNext = pOp->m_pNext;
+
+		if (pOp->m_eOp == CallbackRegistryOp_t::k_ERegister)
+		{
+			m_CallbackTable.Insert(pOp->m_iCallback, pOp->m_Listener);
+		}
+		else
+		{
+			m_CallbackTable.Remove(pOp->m_iCallback, pOp->m_Listener);
+			bRemoved = true;
+
+			// Other threads may have marked listeners they haven't posted yet
+			std::lock_guard<std::mutex> Lock(m_RemovedListenersLock);
+
+			for (CallbackRemovedListener_t& Removed : m_RemovedListeners)
+			{
+				if (Removed.m_nEpoch == CALLBACK_EPOCH_PENDING && Removed.m_Listener.IsSame(pOp->m_Listener))
+				{
+					Removed.m_nEpoch = CALLBACK_EPOCH_APPLYING;
+					break;
+				}
+			}
+		}
+
+		FreeRegistryOp(pOp);
+	}
+
+	// Dispatchers that read their lists at this epoch or before may still see
+	// the replaced ones, later dispatchers see the new lists.
+	nEpoch = m_nRegistryEpoch.fetch_add(1);
+
+	m_CallbackTable.Retire(nEpoch);
+
+	if (bRemoved)
+	{
+		std::lock_guard<std::mutex> Lock(m_RemovedListenersLock);
+
+		for (CallbackRemovedListener_t& Removed : m_RemovedListeners)
+		{
+			if (Removed.m_nEpoch == CALLBACK_EPOCH_APPLYING)
+				Removed.m_nEpoch = nEpoch;
+		}
+	}
+
+	ReclaimListeners();
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Frees replaced lists and forgets removed listeners from epochs no
+//			pipe context holds anymore. Registry lock must be held.
+//-----------------------------------------------------------------------------
+void CCallbackMgr::ReclaimListeners()
+{
+	uint64	nOldestEpoch;
+	uint64	nEpoch;
+	size_t	nKept;
+
+	nOldestEpoch = UINT64_MAX;
+
+	for (int i = 0; i < CALLBACK_MAX_PIPE_CONTEXTS; i++)
+	{
+		nEpoch = m_PipeContexts[i].m_nRegistryEpoch.load();
+		if (nEpoch && nEpoch < nOldestEpoch)
+			nOldestEpoch = nEpoch;
+	}
+
+	m_CallbackTable.Reclaim(nOldestEpoch);
+
+	if (!m_cRemovedListeners.load(std::memory_order_relaxed))
+		return;
+
+	std::lock_guard<std::mutex> Lock(m_RemovedListenersLock);
+
+	nKept = 0;
+
+	for (size_t i = 0; i < m_RemovedListeners.size(); i++)
+	{
+		if (m_RemovedListeners[i].m_nEpoch >= nOldestEpoch)
+			m_RemovedListeners[nKept++] = m_RemovedListeners[i];
+	}
+
+	m_RemovedListeners.resize(nKept);
+	m_cRemovedListeners.store((int)nKept);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Applies queued call result registrations. m_APICallLock must be held.
+//-----------------------------------------------------------------------------
+void CCallbackMgr::ApplyCallResultInbox()
+{
+	CallbackRegistryOp_t* pOp;
+	CallbackRegistryOp_t* pNext;
+
+	for (pOp = m_CallResultInbox.TakeAll(); pOp; pOp = pNext)
+	{
+		pNext = pOp->m_pNext;
+
+		m_APICallIndex.Insert(pOp->m_hAPICall, static_cast<CCallbackBase*>(pOp->m_Listener.m_pContext), pOp->m_iCallback, pOp->m_Listener.m_cubParam);
+
+		FreeRegistryOp(pOp);
+	}
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Marks the listener as removed until no dispatcher can see it in 
+//			its list anymore.
+//-----------------------------------------------------------------------------
+void CCallbackMgr::MarkListenerRemoved(const CallbackListener_t &Listener)
+{
+	std::lock_guard<std::mutex> Lock(m_RemovedListenersLock);
+
+	if (m_RemovedListeners.size() == m_RemovedListeners.capacity())
+		CountCallbackAllocation((m_RemovedListeners.capacity() + 1) * sizeof(CallbackRemovedListener_t));
+
+	m_RemovedListeners.push_back({ Listener, CALLBACK_EPOCH_PENDING });
+	m_cRemovedListeners.fetch_add(1);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Returns true if the listener has been unregistered, but a list read
+//			at nEpoch may still contain it.
+//-----------------------------------------------------------------------------
+bool CCallbackMgr::IsListenerRemoved(const CallbackListener_t &Listener, uint64 nEpoch)
+{
+	std::lock_guard<std::mutex> Lock(m_RemovedListenersLock);
+
+	for (const CallbackRemovedListener_t& Removed : m_RemovedListeners)
+	{
+		if (Removed.m_nEpoch >= nEpoch && Removed.m_Listener.IsSame(Listener))
+			return true;
+	}
+
+	return false;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Claims context of the pipe for the current thread. Returns nullptr 
+//			if the pipe is already being dispatched, or no context is left.
+//-----------------------------------------------------------------------------
+CallbackPipeContext_t* CCallbackMgr::BeginDispatch(HSteamPipe hSteamPipe)
+{
+	CallbackPipeContext_t*	pContext;
+	bool					bRunning;
+
+	for (;;)
+	{
+		pContext = FindPipeContext(hSteamPipe);
+		if (!pContext)
+			return nullptr;
+
+		bRunning = false;
+		if (!pContext->m_bRunning.compare_exchange_strong(bRunning, true))
+			return nullptr;
+
+		// Takeover probe found it idle before we claimed it, let it finish
+		while (pContext->m_bTakeover.load())
+			std::this_thread::yield();
+
+		if (pContext->m_hSteamPipe.load(std::memory_order_acquire) == hSteamPipe)
+			break;
+
+		// The context was handed over to another pipe in the meantime, look
+		// for ours again.
+		pContext->m_bRunning.store(false, std::memory_order_release);
+	}
+
+	// Grow scratch buffers now, while nothing is using them
+	pContext->m_CallResultArena.Reserve(m_cubLargestCallResult.load(std::memory_order_relaxed));
+
+	pContext->m_pPrevContext = t_pDispatchContext;
+	t_pDispatchContext = pContext;
+
+	return pContext;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Releases context claimed by BeginDispatch().
+//-----------------------------------------------------------------------------
+void CCallbackMgr::EndDispatch(CallbackPipeContext_t *pContext)
+{
+	t_pDispatchContext = pContext->m_pPrevContext;
+	pContext->m_pPrevContext = nullptr;
+
+	pContext->m_bRunning.store(false, std::memory_order_release);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Returns context bound to the pipe, or binds a free one. When all 
+//			contexts are taken, one that is idle and carries no backlog is 
+//			taken over, pipe handles of released pipes are never reported to us.
+//-----------------------------------------------------------------------------
+CallbackPipeContext_t* CCallbackMgr::FindPipeContext(HSteamPipe hSteamPipe)
+{
+	CallbackPipeContext_t*	pContext;
+	HSteamPipe				hBoundPipe;
+	bool					bTakeover;
+
+	for (int i = 0; i < CALLBACK_MAX_PIPE_CONTEXTS; i++)
+	{
+		if (m_PipeContexts[i].m_hSteamPipe.load(std::memory_order_acquire) == hSteamPipe)
+			return &m_PipeContexts[i];
+	}
+
+	for (int i = 0; i < CALLBACK_MAX_PIPE_CONTEXTS; i++)
+	{
+		hBoundPipe = NULL;
+		if (m_PipeContexts[i].m_hSteamPipe.compare_exchange_strong(hBoundPipe, hSteamPipe, std::memory_order_acq_rel))
+			return &m_PipeContexts[i];
+
+		// Somebody else bound it to our pipe just now
+		if (hBoundPipe == hSteamPipe)
+			return &m_PipeContexts[i];
+	}
+
+	for (int i = 0; i < CALLBACK_MAX_PIPE_CONTEXTS; i++)
+	{
+		pContext = &m_PipeContexts[i];
+
+		// Own the context while looking at its backlog. m_bRunning isn't used
+		// for this, dispatch of the bound pipe would fail instead of waiting.
+		bTakeover = false;
+		if (!pContext->m_bTakeover.compare_exchange_strong(bTakeover, true))
+			continue;
+
+		// Checked after the flag is up, BeginDispatch() checks the other way
+		// round, so one of us always sees the other.
+		if (pContext->m_bRunning.load())
+		{
+			pContext->m_bTakeover.store(false);
+			continue;
+		}
+
+		CallbackMsg_t CallbackMsg;
+
+		if (pContext->m_Backlog.IsEmpty() && !pContext->m_bPumpActive.load(std::memory_order_acquire) &&
+			(!pContext->m_pPumpRing || !pContext->m_pPumpRing->Front(&CallbackMsg)))
+		{
+			pContext->m_hSteamPipe.store(hSteamPipe, std::memory_order_release);
+			pContext->m_bTakeover.store(false);
+			return pContext;
+		}
+
+		pContext->m_bTakeover.store(false);
+	}
+
+	// Every context is bound to a pipe that is still in use, the pipe is not 
+	// dispatched at all until one of them is released.
+	if (!m_bPipeContextsExhausted.exchange(true))
+		OutputDebugStringA("[S_API FAIL] RunCallbacks() failed; out of callback pipe contexts, callbacks of the pipe are not dispatched.\n");
+
+	return nullptr;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Unbinds the context of the pipe and drops messages still queued for
+//			it, so that another pipe can use the context. Must be called before
+//			the pipe is released.
+// Note:	Waits for dispatch of the pipe running on another thread. Released 
+//			from inside of its own dispatch, the context is left to be taken 
+//			over once it's idle and false is returned.
+//-----------------------------------------------------------------------------
+bool CCallbackMgr::ReleasePipe(HSteamPipe hSteamPipe)
+{
+	CallbackPipeContext_t*	pContext;
+	CallbackPipeContext_t*	pDispatchContext;
+	CallbackMsg_t			CallbackMsg;
+	bool					bTakeover;
+
+	pContext = nullptr;
+
+	for (int i = 0; i < CALLBACK_MAX_PIPE_CONTEXTS; i++)
+	{
+		if (m_PipeContexts[i].m_hSteamPipe.load(std::memory_order_acquire) == hSteamPipe)
+		{
+			pContext = &m_PipeContexts[i];
+			break;
+		}
+	}
+
+	if (!pContext)
+		return true;
+
+	StopPump(pContext);
+
+	for (pDispatchContext = t_pDispatchContext; pDispatchContext; pDispatchContext = pDispatchContext->m_pPrevContext)
+	{
+		if (pDispatchContext == pContext)
+			return false;
+	}
+
+	// Same handshake as the takeover in FindPipeContext()
+	for (;;)
+	{
+		bTakeover = false;
+		if (pContext->m_bTakeover.compare_exchange_strong(bTakeover, true))
+		{
+			if (!pContext->m_bRunning.load())
+				break;
+
+			pContext->m_bTakeover.store(false);
+		}
+
+		std::this_thread::yield();
+	}
+
+	// Bound to another pipe while we were waiting
+	if (pContext->m_hSteamPipe.load(std::memory_order_acquire) == hSteamPipe)
+	{
+		while (!pContext->m_Backlog.IsEmpty())
+			pContext->m_Backlog.PopFront();
+
+		while (pContext->m_pPumpRing && pContext->m_pPumpRing->Front(&CallbackMsg))
+			pContext->m_pPumpRing->PopFront();
+
+		pContext->m_hSteamPipe.store(NULL, std::memory_order_release);
+		m_bPipeContextsExhausted.store(false);
+	}
+
+	pContext->m_bTakeover.store(false);
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Drops every message of the pipe without dispatching it, queued by
+//			us or still sitting in the pipe. The pipe is kept open but the 
+//			listeners won't see anything it received so far.
+// Note:	Does nothing but stop the pump when called from inside of dispatch
+//			of the pipe itself.
+//-----------------------------------------------------------------------------
+void CCallbackMgr::DiscardPipeMessages(HSteamPipe hSteamPipe)
+{
+	CallbackMsg_t CallbackMsg;
+
+	if (!ReleasePipe(hSteamPipe))
+		return;
+
+	if (!pfnSteam_BGetCallback || !pfnSteam_FreeLastCallback)
+		return;
+
+	while (pfnSteam_BGetCallback(hSteamPipe, &CallbackMsg))
+		pfnSteam_FreeLastCallback(hSteamPipe);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Starts a thread that pulls messages out of the pipe and queues them
+//			for RunCallbacks(), so the IPC round-trips of Steam_BGetCallback() and
+//			Steam_FreeLastCallback() don't happen on the dispatching thread. Has
+//			to be called from the thread that dispatches the pipe.
+//-----------------------------------------------------------------------------
+bool CCallbackMgr::StartPump(HSteamPipe hSteamPipe, uint32 unPollIntervalMicroseconds)
+{
+	CallbackPipeContext_t* pContext;
+
+	if (!pfnSteam_BGetCallback || !pfnSteam_FreeLastCallback)
+		return false;
+
+	pContext = FindPipeContext(hSteamPipe);
+	if (!pContext)
+		return false;
+
+	// Already pumping
+	if (pContext->m_bPumpActive.load(std::memory_order_acquire))
+		return true;
+
+	if (!pContext->m_pPumpRing)
+	{
+		CountCallbackAllocation(sizeof(CCallbackPumpRing));
+		pContext->m_pPumpRing = new CCallbackPumpRing();
+	}
+
+	// Sleeping for nothing would spin a core while the pipe is empty
+	pContext->m_unPumpIntervalMicroseconds = std::max<uint32>(unPollIntervalMicroseconds, CALLBACK_PUMP_MIN_INTERVAL_US);
+	pContext->m_bPumpStopRequested.store(false, std::memory_order_relaxed);
+	pContext->m_bPumpActive.store(true, std::memory_order_release);
+
+	pContext->m_PumpThread = std::thread(&CCallbackMgr::PumpThread, this, pContext);
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Stops pump thread of the pipe. Messages it has already queued are
+//			dispatched by the next RunCallbacks(). Must be called before the
+//			pipe is released.
+//-----------------------------------------------------------------------------
+void CCallbackMgr::StopPump(HSteamPipe hSteamPipe)
+{
+	for (int i = 0; i < CALLBACK_MAX_PIPE_CONTEXTS; i++)
+	{
+		if (m_PipeContexts[i].m_hSteamPipe.load(std::memory_order_acquire) == hSteamPipe)
+		{
+			StopPump(&m_PipeContexts[i]);
+			return;
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Stops pump thread of the context and waits for it to exit.
+//-----------------------------------------------------------------------------
+void CCallbackMgr::StopPump(CallbackPipeContext_t *pContext)
+{
+	if (!pContext->m_PumpThread.joinable())
+		return;
+
+	pContext->m_bPumpStopRequested.store(true, std::memory_order_release);
+	pContext->m_PumpThread.join();
+
+	pContext->m_bPumpActive.store(false, std::memory_order_release);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Pump thread routine. Pulls messages while there's room in the ring,
+//			sleeps for the poll interval when the pipe is empty or the 
+//			dispatching thread falls behind. A message that can't be queued is
+//			left in the pipe and fetched again after the sleep.
+//-----------------------------------------------------------------------------
+void CCallbackMgr::PumpThread(CallbackPipeContext_t *pContext)
+{
+	CallbackMsg_t		CallbackMsg;
+	CCallbackPumpRing*	pRing;
+	HSteamPipe			hSteamPipe;
+
+	pRing = pContext->m_pPumpRing;
+	hSteamPipe = pContext->m_hSteamPipe.load(std::memory_order_acquire);
+
+	while (!pContext->m_bPumpStopRequested.load(std::memory_order_acquire))
+	{
+		while (!pRing->IsFull() && pfnSteam_BGetCallback(hSteamPipe, &CallbackMsg))
+		{
+			if (!pRing->PushBack(&CallbackMsg))
+				break;
+
+			pfnSteam_FreeLastCallback(hSteamPipe);
+
+			if (pContext->m_bPumpStopRequested.load(std::memory_order_relaxed))
+				return;
+		}
+
+		std::this_thread::sleep_for(std::chrono::microseconds(pContext->m_unPumpIntervalMicroseconds));
+	}
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Returns user of the message the current thread is dispatching. 
+//			Outside of dispatch, user of the last message on any pipe.
+//-----------------------------------------------------------------------------
+HSteamUser CCallbackMgr::GetHSteamUserCurrent()
+{
+	if (t_pDispatchContext)
+		return t_pDispatchContext->m_hSteamUser;
+
+	return m_hSteamUser.load(std::memory_order_relaxed);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Sums payload bytes served from scratch arenas of all pipes.
+//-----------------------------------------------------------------------------
+uint64 CCallbackMgr::GetScratchBytesAvoided()
+{
+	uint64 cubTotal;
+
+	cubTotal = 0;
+
+	for (int i = 0; i < CALLBACK_MAX_PIPE_CONTEXTS; i++)
+		cubTotal += m_PipeContexts[i].m_CallResultArena.GetBytesAvoided();
+
+	return cubTotal;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Takes a snapshot of the monotonic counters. Counters of different
+//			pipes aren't read atomically with respect to each other.
+//-----------------------------------------------------------------------------
+void CCallbackMgr::GetCounters(SteamCallbackMgrCounters_t *pCounters)
+{
+	memset(pCounters, 0, sizeof(*pCounters));
+
+	for (int i = 0; i < CALLBACK_MAX_PIPE_CONTEXTS; i++)
+	{
+		CallbackPipeContext_t* pContext = &m_PipeContexts[i];
+
+		pCounters->m_nMessagesDispatched += pContext->m_nMessagesDispatched.load(std::memory_order_relaxed);
+		pCounters->m_nCallResultsCompleted += pContext->m_nCallResultsCompleted.load(std::memory_order_relaxed);
+		pCounters->m_nCallResultsUnclaimed += pContext->m_nCallResultsUnclaimed.load(std::memory_order_relaxed);
+	}
+
+	pCounters->m_nRegistryOps = m_nRegistryOps.load(std::memory_order_relaxed);
+	pCounters->m_nAllocations = s_nCallbackAllocations.load(std::memory_order_relaxed);
+	pCounters->m_cubAllocated = s_cubCallbackAllocated.load(std::memory_order_relaxed);
+	pCounters->m_cubScratchBytesAvoided = GetScratchBytesAvoided();
+
+	{
+		std::lock_guard<std::mutex> Lock(m_APICallLock);
+
+		pCounters->m_nOutstandingCallResults = m_APICallIndex.Count();
+	}
+}
+
+//-----------------------------------------------------------------------------
+// 
+// Callback manager C interface
+// 
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// Purpose: Singleton access
+//-----------------------------------------------------------------------------
+CCallbackMgr *GCallbackMgr()
+{
+	static CCallbackMgr CallbackManager;
+	return &CallbackManager;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Adds new callback to the already existing map.
+//-----------------------------------------------------------------------------
+void CallbackMgr_RegisterCallback(CCallbackBase *pCallback, int iCallback)
+{
+	GCallbackMgr()->Register(pCallback, iCallback, 0);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Adds new callback that is only run for messages of the pipe
+//-----------------------------------------------------------------------------
+void CallbackMgr_RegisterPipeCallback(CCallbackBase *pCallback, int iCallback, HSteamPipe hSteamPipe)
+{
+	GCallbackMgr()->Register(pCallback, iCallback, hSteamPipe);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Finds already existing callback inside the map and erases it.
+//-----------------------------------------------------------------------------
+void CallbackMgr_UnregisterCallback(CCallbackBase *pCallback)
+{
+	if (s_bCallbackManagerInitialized != true)
+		return;
+
+	GCallbackMgr()->Unregister(pCallback);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Registers listener run through a non-virtual thunk
+//-----------------------------------------------------------------------------
+void CallbackMgr_RegisterStaticCallback(const SteamCallbackDescriptor_t *pDescriptor, SteamCallbackThunk_t pfnThunk, void *pContext)
+{
+	GCallbackMgr()->RegisterStatic(pDescriptor, pfnThunk, pContext);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Unregisters listener run through a non-virtual thunk
+//-----------------------------------------------------------------------------
+void CallbackMgr_UnregisterStaticCallback(const SteamCallbackDescriptor_t *pDescriptor, SteamCallbackThunk_t pfnThunk, void *pContext)
+{
+	if (s_bCallbackManagerInitialized != true)
+		return;
+
+	GCallbackMgr()->UnregisterStatic(pDescriptor, pfnThunk, pContext);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Adds new call result to the already existing map.
+//-----------------------------------------------------------------------------
+void CallbackMgr_RegisterCallResult(CCallbackBase *pCallback, SteamAPICall_t hAPICall)
+{
+	GCallbackMgr()->RegisterCallResult(pCallback, hAPICall);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Unregisters API call result from the map.
+//-----------------------------------------------------------------------------
+void CallbackMgr_UnregisterCallResult(CCallbackBase *pCallback, SteamAPICall_t hAPICall)
+{
+	if (s_bCallbackManagerInitialized != true)
+		return;
+
+	GCallbackMgr()->UnregisterCallResult(pCallback, hAPICall);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Creates listener owning a set of call results
+//-----------------------------------------------------------------------------
+HSteamCallResultGroup CallbackMgr_CreateCallResultGroup(const SteamCallbackDescriptor_t *pDescriptor, SteamCallResultGroupThunk_t pfnThunk, void *pContext)
+{
+	return GCallbackMgr()->CreateCallResultGroup(pDescriptor, pfnThunk, pContext);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Destroys call result group, its pending handles are dropped
+//-----------------------------------------------------------------------------
+void CallbackMgr_DestroyCallResultGroup(HSteamCallResultGroup hGroup)
+{
+	if (s_bCallbackManagerInitialized != true)
+		return;
+
+	GCallbackMgr()->DestroyCallResultGroup(hGroup);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Adds API call handle to the group
+//-----------------------------------------------------------------------------
+int CallbackMgr_AddToCallResultGroup(HSteamCallResultGroup hGroup, SteamAPICall_t hAPICall)
+{
+	return GCallbackMgr()->AddToCallResultGroup(hGroup, hAPICall);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Returns amount of handles of the group not completed yet
+//-----------------------------------------------------------------------------
+int CallbackMgr_GetCallResultGroupPending(HSteamCallResultGroup hGroup)
+{
+	return GCallbackMgr()->GetCallResultGroupPending(hGroup);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Allocates a coroutine frame from the pool
+//-----------------------------------------------------------------------------
+void* CallbackMgr_AllocCoroutineFrame(uint32 cubFrame)
+{
+	return s_CoroutineFramePool.Alloc(cubFrame);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Returns coroutine frame to the pool
+//-----------------------------------------------------------------------------
+void CallbackMgr_FreeCoroutineFrame(void *pFrame, uint32 cubFrame)
+{
+	s_CoroutineFramePool.Free(pFrame, cubFrame);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Dispatches a set of callbacks on specific pipe.
+//-----------------------------------------------------------------------------
+void CallbackMgr_RunCallbacks(HSteamPipe SteamPipe, bool bGameServerCallbacks)
+{
+	GCallbackMgr()->RunCallbacks(SteamPipe, bGameServerCallbacks);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Dispatches callbacks on specific pipe within a time budget, the rest
+//			is carried over to the next call.
+//-----------------------------------------------------------------------------
+void CallbackMgr_RunCallbacksBudget(HSteamPipe SteamPipe, bool bGameServerCallbacks, uint32 unBudgetMicroseconds)
+{
+	GCallbackMgr()->RunCallbacksBudget(SteamPipe, bGameServerCallbacks, unBudgetMicroseconds);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Starts background pump thread for specific pipe.
+//-----------------------------------------------------------------------------
+bool CallbackMgr_StartPump(HSteamPipe SteamPipe, uint32 unPollIntervalMicroseconds)
+{
+	return GCallbackMgr()->StartPump(SteamPipe, unPollIntervalMicroseconds);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Stops background pump thread of specific pipe.
+//-----------------------------------------------------------------------------
+void CallbackMgr_StopPump(HSteamPipe SteamPipe)
+{
+	if (s_bCallbackManagerInitialized != true)
+		return;
+
+	GCallbackMgr()->StopPump(SteamPipe);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Hands dispatch context of specific pipe over to the next pipe, 
+//			called when the pipe is released.
+//-----------------------------------------------------------------------------
+void CallbackMgr_ReleasePipe(HSteamPipe SteamPipe)
+{
+	if (s_bCallbackManagerInitialized != true)
+		return;
+
+	GCallbackMgr()->ReleasePipe(SteamPipe);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Drops pending messages of specific pipe, which is kept open.
+//-----------------------------------------------------------------------------
+void CallbackMgr_DiscardPipeMessages(HSteamPipe SteamPipe)
+{
+	if (s_bCallbackManagerInitialized != true)
+		return;
+
+	GCallbackMgr()->DiscardPipeMessages(SteamPipe);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Registers interface routines located inside specified module.
+//-----------------------------------------------------------------------------
+void CallbackMgr_RegisterInterfaceFuncs(HMODULE hModule)
+{
+	GCallbackMgr()->RegisterInterfaceFuncs(hModule);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Injects routines messages and call results are pulled through.
+//-----------------------------------------------------------------------------
+void CallbackMgr_SetCallbackSource(const SteamCallbackSource_t *pSource)
+{
+	GCallbackMgr()->SetCallbackSource(pSource);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Returns handle to steam user used by callback manager.
+//-----------------------------------------------------------------------------
+HSteamUser CallbackMgr_GetHSteamUserCurrent()
+{
+	return GCallbackMgr()->GetHSteamUserCurrent();
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Returns how many bytes of call result payloads were served from the
+//			scratch arenas instead of the heap.
+//-----------------------------------------------------------------------------
+uint64 CallbackMgr_GetScratchBytesAvoided()
+{
+	return GCallbackMgr()->GetScratchBytesAvoided();
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Takes a snapshot of the callback manager counters
+//-----------------------------------------------------------------------------
+void CallbackMgr_GetCounters(SteamCallbackMgrCounters_t *pCounters)
+{
+	GCallbackMgr()->GetCounters(pCounters);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Turns recording of dispatch statistics on or off
+//-----------------------------------------------------------------------------
+void CallbackMgr_SetStatsEnabled(bool bEnabled)
+{
+	GCallbackMgr()->m_CallbackStats.SetEnabled(bEnabled);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Copies recorded dispatch statistics out
+//-----------------------------------------------------------------------------
+int CallbackMgr_GetStats(SteamCallbackStats_t *pStats, int cMaxStats)
+{
+	return GCallbackMgr()->m_CallbackStats.Get(pStats, cMaxStats);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Zeroes recorded dispatch statistics
+//-----------------------------------------------------------------------------
+void CallbackMgr_ResetStats()
+{
+	GCallbackMgr()->m_CallbackStats.Reset();
+}
@@ -16,11 +16,31 @@
 
 extern CCallbackMgr *GCallbackMgr();
 extern void CallbackMgr_RegisterCallback(CCallbackBase *pCallback, int iCallback);
+extern void CallbackMgr_RegisterPipeCallback(CCallbackBase *pCallback, int iCallback, HSteamPipe hSteamPipe);
 extern void CallbackMgr_UnregisterCallback(CCallbackBase *pCallback);
+extern void CallbackMgr_RegisterStaticCallback(const SteamCallbackDescriptor_t *pDescriptor, SteamCallbackThunk_t pfnThunk, void *pContext);
+extern void CallbackMgr_UnregisterStaticCallback(const SteamCallbackDescriptor_t *pDescriptor, SteamCallbackThunk_t pfnThunk, void *pContext);
 extern void CallbackMgr_RegisterCallResult(CCallbackBase *pCallback, SteamAPICall_t hAPICall);
 extern void CallbackMgr_UnregisterCallResult(CCallbackBase *pCallback, SteamAPICall_t hAPICall);
+extern HSteamCallResultGroup CallbackMgr_CreateCallResultGroup(const SteamCallbackDescriptor_t *pDescriptor, SteamCallResultGroupThunk_t pfnThunk, void *pContext);
+extern void CallbackMgr_DestroyCallResultGroup(HSteamCallResultGroup hGroup);
+extern int CallbackMgr_AddToCallResultGroup(HSteamCallResultGroup hGroup, SteamAPICall_t hAPICall);
+extern int CallbackMgr_GetCallResultGroupPending(HSteamCallResultGroup hGroup);
+extern void* CallbackMgr_AllocCoroutineFrame(uint32 cubFrame);
+extern void CallbackMgr_FreeCoroutineFrame(void *pFrame, uint32 cubFrame);
 extern void CallbackMgr_RunCallbacks(HSteamPipe SteamPipe, bool bGameServerCallbacks);
+extern void CallbackMgr_RunCallbacksBudget(HSteamPipe SteamPipe, bool bGameServerCallbacks, uint32 unBudgetMicroseconds);
+extern bool CallbackMgr_StartPump(HSteamPipe SteamPipe, uint32 unPollIntervalMicroseconds);
+extern void CallbackMgr_StopPump(HSteamPipe SteamPipe);
+extern void CallbackMgr_ReleasePipe(HSteamPipe SteamPipe);
+extern void CallbackMgr_DiscardPipeMessages(HSteamPipe SteamPipe);
 extern void CallbackMgr_RegisterInterfaceFuncs(HMODULE hModule);
+extern void CallbackMgr_SetCallbackSource(const SteamCallbackSource_t *pSource);
 extern HSteamUser CallbackMgr_GetHSteamUserCurrent();
+extern uint64 CallbackMgr_GetScratchBytesAvoided();
+extern void CallbackMgr_GetCounters(SteamCallbackMgrCounters_t *pCounters);
+extern void CallbackMgr_SetStatsEnabled(bool bEnabled);
+extern int CallbackMgr_GetStats(SteamCallbackStats_t *pStats, int cMaxStats);
+extern void CallbackMgr_ResetStats();
 
 #endif
\ No newline at end of file
@@ -7,6 +7,26 @@
 
 #include "steam_api_pch.h"
 
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <climits>
+#include <csignal>
+#include <dlfcn.h>
+#include <link.h>
+#include <unistd.h>
+
+// Where the client keeps steamclient for games, relative to home directory
+#ifdef PLATFORM_64BITS
+#define STEAMCLIENT_SDK_DIRECTORY	".steam/sdk64"
+#else
+#define STEAMCLIENT_SDK_DIRECTORY	".steam/sdk32"
+#endif
+#endif
+
 //-----------------------------------------------------------------------------
 // Purpose: Modules for steam.dll and steamclient.dll
 //-----------------------------------------------------------------------------
@@ -25,23 +45,22 @@ CModuleLoadWrapper g_MiniDumpSteamClientDllModule = { k_pszSteamClientModuleName
 //-----------------------------------------------------------------------------
 void CModuleLoadWrapper::Load()
 {
-	char szModulePath[MAX_PATH];
-	bool bSteamClientPath;
-
-	m_hModule = GetModuleHandle(m_pszModulePath);
+	char						szModulePath[MAX_PATH];
+	const SteamClientPaths_t*	pPaths;
 
-	// True if we've located steam client path
-	bSteamClientPath = ConfigureSteamClientPath(nullptr, NULL);
+	m_hModule = Steam_GetLoadedModule(m_pszModulePath);
 
 	// The module was loaded, no further actions needed
 	if (m_hModule)
 		return;
 
+	pPaths = Steam_GetClientPaths();
+
 	// Load the module within steam main directory
-	if (bSteamClientPath)
+	if (pPaths->m_bClientModuleFound)
 	{
 		m_bValid = true;
-		snprintf(szModulePath, sizeof(szModulePath), "%s%c%s", g_szSteamClientPath, PLATFORM_SLASH, m_pszModulePath);
+		snprintf(szModulePath, sizeof(szModulePath), "%s%c%s", pPaths->m_szClientDirectory, PLATFORM_SLASH, m_pszModulePath);
 		m_hModule = reinterpret_cast<HMODULE>(Steam_LoadModule(szModulePath));
 	}
 
@@ -84,6 +103,7 @@ uint32 GetSteamAppID(const char *szSteamAppID)
 	return appID;
 }
 
+#ifdef _WIN32
 //-----------------------------------------------------------------------------
 // Purpose: Returns registry key handle depending on the name.
 // 
@@ -134,50 +154,246 @@ BOOL GetRegistryValue(LPCSTR lpSubKey, LPCSTR lpValueName, LPBYTE lpData, DWORD
 	return (lStatus == NO_ERROR) ? TRUE : FALSE;
 }
 
+#endif
+
 //-----------------------------------------------------------------------------
-// Purpose: Setups full directory to the steam client. The path is stored inside
-//			g_szSteamClientPath[] global variable.
+// 
+// Steam client path resolver
+// 
 //-----------------------------------------------------------------------------
-bool ConfigureSteamClientPath(const char *pszPath, uint32 u32Length)
+
+// Current snapshot, nullptr until it's first asked for. Invalidation only marks
+// it stale, it's replaced if resolving again gives different paths. Replaced 
+// snapshots are never freed, callers may keep using one they got before. That
+// happens once per client restart or move, not per invalidation.
+static std::atomic<SteamClientPaths_t*>	s_pClientPaths(nullptr);
+static std::atomic<bool>				s_bClientPathsStale(false);
+static std::mutex						s_ClientPathsLock;
+
+//-----------------------------------------------------------------------------
+// Purpose: Returns true if process with given id is alive
+//-----------------------------------------------------------------------------
+bool Steam_IsProcessRunning(uint32 unPID)
 {
-	char	szClientPath[MAX_PATH];
-	DWORD	cbData;
-	HKEY	hKey, *phkResult;
-	BOOL	bSuccess;
-	DWORD	dwType;
-	HMODULE	hSteamClient;
+#ifdef _WIN32
+	HANDLE	hProcess;
+	DWORD	dwExitCode;
+	BOOL	bIsRunning;
 
-	if (strlen(g_szSteamClientPath) && !pszPath)
-		return true;
+	// Open steam process and query informaton from it
+	hProcess = OpenProcess(PROCESS_QUERY_INFORMATION, NULL, unPID);
 
-	*szClientPath = '\0';
-	memset(szClientPath + 1, NULL, sizeof(szClientPath) - 1);
+	if (!hProcess) // Not running
+		return false;
 
-	cbData = sizeof(szClientPath);
+	bIsRunning = FALSE;
+	dwExitCode = NULL;
 
-	// Get key for HKEY_CURRENT_USER
-	hKey = RegistryKeyByName("HKCU");
+	// Check for exit code
+	if (GetExitCodeProcess(hProcess, &dwExitCode) != ERROR_SUCCESS)
+	{
+		// No more data is available
+		if (dwExitCode == ERROR_NO_MORE_ITEMS)
+			bIsRunning = TRUE;
+	}
+
+	CloseHandle(hProcess);
+
+	return (bIsRunning == TRUE) ? true : false;
+#else
+	if (!unPID)
+		return false;
+
+	// Signal 0 only checks whether the process exists
+	return kill(unPID, 0) == 0 || errno == EPERM;
+#endif
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Reads process id the steam client has recorded, zero if there's 
+//			none. Read from scratch on each call, the client may have been 
+//			restarted since the paths were resolved.
+//-----------------------------------------------------------------------------
+uint32 Steam_ReadActiveSteamPID()
+{
+#ifdef _WIN32
+	DWORD		dwSteamPID;
+
+	dwSteamPID = NULL;
+	GetRegistryValue("Software\\Valve\\Steam\\ActiveProcess", "pid", (LPBYTE)&dwSteamPID, sizeof(dwSteamPID));
+
+	return dwSteamPID;
+#else
+	char		szPath[MAX_PATH];
+	const char*	pszHome;
+	FILE*		file;
+	int			nSteamPID;
+	uint32		unSteamPID;
+
+	pszHome = getenv("HOME");
+	if (!pszHome || !*pszHome)
+		return 0;
+
+	snprintf(szPath, sizeof(szPath), "%s/.steam/steam.pid", pszHome);
+
+	file = fopen(szPath, "rb");
+	if (!file)
+		return 0;
+
+	unSteamPID = 0;
+	if (fscanf(file, "%d", &nSteamPID) == 1 && nSteamPID > 0)
+		unSteamPID = nSteamPID;
+
+	fclose(file);
+
+	return unSteamPID;
+#endif
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Fills the snapshot. On windows the running client records its
+//			steamclient.dll and process id in the registry. Elsewhere the
+//			client installs its runtime under ~/.steam/sdk32 (sdk64 for 64-bit
+//			processes) and keeps its process id in ~/.steam/steam.pid.
+//-----------------------------------------------------------------------------
+static void Sys_ResolveClientPaths(SteamClientPaths_t *pPaths)
+{
+#ifdef _WIN32
+	HMODULE		hSteamClient;
 
 	// Lookup registry for the already existing path
-	bSuccess = GetRegistryValue("Software\\Valve\\Steam\\ActiveProcess", "SteamClientDll", (LPBYTE)szClientPath, cbData);
+	pPaths->m_bClientModuleFound = GetRegistryValue("Software\\Valve\\Steam\\ActiveProcess", "SteamClientDll", (LPBYTE)pPaths->m_szClientModulePath, sizeof(pPaths->m_szClientModulePath)) == TRUE;
 
-	// Check against last and first byte and get the path of steamclient.dll
-	if ((szClientPath + strlen(szClientPath) + 1) == (szClientPath + 1))
+	// Get the path of steamclient.dll
+	if (!*pPaths->m_szClientModulePath)
 	{
 		hSteamClient = GetModuleHandleA(k_pszSteamClientModuleName);
-		GetModuleFileNameA(hSteamClient, szClientPath, sizeof(szClientPath));
+		GetModuleFileNameA(hSteamClient, pPaths->m_szClientModulePath, sizeof(pPaths->m_szClientModulePath));
+	}
+
+	pPaths->m_unSteamPID = Steam_ReadActiveSteamPID();
+
+	// Retain only directory
+	strncpy(pPaths->m_szClientDirectory, pPaths->m_szClientModulePath, sizeof(pPaths->m_szClientDirectory));
+	Q_StripFilename(pPaths->m_szClientDirectory);
+
+	// Running client is loaded from its install directory
+	if (pPaths->m_bClientModuleFound && Steam_IsProcessRunning(pPaths->m_unSteamPID))
+		strncpy(pPaths->m_szInstallPath, pPaths->m_szClientDirectory, sizeof(pPaths->m_szInstallPath));
+#else
+	char		szPath[MAX_PATH];
+	char		szInstallPath[PATH_MAX];
+	const char*	pszHome;
+
+	pszHome = getenv("HOME");
+	if (!pszHome || !*pszHome)
+		return;
+
+	snprintf(szPath, sizeof(szPath), "%s/%s/%s", pszHome, STEAMCLIENT_SDK_DIRECTORY, k_pszSteamClientModuleName);
+
+	if (access(szPath, F_OK) == 0)
+	{
+		pPaths->m_bClientModuleFound = true;
+
+		strncpy(pPaths->m_szClientModulePath, szPath, sizeof(pPaths->m_szClientModulePath));
+
+		// Retain only directory
+		strncpy(pPaths->m_szClientDirectory, szPath, sizeof(pPaths->m_szClientDirectory));
+		Q_StripFilename(pPaths->m_szClientDirectory);
 	}
 
+	pPaths->m_unSteamPID = Steam_ReadActiveSteamPID();
+
+	if (!Steam_IsProcessRunning(pPaths->m_unSteamPID))
+		return;
+
+	// Link to the install directory of the running client
+	snprintf(szPath, sizeof(szPath), "%s/.steam/steam", pszHome);
+
+	if (realpath(szPath, szInstallPath) && strlen(szInstallPath) < sizeof(pPaths->m_szInstallPath))
+		strcpy(pPaths->m_szInstallPath, szInstallPath);
+#endif
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Returns true if both snapshots point to the same client
+//-----------------------------------------------------------------------------
+static bool ClientPathsEqual(const SteamClientPaths_t *pPaths, const SteamClientPaths_t *pOther)
+{
+	return !strcmp(pPaths->m_szClientModulePath, pOther->m_szClientModulePath) &&
+		!strcmp(pPaths->m_szClientDirectory, pOther->m_szClientDirectory) &&
+		!strcmp(pPaths->m_szInstallPath, pOther->m_szInstallPath) &&
+		pPaths->m_unSteamPID == pOther->m_unSteamPID &&
+		pPaths->m_bClientModuleFound == pOther->m_bClientModuleFound;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Returns where the steam client lives. Resolved by the first caller,
+//			everyone else gets the same snapshot until it's invalidated.
+//-----------------------------------------------------------------------------
+const SteamClientPaths_t* Steam_GetClientPaths()
+{
+	SteamClientPaths_t*	pPaths;
+	SteamClientPaths_t	Resolved;
+
+	pPaths = s_pClientPaths.load(std::memory_order_acquire);
+	if (pPaths && !s_bClientPathsStale.load(std::memory_order_acquire))
+		return pPaths;
+
+	std::lock_guard<std::mutex> Lock(s_ClientPathsLock);
+
+	// Somebody resolved it while we were waiting
+	pPaths = s_pClientPaths.load(std::memory_order_acquire);
+	if (pPaths && !s_bClientPathsStale.load(std::memory_order_acquire))
+		return pPaths;
+
+	memset(&Resolved, 0, sizeof(Resolved));
+	Sys_ResolveClientPaths(&Resolved);
+
+	s_bClientPathsStale.store(false, std::memory_order_release);
+
+	// Invalidated but nothing moved, the usual case while polling for the client
+	if (pPaths && ClientPathsEqual(pPaths, &Resolved))
+		return pPaths;
+
+	pPaths = new SteamClientPaths_t(Resolved);
+
+	s_pClientPaths.store(pPaths, std::memory_order_release);
+	return pPaths;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Makes the next Steam_GetClientPaths() resolve everything again, 
+//			e.g. after the client was started or restarted.
+//-----------------------------------------------------------------------------
+void Steam_InvalidateClientPaths()
+{
+	std::lock_guard<std::mutex> Lock(s_ClientPathsLock);
+
+	s_bClientPathsStale.store(true, std::memory_order_release);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Setups full directory to the steam client. The path is stored inside
+//			g_szSteamClientPath[] global variable.
+// 
+// Note:	Returns true if the path belongs to a client that's installed, not
+//			just to a module that happens to be loaded.
+//-----------------------------------------------------------------------------
+bool ConfigureSteamClientPath(const char *pszPath, uint32 u32Length)
+{
+	const SteamClientPaths_t* pPaths;
+
+	pPaths = Steam_GetClientPaths();
+
 	if (pszPath)
-		strncpy((char *)pszPath, szClientPath, u32Length);
+		strncpy((char *)pszPath, pPaths->m_szClientModulePath, u32Length);
 
 	// Copy over to global buffer
-	strncpy(g_szSteamClientPath, szClientPath, sizeof(szClientPath));
+	if (strcmp(g_szSteamClientPath, pPaths->m_szClientDirectory))
+		strncpy(g_szSteamClientPath, pPaths->m_szClientDirectory, sizeof(g_szSteamClientPath));
 
-	// Retain only directory
-	Q_StripFilename(g_szSteamClientPath);
-
-	return (bSuccess == TRUE) ? true : false;
+	return pPaths->m_bClientModuleFound;
 }
 
 //-----------------------------------------------------------------------------
@@ -205,38 +421,476 @@ void Steam_SetMinidumpSteamID(uint64 u64SteamID)
 }
 
 //-----------------------------------------------------------------------------
-// Purpose: 
+// Purpose: Reads environment variable into the buffer. Returns the length of
+//			the value, or the size the buffer would need including terminator
+//			if it's too small. Zero if the variable isn't set.
+//-----------------------------------------------------------------------------
+uint32 Steam_GetEnvironmentVariable(const char *pszName, char *pszBuffer, uint32 cubBuffer)
+{
+#ifdef _WIN32
+	return GetEnvironmentVariableA(pszName, pszBuffer, cubBuffer);
+#else
+	const char*	pszValue;
+	uint32		cchValue;
+
+	pszValue = getenv(pszName);
+	if (!pszValue)
+		return NULL;
+
+	cchValue = strlen(pszValue);
+	if (!pszBuffer || cchValue >= cubBuffer)
+		return cchValue + 1;
+
+	memcpy(pszBuffer, pszValue, cchValue + 1);
+	return cchValue;
+#endif
+}
+
+//-----------------------------------------------------------------------------
+// 
+// Module loader
+// 
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// Purpose: Module loaded through Steam_LoadModule(). Further loads of the same
+//			path are served from here without going through the system loader, 
+//			the module is freed once every load was matched by an unload.
+//-----------------------------------------------------------------------------
+struct LoadedModule_t
+{
+	char		m_szPath[MAX_PATH];
+	HMODULE		m_hModule;
+	int			m_nLoads;
+};
+
+#define MAX_LOADED_MODULES	16
+
+static LoadedModule_t	s_LoadedModules[MAX_LOADED_MODULES];
+static std::mutex		s_LoadedModulesLock;
+
+//-----------------------------------------------------------------------------
+// Purpose: Asks the system loader for the module
+//-----------------------------------------------------------------------------
+static HMODULE Sys_LoadModuleNative(const char *pModuleName)
+{
+#ifdef _WIN32
+	WCHAR	wszModuleName[MAX_PATH];
+	int		nNumChars;
+
+	// Module paths are UTF-8. Only when the path isn't valid UTF-8 or is too
+	// long to convert it's tried as an ANSI one.
+	nNumChars = MultiByteToWideChar(CP_UTF8, MB_ERR_INVALID_CHARS, pModuleName, -1, wszModuleName, Q_ARRAYSIZE(wszModuleName));
+
+	if (nNumChars != NULL)
+		return LoadLibraryExW(wszModuleName, NULL, LOAD_WITH_ALTERED_SEARCH_PATH);
+
+	return LoadLibraryExA(pModuleName, NULL, LOAD_WITH_ALTERED_SEARCH_PATH);
+#else
+	// Steamclient exports far more than we ever call, bind on first use
+	return reinterpret_cast<HMODULE>(dlopen(pModuleName, RTLD_LAZY | RTLD_LOCAL));
+#endif
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Drops one system loader reference of the module
+//-----------------------------------------------------------------------------
+static void Sys_UnloadModuleNative(HMODULE hModule)
+{
+#ifdef _WIN32
+	FreeLibrary(hModule);
+#else
+	dlclose(hModule);
+#endif
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Returns entry of the module loaded with given path, or free entry
+//			when the path is nullptr. Loaded modules lock must be held.
+//-----------------------------------------------------------------------------
+static LoadedModule_t* FindLoadedModule(const char *pModuleName)
+{
+	for (LoadedModule_t& Module : s_LoadedModules)
+	{
+		if (!pModuleName)
+		{
+			if (!Module.m_hModule)
+				return &Module;
+
+			continue;
+		}
+
+		if (Module.m_hModule && !strcmp(Module.m_szPath, pModuleName))
+			return &Module;
+	}
+
+	return nullptr;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Loads the module, or takes another reference of it if it was loaded
+//			through here with the same path already. Every successful load has
+//			to be matched by Steam_UnloadModule().
 // 
 // Note:	Originally called Sys_LoadModule(), but this would interfere with
 //			our function located in public source file interface.cpp
 //-----------------------------------------------------------------------------
 HMODULE Steam_LoadModule(const char *pModuleName)
 {
-	LPWSTR	pwszBuffer;
-	DWORD	dwWBufSize, dwNumChars;
-	HMODULE hModule;
+	LoadedModule_t*	pModule;
+	HMODULE			hModule;
+
+	{
+		std::lock_guard<std::mutex> Lock(s_LoadedModulesLock);
+
+		pModule = FindLoadedModule(pModuleName);
+		if (pModule)
+		{
+			pModule->m_nLoads++;
+			return pModule->m_hModule;
+		}
+	}
+
+	// Not under the lock, so that different modules can be loaded in parallel
+	hModule = Sys_LoadModuleNative(pModuleName);
+
+	if (!hModule)
+		return NULL;
+
+	std::lock_guard<std::mutex> Lock(s_LoadedModulesLock);
+
+	// Somebody else loaded it meanwhile, keep only their reference
+	pModule = FindLoadedModule(pModuleName);
+	if (pModule)
+	{
+		pModule->m_nLoads++;
+		Sys_UnloadModuleNative(hModule);
+		return pModule->m_hModule;
+	}
+
+	// When out of entries or the path doesn't fit, the module is still loaded
+	// but next load of it goes to the system loader again.
+	pModule = FindLoadedModule(nullptr);
+	if (pModule && strlen(pModuleName) < sizeof(pModule->m_szPath))
+	{
+		strcpy(pModule->m_szPath, pModuleName);
+		pModule->m_hModule = hModule;
+		pModule->m_nLoads = 1;
+	}
+
+	return hModule;
+}
+
+static void UnbindModuleSymbols(HMODULE hModule);
+
+//-----------------------------------------------------------------------------
+// Purpose: Drops one reference taken by Steam_LoadModule(). Modules that were
+//			not loaded through there are handed to the system loader directly.
+//-----------------------------------------------------------------------------
+void Steam_UnloadModule(HMODULE hModule)
+{
+	if (!hModule)
+		return;
+
+	{
+		std::lock_guard<std::mutex> Lock(s_LoadedModulesLock);
+
+		for (LoadedModule_t& Module : s_LoadedModules)
+		{
+			if (Module.m_hModule != hModule)
+				continue;
 
-	hModule = NULL;
+			if (--Module.m_nLoads > 0)
+				return;
 
-	dwWBufSize = strlen(pModuleName);
-	pwszBuffer = new WCHAR[(2 * dwWBufSize) + 1];
+			Module.m_hModule = NULL;
+			*Module.m_szPath = '\0';
+			break;
+		}
+	}
+
+	// Routines bound from it are going away with it
+	UnbindModuleSymbols(hModule);
+
+	Sys_UnloadModuleNative(hModule);
+}
 
-	dwNumChars = MultiByteToWideChar(CP_UTF8, NULL, pModuleName, dwWBufSize, pwszBuffer, dwWBufSize + 1);
+//-----------------------------------------------------------------------------
+// Purpose: Returns handle to the module if it's mapped into the process 
+//			already, without taking a reference of it.
+//-----------------------------------------------------------------------------
+HMODULE Steam_GetLoadedModule(const char *pModuleName)
+{
+#ifdef _WIN32
+	return GetModuleHandleA(pModuleName);
+#else
+	void* hModule;
+
+	hModule = dlopen(pModuleName, RTLD_LAZY | RTLD_NOLOAD);
+
+	// RTLD_NOLOAD takes a reference as well, give it back
+	if (hModule)
+		dlclose(hModule);
+
+	return reinterpret_cast<HMODULE>(hModule);
+#endif
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Looks up exported symbol of the module
+//-----------------------------------------------------------------------------
+void* Steam_GetProcAddress(HMODULE hModule, const char *pszProcName)
+{
+#ifdef _WIN32
+	return reinterpret_cast<void*>(GetProcAddress(hModule, pszProcName));
+#else
+	return dlsym(hModule, pszProcName);
+#endif
+}
+
+#ifndef _WIN32
+struct ModuleImage_t
+{
+	struct link_map*	m_pLinkMap;
+	uint64				m_cubImage;
+};
+
+//-----------------------------------------------------------------------------
+// Purpose: dl_iterate_phdr() callback, sums loadable segments of the module 
+//			whose link map is passed in.
+//-----------------------------------------------------------------------------
+static int SumModuleSegments(struct dl_phdr_info *pInfo, size_t cubInfo, void *pvImage)
+{
+	ModuleImage_t* pImage;
 
-	if (dwNumChars != NULL)
+	pImage = reinterpret_cast<ModuleImage_t*>(pvImage);
+
+	if (pInfo->dlpi_addr != pImage->m_pLinkMap->l_addr || strcmp(pInfo->dlpi_name, pImage->m_pLinkMap->l_name))
+		return 0;
+
+	for (int i = 0; i < pInfo->dlpi_phnum; i++)
 	{
-		if (dwNumChars < dwWBufSize - 1)
-			dwWBufSize = dwNumChars;
+		if (pInfo->dlpi_phdr[i].p_type == PT_LOAD)
+			pImage->m_cubImage += pInfo->dlpi_phdr[i].p_memsz;
+	}
+
+	return 1;
+}
+#endif
+
+//-----------------------------------------------------------------------------
+// Purpose: Returns how much address space the module is mapped into, zero if
+//			it can't be told.
+//-----------------------------------------------------------------------------
+uint64 Steam_GetModuleImageSize(HMODULE hModule)
+{
+	if (!hModule)
+		return 0;
+
+#ifdef _WIN32
+	PIMAGE_DOS_HEADER	pDosHeader;
+	PIMAGE_NT_HEADERS	pNtHeaders;
+
+	// Module handle is the base address the image is mapped at
+	pDosHeader = reinterpret_cast<PIMAGE_DOS_HEADER>(hModule);
+
+	if (pDosHeader->e_magic != IMAGE_DOS_SIGNATURE)
+		return 0;
+
+	pNtHeaders = reinterpret_cast<PIMAGE_NT_HEADERS>(reinterpret_cast<uint8*>(hModule) + pDosHeader->e_lfanew);
+
+	if (pNtHeaders->Signature != IMAGE_NT_SIGNATURE)
+		return 0;
+
+	return pNtHeaders->OptionalHeader.SizeOfImage;
+#else
+	ModuleImage_t Image = {};
+
+	if (dlinfo(hModule, RTLD_DI_LINKMAP, &Image.m_pLinkMap) != 0)
+		return 0;
+
+	dl_iterate_phdr(SumModuleSegments, &Image);
 
-		pwszBuffer[dwWBufSize] = '\0';
+	return Image.m_cubImage;
+#endif
+}
+
+//-----------------------------------------------------------------------------
+// 
+// Symbol binder
+// 
+//-----------------------------------------------------------------------------
+
+#define MAX_SYMBOL_TABLES	8
+
+// Tables that were bound at least once, for Steam_GetSymbolBindings()
+static SteamSymbolTable_t*	s_pSymbolTables[MAX_SYMBOL_TABLES];
+static int					s_cSymbolTables = 0;
+static std::mutex			s_SymbolTablesLock;
+
+//-----------------------------------------------------------------------------
+// Purpose: Clears routines of the table. Symbol tables lock must be held.
+//-----------------------------------------------------------------------------
+static void UnbindSymbolsLocked(SteamSymbolTable_t *pTable)
+{
+	pTable->m_hBoundModule.store(NULL, std::memory_order_release);
 
-		hModule = LoadLibraryExW(pwszBuffer, NULL, LOAD_WITH_ALTERED_SEARCH_PATH);
+	for (int i = 0; i < pTable->m_cSymbols; i++)
+	{
+		*pTable->m_pSymbols[i].m_ppfnRoutine = nullptr;
+		pTable->m_pSymbols[i].m_pszBoundName = nullptr;
 	}
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Looks up every routine of the table from the module. Done only once
+//			per module, binding the same module again returns right away.
+//			Returns false when there's no module to bind to.
+//-----------------------------------------------------------------------------
+bool Steam_BindSymbols(SteamSymbolTable_t *pTable, HMODULE hModule)
+{
+	SteamSymbol_t*	pSymbol;
+	void*			pfnRoutine;
 
-	// Try ascii
 	if (!hModule)
-		hModule = LoadLibraryExA(pModuleName, NULL, LOAD_WITH_ALTERED_SEARCH_PATH);
+		return false;
 
-	delete[] pwszBuffer;
-	return hModule;
-}
\ No newline at end of file
+	if (pTable->m_hBoundModule.load(std::memory_order_acquire) == hModule)
+		return true;
+
+	std::lock_guard<std::mutex> Lock(s_SymbolTablesLock);
+
+	// Somebody bound it while we were waiting
+	if (pTable->m_hBoundModule.load(std::memory_order_relaxed) == hModule)
+		return true;
+
+	// Readers must not see routines of two different modules mixed up
+	UnbindSymbolsLocked(pTable);
+
+	for (int i = 0; i < pTable->m_cSymbols; i++)
+	{
+		pSymbol = &pTable->m_pSymbols[i];
+
+		pfnRoutine = Steam_GetProcAddress(hModule, pSymbol->m_pszName);
+
+		if (pfnRoutine)
+		{
+			*pSymbol->m_ppfnRoutine = pfnRoutine;
+			pSymbol->m_pszBoundName = pSymbol->m_pszName;
+		}
+	}
+
+	if (!pTable->m_bRegistered && s_cSymbolTables < MAX_SYMBOL_TABLES)
+	{
+		s_pSymbolTables[s_cSymbolTables++] = pTable;
+		pTable->m_bRegistered = true;
+	}
+
+	pTable->m_hBoundModule.store(hModule, std::memory_order_release);
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Clears routines of the table, next Steam_BindSymbols() looks them 
+//			up again.
+//-----------------------------------------------------------------------------
+void Steam_UnbindSymbols(SteamSymbolTable_t *pTable)
+{
+	std::lock_guard<std::mutex> Lock(s_SymbolTablesLock);
+
+	UnbindSymbolsLocked(pTable);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Returns true if routines of the table were looked up already
+//-----------------------------------------------------------------------------
+bool Steam_IsSymbolTableBound(const SteamSymbolTable_t *pTable)
+{
+	return pTable->m_hBoundModule.load(std::memory_order_acquire) != NULL;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Unbinds all tables bound to the module that is being unloaded
+//-----------------------------------------------------------------------------
+static void UnbindModuleSymbols(HMODULE hModule)
+{
+	std::lock_guard<std::mutex> Lock(s_SymbolTablesLock);
+
+	for (int i = 0; i < s_cSymbolTables; i++)
+	{
+		if (s_pSymbolTables[i]->m_hBoundModule.load(std::memory_order_relaxed) == hModule)
+			UnbindSymbolsLocked(s_pSymbolTables[i]);
+	}
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Fills up to cMaxBindings entries, one per symbol of every table that
+//			was bound, and returns how many there are.
+//-----------------------------------------------------------------------------
+int Steam_GetSymbolBindings(SteamSymbolBinding_t *pBindings, int cMaxBindings)
+{
+	SteamSymbolTable_t*	pTable;
+	int					cBindings;
+
+	std::lock_guard<std::mutex> Lock(s_SymbolTablesLock);
+
+	cBindings = 0;
+
+	for (int i = 0; i < s_cSymbolTables; i++)
+	{
+		pTable = s_pSymbolTables[i];
+
+		for (int iSymbol = 0; iSymbol < pTable->m_cSymbols; iSymbol++, cBindings++)
+		{
+			if (!pBindings || cBindings >= cMaxBindings)
+				continue;
+
+			pBindings[cBindings].m_pszModule = pTable->m_pszModuleName;
+			pBindings[cBindings].m_pszSymbol = pTable->m_pSymbols[iSymbol].m_pszName;
+			pBindings[cBindings].m_pszBoundName = pTable->m_pSymbols[iSymbol].m_pszBoundName;
+		}
+	}
+
+	return cBindings;
+}
+
+//-----------------------------------------------------------------------------
+// 
+// Module preloader
+// 
+//-----------------------------------------------------------------------------
+
+#define MAX_PRELOAD_WORKERS	4
+
+// Workers running preload tasks, only touched by the thread initializing
+static std::thread s_PreloadWorkers[MAX_PRELOAD_WORKERS];
+
+//-----------------------------------------------------------------------------
+// Purpose: Runs the task on a worker thread. When every worker is busy the
+//			task is run right away on the calling thread.
+//-----------------------------------------------------------------------------
+void Steam_StartPreload(void (*pfnTask)())
+{
+	for (std::thread& Worker : s_PreloadWorkers)
+	{
+		if (Worker.joinable())
+			continue;
+
+		Worker = std::thread(pfnTask);
+		return;
+	}
+
+	pfnTask();
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Waits for all tasks started by Steam_StartPreload()
+//-----------------------------------------------------------------------------
+void Steam_JoinPreloads()
+{
+	for (std::thread& Worker : s_PreloadWorkers)
+	{
+		if (Worker.joinable())
+			Worker.join();
+	}
+}
@@ -8,6 +8,8 @@
 #define CLIENT_MODULES_H
 #pragma once
 
+#include <atomic>
+
 //-----------------------------------------------------------------------------
 // Purpose: Data structure to load the module set when globally initializing
 //			object of this type.
@@ -26,6 +28,18 @@ public:
 extern CModuleLoadWrapper g_MiniDumpSteamDllModule;
 extern CModuleLoadWrapper g_MiniDumpSteamClientDllModule;
 
+//-----------------------------------------------------------------------------
+// Purpose: Where the steam client lives, see Steam_GetClientPaths()
+//-----------------------------------------------------------------------------
+struct SteamClientPaths_t
+{
+	char	m_szClientModulePath[MAX_PATH];	// Full path to steamclient module
+	char	m_szClientDirectory[MAX_PATH];	// Same, without filename
+	char	m_szInstallPath[MAX_PATH];		// Set only if the client was running
+	uint32	m_unSteamPID;					// Client process, zero if unknown
+	bool	m_bClientModuleFound;			// Path belongs to an installed client
+};
+
 //-----------------------------------------------------------------------------
 // 
 // Steam API module code
@@ -33,10 +47,73 @@ extern CModuleLoadWrapper g_MiniDumpSteamClientDllModule;
 //-----------------------------------------------------------------------------
 
 extern uint32 GetSteamAppID(const char *szSteamAppID);
+#ifdef _WIN32
 extern HKEY RegistryKeyByName(const char* pszName);
 extern BOOL GetRegistryValue(LPCSTR lpSubKey, LPCSTR lpValueName, LPBYTE lpData, DWORD cbData);
+#endif
 extern bool ConfigureSteamClientPath(const char *pszPath, uint32 u32Length);
+extern const SteamClientPaths_t* Steam_GetClientPaths();
+extern void Steam_InvalidateClientPaths();
+extern bool Steam_IsProcessRunning(uint32 unPID);
+extern uint32 Steam_ReadActiveSteamPID();
 extern void Steam_SetMinidumpSteamID(uint64 u64SteamID);
+extern uint32 Steam_GetEnvironmentVariable(const char *pszName, char *pszBuffer, uint32 cubBuffer);
+
+//-----------------------------------------------------------------------------
+// 
+// Module loader, LoadLibrary on windows and dlopen elsewhere
+// 
+//-----------------------------------------------------------------------------
+
 extern HMODULE Steam_LoadModule(const char *pModuleName);
+extern void Steam_UnloadModule(HMODULE hModule);
+extern HMODULE Steam_GetLoadedModule(const char *pModuleName);
+extern void* Steam_GetProcAddress(HMODULE hModule, const char *pszProcName);
+extern uint64 Steam_GetModuleImageSize(HMODULE hModule);
+
+//-----------------------------------------------------------------------------
+// 
+// Symbol binder
+// 
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// Purpose: Routine looked up by Steam_BindSymbols()
+//-----------------------------------------------------------------------------
+struct SteamSymbol_t
+{
+	const char*		m_pszName;
+	void**			m_ppfnRoutine;		// Set to the routine, nullptr if missing
+	const char*		m_pszBoundName;		// Same as the name once found, set by binder
+};
+
+//-----------------------------------------------------------------------------
+// Purpose: All routines looked up from one module. Bound once for the module,
+//			readers check Steam_IsSymbolTableBound() before using the routines.
+//-----------------------------------------------------------------------------
+struct SteamSymbolTable_t
+{
+	const char*				m_pszModuleName;
+	SteamSymbol_t*			m_pSymbols;
+	int						m_cSymbols;
+
+	// Module the routines belong to, published once all of them are stored
+	std::atomic<HMODULE>	m_hBoundModule;
+	bool					m_bRegistered;
+};
+
+extern bool Steam_BindSymbols(SteamSymbolTable_t *pTable, HMODULE hModule);
+extern void Steam_UnbindSymbols(SteamSymbolTable_t *pTable);
+extern bool Steam_IsSymbolTableBound(const SteamSymbolTable_t *pTable);
+extern int Steam_GetSymbolBindings(SteamSymbolBinding_t *pBindings, int cMaxBindings);
+
+//-----------------------------------------------------------------------------
+// 
+// Module preloader, loads modules on worker threads during initialization
+// 
+//-----------------------------------------------------------------------------
+
+extern void Steam_StartPreload(void (*pfnTask)());
+extern void Steam_JoinPreloads();
 
 #endif
\ No newline at end of file
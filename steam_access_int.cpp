@@ -7,6 +7,9 @@
 
 #include "steam_api_pch.h"
 
+#include <atomic>
+#include <mutex>
+
 //-----------------------------------------------------------------------------
 // Purpose: SteamAPI access interfaces
 //-----------------------------------------------------------------------------
@@ -40,12 +43,363 @@ ISteamHTTP*					g_pSteamGameServerHTTP;
 HSteamPipe					g_hSteamGameServerPipe;
 HSteamUser					g_hSteamGameServerUser;
 
+//-----------------------------------------------------------------------------
+// 
+// Interface cache
+// 
+//-----------------------------------------------------------------------------
+
+#define MAX_INTERNED_VERSIONS		64
+#define MAX_INTERFACE_VERSION		64
+#define MAX_CACHED_INTERFACES		64
+
+// Version names are compared once when interned, entries then compare pointers
+static char					s_rgszInternedVersions[MAX_INTERNED_VERSIONS][MAX_INTERFACE_VERSION];
+static int					s_cInternedVersions = 0;
+
+struct CachedInterface_t
+{
+	ESteamInterface	m_eInterface;
+	const char*		m_pszVersion;		// Interned
+	HSteamUser		m_hSteamUser;
+	HSteamPipe		m_hSteamPipe;
+	void*			m_pInterface;
+};
+
+static CachedInterface_t	s_rgCachedInterfaces[MAX_CACHED_INTERFACES];
+static int					s_cCachedInterfaces = 0;
+static std::mutex			s_InterfaceCacheLock;
+
+//-----------------------------------------------------------------------------
+// Purpose: Returns the one copy of the version name kept by the cache, nullptr
+//			when there's no room for it. Interface cache lock must be held.
+//-----------------------------------------------------------------------------
+static const char* InternInterfaceVersion(const char *pchVersion)
+{
+	for (int i = 0; i < s_cInternedVersions; i++)
+	{
+		if (!strcmp(s_rgszInternedVersions[i], pchVersion))
+			return s_rgszInternedVersions[i];
+	}
+
+	if (s_cInternedVersions >= MAX_INTERNED_VERSIONS || strlen(pchVersion) >= MAX_INTERFACE_VERSION)
+		return nullptr;
+
+	strcpy(s_rgszInternedVersions[s_cInternedVersions], pchVersion);
+	return s_rgszInternedVersions[s_cInternedVersions++];
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Asks steamclient for the interface. The cache keeps it as it is,
+//			see TraceInterface().
+//-----------------------------------------------------------------------------
+static void* FetchInterface(ESteamInterface eInterface, HSteamUser hSteamUser, HSteamPipe hSteamPipe, const char *pchVersion)
+{
+	switch (eInterface)
+	{
+		case k_ESteamInterfaceUser:					return g_pSteamClient->GetISteamUser(hSteamUser, hSteamPipe, pchVersion);
+		case k_ESteamInterfaceFriends:				return g_pSteamClient->GetISteamFriends(hSteamUser, hSteamPipe, pchVersion);
+		case k_ESteamInterfaceUtils:				return g_pSteamClient->GetISteamUtils(hSteamPipe, pchVersion);
+		case k_ESteamInterfaceMatchmaking:			return g_pSteamClient->GetISteamMatchmaking(hSteamUser, hSteamPipe, pchVersion);
+		case k_ESteamInterfaceMatchmakingServers:	return g_pSteamClient->GetISteamMatchmakingServers(hSteamUser, hSteamPipe, pchVersion);
+		case k_ESteamInterfaceUserStats:			return g_pSteamClient->GetISteamUserStats(hSteamUser, hSteamPipe, pchVersion);
+		case k_ESteamInterfaceApps:					return g_pSteamClient->GetISteamApps(hSteamUser, hSteamPipe, pchVersion);
+		case k_ESteamInterfaceNetworking:			return g_pSteamClient->GetISteamNetworking(hSteamUser, hSteamPipe, pchVersion);
+		case k_ESteamInterfaceRemoteStorage:		return g_pSteamClient->GetISteamRemoteStorage(hSteamUser, hSteamPipe, pchVersion);
+		case k_ESteamInterfaceScreenshots:			return g_pSteamClient->GetISteamScreenshots(hSteamUser, hSteamPipe, pchVersion);
+		case k_ESteamInterfaceHTTP:					return g_pSteamClient->GetISteamHTTP(hSteamUser, hSteamPipe, pchVersion);
+	}
+
+	return nullptr;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Wraps interface handed out by the cache into trace proxy if the IPC
+//			tracing is on. Done on every lookup rather than when the cache is 
+//			filled, so turning tracing on or off applies to cached ones too.
+//			The accessors wrap what they return again, the slots may hold an
+//			interface fetched while tracing was in the other state.
+//-----------------------------------------------------------------------------
+static void* TraceInterface(ESteamInterface eInterface, void *pInterface)
+{
+	switch (eInterface)
+	{
+		case k_ESteamInterfaceUser:					return Steam_TraceInterface(static_cast<ISteamUser*>(pInterface));
+		case k_ESteamInterfaceFriends:				return Steam_TraceInterface(static_cast<ISteamFriends*>(pInterface));
+		case k_ESteamInterfaceUtils:				return Steam_TraceInterface(static_cast<ISteamUtils*>(pInterface));
+		case k_ESteamInterfaceMatchmaking:			return Steam_TraceInterface(static_cast<ISteamMatchmaking*>(pInterface));
+		case k_ESteamInterfaceMatchmakingServers:	return Steam_TraceInterface(static_cast<ISteamMatchmakingServers*>(pInterface));
+		case k_ESteamInterfaceUserStats:			return Steam_TraceInterface(static_cast<ISteamUserStats*>(pInterface));
+		case k_ESteamInterfaceApps:					return Steam_TraceInterface(static_cast<ISteamApps*>(pInterface));
+		case k_ESteamInterfaceNetworking:			return Steam_TraceInterface(static_cast<ISteamNetworking*>(pInterface));
+		case k_ESteamInterfaceRemoteStorage:		return Steam_TraceInterface(static_cast<ISteamRemoteStorage*>(pInterface));
+		case k_ESteamInterfaceScreenshots:			return Steam_TraceInterface(static_cast<ISteamScreenshots*>(pInterface));
+		case k_ESteamInterfaceHTTP:					return Steam_TraceInterface(static_cast<ISteamHTTP*>(pInterface));
+	}
+
+	return pInterface;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Returns the interface from the cache, fetching it from steamclient
+//			the first time this version is asked for on the pipe.
+//-----------------------------------------------------------------------------
+void* SteamAPI_GetCachedInterface(ESteamInterface eInterface, HSteamUser hSteamUser, HSteamPipe hSteamPipe, const char *pchVersion)
+{
+	CachedInterface_t*	pEntry;
+	const char*			pszVersion;
+	void*				pInterface;
+
+	if (!g_pSteamClient || !pchVersion)
+		return nullptr;
+
+	// Utilities are per pipe
+	if (eInterface == k_ESteamInterfaceUtils)
+		hSteamUser = 0;
+
+	std::lock_guard<std::mutex> Lock(s_InterfaceCacheLock);
+
+	pszVersion = InternInterfaceVersion(pchVersion);
+
+	// Out of room, still hand it out
+	if (!pszVersion)
+		return TraceInterface(eInterface, FetchInterface(eInterface, hSteamUser, hSteamPipe, pchVersion));
+
+	for (int i = 0; i < s_cCachedInterfaces; i++)
+	{
+		pEntry = &s_rgCachedInterfaces[i];
+
+		if (pEntry->m_eInterface == eInterface && pEntry->m_pszVersion == pszVersion &&
+			pEntry->m_hSteamUser == hSteamUser && pEntry->m_hSteamPipe == hSteamPipe)
+			return TraceInterface(eInterface, pEntry->m_pInterface);
+	}
+
+	pInterface = FetchInterface(eInterface, hSteamUser, hSteamPipe, pszVersion);
+
+	// Missing versions are asked for again, steamclient might not be ready yet
+	if (pInterface && s_cCachedInterfaces < MAX_CACHED_INTERFACES)
+	{
+		pEntry = &s_rgCachedInterfaces[s_cCachedInterfaces++];
+
+		pEntry->m_eInterface = eInterface;
+		pEntry->m_pszVersion = pszVersion;
+		pEntry->m_hSteamUser = hSteamUser;
+		pEntry->m_hSteamPipe = hSteamPipe;
+		pEntry->m_pInterface = pInterface;
+	}
+
+	return TraceInterface(eInterface, pInterface);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Forgets cached interfaces, called when the pipe is released. The 
+//			interned version names are kept.
+//-----------------------------------------------------------------------------
+void Steam_ClearInterfaceCache()
+{
+	std::lock_guard<std::mutex> Lock(s_InterfaceCacheLock);
+
+	s_cCachedInterfaces = 0;
+}
+
+//-----------------------------------------------------------------------------
+// 
+// Getter cache
+// 
+//-----------------------------------------------------------------------------
+
+struct GetterCache_t
+{
+	// Bumped by every invalidation, fetches that started before it are dropped
+	uint32					m_nGeneration;
+	std::atomic<uint32>		m_nValidMask;
+	std::atomic<uint64>		m_rgulValues[k_ESteamGetterMax];
+};
+
+static std::atomic<bool>	s_bGetterCacheEnabled(false);
+static GetterCache_t		s_rgGetterCaches[2];		// User, game server
+static std::mutex			s_GetterCacheLock;
+
+//-----------------------------------------------------------------------------
+// Purpose: Returns true if getters should be memoized
+//-----------------------------------------------------------------------------
+bool Steam_IsGetterCacheEnabled()
+{
+	return s_bGetterCacheEnabled.load(std::memory_order_relaxed);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Returns the remembered value, or fetches and remembers it. Fetch is
+//			done without holding the lock, it's a round-trip to steamclient.
+//-----------------------------------------------------------------------------
+uint64 Steam_GetMemoizedValue(bool bGameServer, ESteamGetterValue eValue, uint64 (*pfnFetch)())
+{
+	GetterCache_t*	pCache;
+	uint32			nGeneration;
+	uint64			ulValue;
+
+	if (!Steam_IsGetterCacheEnabled())
+		return pfnFetch();
+
+	pCache = &s_rgGetterCaches[bGameServer ? 1 : 0];
+
+	if (pCache->m_nValidMask.load(std::memory_order_acquire) & (1 << eValue))
+		return pCache->m_rgulValues[eValue].load(std::memory_order_relaxed);
+
+	{
+		std::lock_guard<std::mutex> Lock(s_GetterCacheLock);
+
+		nGeneration = pCache->m_nGeneration;
+	}
+
+	ulValue = pfnFetch();
+
+	std::lock_guard<std::mutex> Lock(s_GetterCacheLock);
+
+	// Invalidated meanwhile, the value may be stale already
+	if (pCache->m_nGeneration != nGeneration || (pCache->m_nValidMask.load(std::memory_order_relaxed) & (1 << eValue)))
+		return ulValue;
+
+	pCache->m_rgulValues[eValue].store(ulValue, std::memory_order_relaxed);
+	pCache->m_nValidMask.fetch_or(1 << eValue, std::memory_order_release);
+
+	return ulValue;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Forgets values of the user or game server pipe
+//-----------------------------------------------------------------------------
+void Steam_InvalidateGetterCache(bool bGameServer)
+{
+	GetterCache_t* pCache;
+
+	pCache = &s_rgGetterCaches[bGameServer ? 1 : 0];
+
+	std::lock_guard<std::mutex> Lock(s_GetterCacheLock);
+
+	pCache->m_nGeneration++;
+	pCache->m_nValidMask.store(0, std::memory_order_release);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Turns memoization of getters on or off
+//-----------------------------------------------------------------------------
+void SteamAPI_SetGetterCacheEnabled(bool bEnabled)
+{
+	Steam_InvalidateGetterCache(false);
+	Steam_InvalidateGetterCache(true);
+
+	s_bGetterCacheEnabled.store(bEnabled, std::memory_order_relaxed);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Returns app id of the user pipe
+//-----------------------------------------------------------------------------
+uint32 SteamAPI_GetAppID()
+{
+	if (!SteamUtils())
+		return k_uAppIdInvalid;
+
+	return static_cast<uint32>(Steam_GetMemoizedValue(false, k_ESteamGetterAppID, [] () -> uint64 { return SteamUtils()->GetAppID(); }));
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Returns steam id of the logged on user
+//-----------------------------------------------------------------------------
+uint64 SteamAPI_GetSteamID()
+{
+	if (!SteamUser())
+		return NULL;
+
+	return Steam_GetMemoizedValue(false, k_ESteamGetterSteamID, [] () -> uint64 { return SteamUser()->GetSteamID().ConvertToUint64(); });
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Returns true if the user is logged on to steam servers
+//-----------------------------------------------------------------------------
+bool SteamAPI_BLoggedOn()
+{
+	if (!SteamUser())
+		return false;
+
+	return Steam_GetMemoizedValue(false, k_ESteamGetterLoggedOn, [] () -> uint64 { return SteamUser()->BLoggedOn(); }) != 0;
+}
+
 //-----------------------------------------------------------------------------
 // 
 // SteamAPI access routines
 // 
 //-----------------------------------------------------------------------------
 
+//-----------------------------------------------------------------------------
+// Purpose: Returns interface stored in the slot. With lazy interfaces it's 
+//			fetched on first use, threads racing to do so get the same one
+//			since steamclient hands out one interface per pipe and version.
+//-----------------------------------------------------------------------------
+template <typename T, typename FnGetInterface>
+static T* GetLazyInterface(T*& pSlot, FnGetInterface pfnGetInterface)
+{
+	std::atomic_ref<T*>	Slot(pSlot);
+	T*					pInterface;
+	T*					pExpected;
+
+	pInterface = Slot.load(std::memory_order_acquire);
+
+	if (pInterface || !(g_unSteamAPIInitFlags & k_ESteamAPIInitLazyInterfaces) || !g_pSteamClient)
+		return pInterface;
+
+	pInterface = pfnGetInterface();
+	if (!pInterface)
+		return nullptr;
+
+	pExpected = nullptr;
+	if (!Slot.compare_exchange_strong(pExpected, pInterface, std::memory_order_acq_rel))
+		return pExpected;
+
+	return pInterface;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Stores interface into the slot, pairs with GetLazyInterface()
+//-----------------------------------------------------------------------------
+template <typename T>
+static void SetInterfaceSlot(T*& pSlot, T* pInterface)
+{
+	std::atomic_ref<T*>(pSlot).store(pInterface, std::memory_order_release);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Publishes interfaces of the context into g_SteamAPIContext, clears
+//			it if pContext is nullptr. 
+// Note:	Accessors read the slots atomically while this may run on another
+//			thread, so the global context is never written through the inline 
+//			CSteamAPIContext::Init() or Clear(), those fill a local copy.
+//-----------------------------------------------------------------------------
+void Steam_SetGlobalAPIContext(const CSteamAPIContext *pContext)
+{
+	CSteamAPIContext Context;
+
+	Context.Clear();
+
+	if (pContext)
+		Context = *pContext;
+
+	SetInterfaceSlot(g_SteamAPIContext.m_pSteamUser, Context.m_pSteamUser);
+	SetInterfaceSlot(g_SteamAPIContext.m_pSteamFriends, Context.m_pSteamFriends);
+	SetInterfaceSlot(g_SteamAPIContext.m_pSteamUtils, Context.m_pSteamUtils);
+	SetInterfaceSlot(g_SteamAPIContext.m_pSteamMatchmaking, Context.m_pSteamMatchmaking);
+	SetInterfaceSlot(g_SteamAPIContext.m_pSteamUserStats, Context.m_pSteamUserStats);
+	SetInterfaceSlot(g_SteamAPIContext.m_pSteamApps, Context.m_pSteamApps);
+	SetInterfaceSlot(g_SteamAPIContext.m_pSteamMatchmakingServers, Context.m_pSteamMatchmakingServers);
+	SetInterfaceSlot(g_SteamAPIContext.m_pSteamNetworking, Context.m_pSteamNetworking);
+	SetInterfaceSlot(g_SteamAPIContext.m_pSteamRemoteStorage, Context.m_pSteamRemoteStorage);
+	SetInterfaceSlot(g_SteamAPIContext.m_pSteamScreenshots, Context.m_pSteamScreenshots);
+	SetInterfaceSlot(g_SteamAPIContext.m_pSteamHTTP, Context.m_pSteamHTTP);
+#ifdef _PS3
+	SetInterfaceSlot(g_SteamAPIContext.m_pSteamPS3OverlayRender, pContext ? Context.m_pSteamPS3OverlayRender : nullptr);
+#endif
+}
+
 //-----------------------------------------------------------------------------
 // Purpose: Accessor to steam client API.
 //-----------------------------------------------------------------------------
@@ -59,7 +413,7 @@ ISteamClient* SteamClient()
 //-----------------------------------------------------------------------------
 ISteamUser* SteamUser()
 {
-	return g_SteamAPIContext.m_pSteamUser;
+	return Steam_TraceInterface(GetLazyInterface(g_SteamAPIContext.m_pSteamUser, [] { return static_cast<ISteamUser*>(SteamAPI_GetCachedInterface(k_ESteamInterfaceUser, g_hSteamUser, g_hSteamPipe, STEAMUSER_INTERFACE_VERSION)); }));
 }
 
 //-----------------------------------------------------------------------------
@@ -67,7 +421,7 @@ ISteamUser* SteamUser()
 //-----------------------------------------------------------------------------
 ISteamFriends* SteamFriends()
 {
-	return g_SteamAPIContext.m_pSteamFriends;
+	return Steam_TraceInterface(GetLazyInterface(g_SteamAPIContext.m_pSteamFriends, [] { return static_cast<ISteamFriends*>(SteamAPI_GetCachedInterface(k_ESteamInterfaceFriends, g_hSteamUser, g_hSteamPipe, STEAMFRIENDS_INTERFACE_VERSION)); }));
 }
 
 //-----------------------------------------------------------------------------
@@ -75,7 +429,7 @@ ISteamFriends* SteamFriends()
 //-----------------------------------------------------------------------------
 ISteamUtils* SteamUtils()
 {
-	return g_SteamAPIContext.m_pSteamUtils;
+	return Steam_TraceInterface(GetLazyInterface(g_SteamAPIContext.m_pSteamUtils, [] { return static_cast<ISteamUtils*>(SteamAPI_GetCachedInterface(k_ESteamInterfaceUtils, g_hSteamUser, g_hSteamPipe, STEAMUTILS_INTERFACE_VERSION)); }));
 }
 
 //-----------------------------------------------------------------------------
@@ -83,7 +437,7 @@ ISteamUtils* SteamUtils()
 //-----------------------------------------------------------------------------
 ISteamMatchmaking* SteamMatchmaking()
 {
-	return g_SteamAPIContext.m_pSteamMatchmaking;
+	return Steam_TraceInterface(GetLazyInterface(g_SteamAPIContext.m_pSteamMatchmaking, [] { return static_cast<ISteamMatchmaking*>(SteamAPI_GetCachedInterface(k_ESteamInterfaceMatchmaking, g_hSteamUser, g_hSteamPipe, STEAMMATCHMAKING_INTERFACE_VERSION)); }));
 }
 
 //-----------------------------------------------------------------------------
@@ -91,7 +445,7 @@ ISteamMatchmaking* SteamMatchmaking()
 //-----------------------------------------------------------------------------
 ISteamMatchmakingServers* SteamMatchmakingServers()
 {
-	return g_SteamAPIContext.m_pSteamMatchmakingServers;
+	return Steam_TraceInterface(GetLazyInterface(g_SteamAPIContext.m_pSteamMatchmakingServers, [] { return static_cast<ISteamMatchmakingServers*>(SteamAPI_GetCachedInterface(k_ESteamInterfaceMatchmakingServers, g_hSteamUser, g_hSteamPipe, STEAMMATCHMAKINGSERVERS_INTERFACE_VERSION)); }));
 }
 
 //-----------------------------------------------------------------------------
@@ -99,7 +453,7 @@ ISteamMatchmakingServers* SteamMatchmakingServers()
 //-----------------------------------------------------------------------------
 ISteamUserStats* SteamUserStats()
 {
-	return g_SteamAPIContext.m_pSteamUserStats;
+	return Steam_TraceInterface(GetLazyInterface(g_SteamAPIContext.m_pSteamUserStats, [] { return static_cast<ISteamUserStats*>(SteamAPI_GetCachedInterface(k_ESteamInterfaceUserStats, g_hSteamUser, g_hSteamPipe, STEAMUSERSTATS_INTERFACE_VERSION)); }));
 }
 
 //-----------------------------------------------------------------------------
@@ -107,7 +461,7 @@ ISteamUserStats* SteamUserStats()
 //-----------------------------------------------------------------------------
 ISteamApps* SteamApps()
 {
-	return g_SteamAPIContext.m_pSteamApps;
+	return Steam_TraceInterface(GetLazyInterface(g_SteamAPIContext.m_pSteamApps, [] { return static_cast<ISteamApps*>(SteamAPI_GetCachedInterface(k_ESteamInterfaceApps, g_hSteamUser, g_hSteamPipe, STEAMAPPS_INTERFACE_VERSION)); }));
 }
 
 //-----------------------------------------------------------------------------
@@ -115,7 +469,7 @@ ISteamApps* SteamApps()
 //-----------------------------------------------------------------------------
 ISteamNetworking* SteamNetworking()
 {
-	return g_SteamAPIContext.m_pSteamNetworking;
+	return Steam_TraceInterface(GetLazyInterface(g_SteamAPIContext.m_pSteamNetworking, [] { return static_cast<ISteamNetworking*>(SteamAPI_GetCachedInterface(k_ESteamInterfaceNetworking, g_hSteamUser, g_hSteamPipe, STEAMNETWORKING_INTERFACE_VERSION)); }));
 }
 
 //-----------------------------------------------------------------------------
@@ -123,7 +477,7 @@ ISteamNetworking* SteamNetworking()
 //-----------------------------------------------------------------------------
 ISteamRemoteStorage* SteamRemoteStorage()
 {
-	return g_SteamAPIContext.m_pSteamRemoteStorage;
+	return Steam_TraceInterface(GetLazyInterface(g_SteamAPIContext.m_pSteamRemoteStorage, [] { return static_cast<ISteamRemoteStorage*>(SteamAPI_GetCachedInterface(k_ESteamInterfaceRemoteStorage, g_hSteamUser, g_hSteamPipe, STEAMREMOTESTORAGE_INTERFACE_VERSION)); }));
 }
 
 //-----------------------------------------------------------------------------
@@ -131,7 +485,7 @@ ISteamRemoteStorage* SteamRemoteStorage()
 //-----------------------------------------------------------------------------
 ISteamScreenshots* SteamScreenshots()
 {
-	return g_SteamAPIContext.m_pSteamScreenshots;
+	return Steam_TraceInterface(GetLazyInterface(g_SteamAPIContext.m_pSteamScreenshots, [] { return static_cast<ISteamScreenshots*>(SteamAPI_GetCachedInterface(k_ESteamInterfaceScreenshots, g_hSteamUser, g_hSteamPipe, STEAMSCREENSHOTS_INTERFACE_VERSION)); }));
 }
 
 //-----------------------------------------------------------------------------
@@ -139,7 +493,7 @@ ISteamScreenshots* SteamScreenshots()
 //-----------------------------------------------------------------------------
 ISteamHTTP* SteamHTTP()
 {
-	return g_SteamAPIContext.m_pSteamHTTP;
+	return Steam_TraceInterface(GetLazyInterface(g_SteamAPIContext.m_pSteamHTTP, [] { return static_cast<ISteamHTTP*>(SteamAPI_GetCachedInterface(k_ESteamInterfaceHTTP, g_hSteamUser, g_hSteamPipe, STEAMHTTP_INTERFACE_VERSION)); }));
 }
 
 //-----------------------------------------------------------------------------
@@ -177,13 +531,18 @@ ISteamContentServer* SteamContentServer()
 //-----------------------------------------------------------------------------
 ISteamUtils* SteamContentServerUtils()
 {
-	return g_pSteamContentServerUtils;
+	return Steam_TraceInterface(g_pSteamContentServerUtils);
 }
 
 //-----------------------------------------------------------------------------
 // 
 // Steam gameserver
 // 
+// Note:	Accessors return nothing while SteamGameServer_InitAsync() is still
+//			setting the globals up, see Steam_IsGameServerReady(). The globals
+//			hold what steamclient handed out, accessors wrap them into trace
+//			proxies when IPC tracing is on.
+// 
 //-----------------------------------------------------------------------------
 
 //-----------------------------------------------------------------------------
@@ -191,7 +550,7 @@ ISteamUtils* SteamContentServerUtils()
 //-----------------------------------------------------------------------------
 ISteamGameServer* SteamGameServer()
 {
-	return g_pSteamGameServer;
+	return Steam_IsGameServerReady() ? Steam_TraceInterface(g_pSteamGameServer) : nullptr;
 }
 
 //-----------------------------------------------------------------------------
@@ -199,7 +558,7 @@ ISteamGameServer* SteamGameServer()
 //-----------------------------------------------------------------------------
 ISteamUtils* SteamGameServerUtils()
 {
-	return g_pSteamGameServerUtils;
+	return Steam_IsGameServerReady() ? Steam_TraceInterface(g_pSteamGameServerUtils) : nullptr;
 }
 
 //-----------------------------------------------------------------------------
@@ -207,7 +566,7 @@ ISteamUtils* SteamGameServerUtils()
 //-----------------------------------------------------------------------------
 ISteamApps *SteamGameServerApps()
 {
-	return g_pSteamGameServerApps;
+	return Steam_IsGameServerReady() ? Steam_TraceInterface(g_pSteamGameServerApps) : nullptr;
 }
 
 //-----------------------------------------------------------------------------
@@ -215,7 +574,7 @@ ISteamApps *SteamGameServerApps()
 //-----------------------------------------------------------------------------
 ISteamNetworking *SteamGameServerNetworking()
 {
-	return g_pSteamGameServerNetworking;
+	return Steam_IsGameServerReady() ? Steam_TraceInterface(g_pSteamGameServerNetworking) : nullptr;
 }
 
 //-----------------------------------------------------------------------------
@@ -223,7 +582,7 @@ ISteamNetworking *SteamGameServerNetworking()
 //-----------------------------------------------------------------------------
 ISteamGameServerStats *SteamGameServerStats()
 {
-	return g_pSteamGameServerStats;
+	return Steam_IsGameServerReady() ? Steam_TraceInterface(g_pSteamGameServerStats) : nullptr;
 }
 
 //-----------------------------------------------------------------------------
@@ -231,7 +590,7 @@ ISteamGameServerStats *SteamGameServerStats()
 //-----------------------------------------------------------------------------
 ISteamHTTP *SteamGameServerHTTP()
 {
-	return g_pSteamGameServerHTTP;
+	return Steam_IsGameServerReady() ? Steam_TraceInterface(g_pSteamGameServerHTTP) : nullptr;
 }
 
 //-----------------------------------------------------------------------------
@@ -239,7 +598,7 @@ ISteamHTTP *SteamGameServerHTTP()
 //-----------------------------------------------------------------------------
 HSteamPipe SteamGameServer_GetHSteamPipe()
 {
-	return g_hSteamGameServerPipe;
+	return Steam_IsGameServerReady() ? g_hSteamGameServerPipe : 0;
 }
 
 //-----------------------------------------------------------------------------
@@ -247,5 +606,5 @@ HSteamPipe SteamGameServer_GetHSteamPipe()
 //-----------------------------------------------------------------------------
 HSteamUser SteamGameServer_GetHSteamUser()
 {
-	return g_hSteamGameServerUser;
+	return Steam_IsGameServerReady() ? g_hSteamGameServerUser : 0;
 }
\ No newline at end of file
@@ -29,6 +29,38 @@ bool SteamAPI_Init()
 	return SteamAPI_InitInternal(false);
 }
 
+//-----------------------------------------------------------------------------
+// Purpose: Sets ESteamAPIInitFlags used by the next initialization
+//-----------------------------------------------------------------------------
+void SteamAPI_SetInitFlags(uint32 unFlags)
+{
+	g_unSteamAPIInitFlags = unFlags;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Returns ESteamAPIInitFlags
+//-----------------------------------------------------------------------------
+uint32 SteamAPI_GetInitFlags()
+{
+	return g_unSteamAPIInitFlags;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Loads game overlay renderer deferred by the init flags
+//-----------------------------------------------------------------------------
+bool SteamAPI_LoadGameOverlay()
+{
+	return Steam_LoadDeferredGameOverlayRenderer();
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Reports what the last initialization did
+//-----------------------------------------------------------------------------
+void SteamAPI_GetInitReport(SteamInitReport_t *pReport)
+{
+	Steam_GetInitReport(pReport);
+}
+
 //-----------------------------------------------------------------------------
 // Purpose: Shuts down all code associated to steam API
 //-----------------------------------------------------------------------------
@@ -42,7 +74,14 @@ void SteamAPI_Shutdown()
 	g_hSteamUser = 0;
 
 	// Set all pointers to NULL
-	g_SteamAPIContext.Clear();
+	Steam_SetGlobalAPIContext(nullptr);
+	Steam_ClearInterfaceCache();
+	Steam_InvalidateGetterCache(false);
+
+	// Pump thread must be done with the pipe before it's released, and its
+	// dispatch context is handed to the next pipe
+	if (g_hSteamPipe)
+		CallbackMgr_ReleasePipe(g_hSteamPipe);
 
 	if (g_hSteamPipe)
 		g_pSteamClient->BReleaseSteamPipe(g_hSteamPipe);
@@ -58,6 +97,7 @@ void SteamAPI_Shutdown()
 	g_hSteamClientModule = nullptr;
 }
 
+#ifdef _WIN32
 //-----------------------------------------------------------------------------
 // Purpose: Executes shell command to start the steam executable with same 
 //			command-line parameters.
@@ -131,41 +171,36 @@ bool SteamAPI_RestartAppIfNecessary(uint32 unOwnAppID)
 	return (bSuccess == TRUE) ? true : false;
 }
 
+#else
 //-----------------------------------------------------------------------------
-// Purpose: Returns true if steam's active process is running.
+// Purpose: Relaunching through the client is only done on windows, the app is
+//			let to run as it is.
 //-----------------------------------------------------------------------------
-bool SteamAPI_IsSteamRunning()
+bool SteamAPI_RestartAppIfNecessary(uint32 unOwnAppID)
 {
-	DWORD	dwSteamPID, cbData;
-	HANDLE	hProcess;
-	DWORD	dwExitCode;
-	BOOL	bIsRunning;
-
-	cbData = sizeof(dwSteamPID);
+	return false;
+}
 
-	// Try to get steam process process id from registry
-	GetRegistryValue("Software\\Valve\\Steam\\ActiveProcess", "pid", (LPBYTE)&dwSteamPID, cbData);
+#endif
 
-	// Open steam process and query informaton from it
-	hProcess = OpenProcess(PROCESS_QUERY_INFORMATION, NULL, dwSteamPID);
+//-----------------------------------------------------------------------------
+// Purpose: Returns true if steam's active process is running.
+// Note:	The process id is read again each time, a client started after the
+//			paths were resolved has a different one. The snapshot is dropped 
+//			then, so the paths follow the running client as well.
+//-----------------------------------------------------------------------------
+bool SteamAPI_IsSteamRunning()
+{
+	uint32 unSteamPID;
 
-	if (!hProcess) // Not running
+	unSteamPID = Steam_ReadActiveSteamPID();
+	if (!Steam_IsProcessRunning(unSteamPID))
 		return false;
 
-	bIsRunning = FALSE;
-	dwExitCode = NULL;
-
-	// Check for exit code
-	if (GetExitCodeProcess(hProcess, &dwExitCode) != ERROR_SUCCESS)
-	{
-		// No more data is available
-		if (dwExitCode == ERROR_NO_MORE_ITEMS)
-			bIsRunning = TRUE;
-	}
-
-	CloseHandle(hProcess);
+	if (unSteamPID != Steam_GetClientPaths()->m_unSteamPID)
+		Steam_InvalidateClientPaths();
 
-	return (bIsRunning == TRUE) ? true : false;
+	return true;
 }
 
 //-----------------------------------------------------------------------------
@@ -174,69 +209,25 @@ bool SteamAPI_IsSteamRunning()
 //-----------------------------------------------------------------------------
 const char *SteamAPI_GetSteamInstallPath()
 {
-	HKEY	hKey;
-	LSTATUS lStatus;
-	DWORD	dwSteamPID, cbData;
-	HANDLE	hProcess;
-	BOOL	bIsRunning;
-	DWORD	dwExitCode;
-
-	*g_szSteamInstallPath = '\0';
-
-	// Get key for HKEY_CURRENT_USER
-	hKey = RegistryKeyByName("HKCU");
-
-	lStatus = RegOpenKeyExA(hKey, "Software\\Valve\\Steam\\ActiveProcess", NULL, KEY_READ, &hKey);
-	if (lStatus != NO_ERROR)
-		return g_szSteamInstallPath;
-
-	dwSteamPID = NULL;
-	cbData = sizeof(dwSteamPID);
-
-	// Locate pid of steam active process
-	lStatus = RegQueryValueExA(hKey, "pid", NULL, NULL, (LPBYTE)&dwSteamPID, &cbData);
-	if (lStatus != NO_ERROR)
-		return g_szSteamInstallPath;
-	
-	// Open steam process and query informaton from it
-	hProcess = OpenProcess(PROCESS_QUERY_INFORMATION, NULL, dwSteamPID);
+	strncpy(g_szSteamInstallPath, Steam_GetClientPaths()->m_szInstallPath, sizeof(g_szSteamInstallPath));
 
-	if (hProcess)
-	{
-		dwExitCode = NULL;
-
-		// Check for exit code
-		if (GetExitCodeProcess(hProcess, &dwExitCode) != ERROR_SUCCESS)
-		{
-			// No more data is available
-			if (dwExitCode == ERROR_NO_MORE_ITEMS)
-				bIsRunning = TRUE;
-		}
-
-		// We don't need the process handle anymore at this point
-		CloseHandle(hProcess);
+	return g_szSteamInstallPath;
+}
 
-		if (bIsRunning)
-		{
-			cbData = sizeof(g_szSteamInstallPath);
-
-			// Try to locate steamclient path
-			lStatus = RegQueryValueExA(hKey, "SteamClientDll", NULL, NULL, (LPBYTE)&dwSteamPID, &cbData);
-
-			if (lStatus != NO_ERROR && cbData > NULL && strlen(g_szSteamInstallPath) > NULL)
-			{
-				Q_StripFilename(g_szSteamInstallPath);
-			}
-			else
-			{
-				// Invalid data
-				*g_szSteamInstallPath = '\0';
-			}
-		}
-	}
+//-----------------------------------------------------------------------------
+// Purpose: Reports routines looked up from steam modules
+//-----------------------------------------------------------------------------
+int SteamAPI_GetSymbolBindings(SteamSymbolBinding_t *pBindings, int cMaxBindings)
+{
+	return Steam_GetSymbolBindings(pBindings, cMaxBindings);
+}
 
-	RegCloseKey(hKey);
-	return g_szSteamInstallPath;
+//-----------------------------------------------------------------------------
+// Purpose: Makes next Init look up where the steam client lives again
+//-----------------------------------------------------------------------------
+void SteamAPI_InvalidateSteamPaths()
+{
+	Steam_InvalidateClientPaths();
 }
 
 //-----------------------------------------------------------------------------
@@ -263,6 +254,23 @@ void Steam_RegisterInterfaceFuncs(void* hModule)
 	CallbackMgr_RegisterInterfaceFuncs(reinterpret_cast<HMODULE>(hModule));
 }
 
+//-----------------------------------------------------------------------------
+// Purpose: Feeds callback manager from inside of the process instead of from
+//			steamclient
+//-----------------------------------------------------------------------------
+void SteamAPI_SetCallbackSource(const SteamCallbackSource_t *pSource)
+{
+	CallbackMgr_SetCallbackSource(pSource);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Returns monotonic callback manager counters
+//-----------------------------------------------------------------------------
+void SteamAPI_GetCallbackMgrCounters(SteamCallbackMgrCounters_t *pCounters)
+{
+	CallbackMgr_GetCounters(pCounters);
+}
+
 //-----------------------------------------------------------------------------
 // Purpose: TODO
 //-----------------------------------------------------------------------------
@@ -271,6 +279,14 @@ void Steam_RunCallbacks(HSteamPipe SteamPipe, bool bGameServerCallbacks)
 	CallbackMgr_RunCallbacks(SteamPipe, bGameServerCallbacks);
 }
 
+//-----------------------------------------------------------------------------
+// Purpose: Returns user of the callback being dispatched by this thread
+//-----------------------------------------------------------------------------
+HSteamUser Steam_GetHSteamUserCurrent()
+{
+	return CallbackMgr_GetHSteamUserCurrent();
+}
+
 //-----------------------------------------------------------------------------
 // 
 // SteamAPI callback interface layer
@@ -279,26 +295,111 @@ void Steam_RunCallbacks(HSteamPipe SteamPipe, bool bGameServerCallbacks)
 // 
 //-----------------------------------------------------------------------------
 
+//-----------------------------------------------------------------------------
+// Purpose: Runs a frame of the user pipe's utilities, done after its callbacks
+//			were dispatched.
+//-----------------------------------------------------------------------------
+static void RunSteamUtilsFrame()
+{
+	if (!g_pSteamClient)
+		return;
+
+	// Utilities don't change while the pipe is open
+	if (!g_pSteamUtilsRunFrame || !Steam_IsGetterCacheEnabled())
+	{
+		ISteamUtils* pSteamUtils = g_pSteamClient->GetISteamUtils(g_hSteamPipe, STEAMUTILS_INTERFACE_VERSION);
+
+		if (!g_pSteamUtilsRunFrame)
+			g_pSteamUtilsRunFrame = pSteamUtils;
+	}
+
+	if (g_pSteamUtilsRunFrame)
+		g_pSteamUtilsRunFrame->RunFrame();
+}
+
 //-----------------------------------------------------------------------------
 // Purpose: 
 //-----------------------------------------------------------------------------
 void SteamAPI_RunCallbacks()
 {
-	ISteamUtils* pSteamUtils;
-
 	if (g_hSteamPipe)
 		CallbackMgr_RunCallbacks(g_hSteamPipe, false);
 
-	if (!g_pSteamClient)
-		return;
+	RunSteamUtilsFrame();
+}
 
-	pSteamUtils = g_pSteamClient->GetISteamUtils(g_hSteamPipe, STEAMUTILS_INTERFACE_VERSION);
+//-----------------------------------------------------------------------------
+// Purpose: Same as SteamAPI_RunCallbacks(), but callbacks that don't fit into
+//			the time budget are carried over to the next frame.
+//-----------------------------------------------------------------------------
+void SteamAPI_RunCallbacksBudget(uint32 unBudgetMicroseconds)
+{
+	if (g_hSteamPipe)
+		CallbackMgr_RunCallbacksBudget(g_hSteamPipe, false, unBudgetMicroseconds);
 
-	if (!g_pSteamUtilsRunFrame)
-		g_pSteamUtilsRunFrame = pSteamUtils;
+	RunSteamUtilsFrame();
+}
 
-	if (g_pSteamUtilsRunFrame || pSteamUtils->GetAppID() != k_uAppIdInvalid)
-		g_pSteamUtilsRunFrame->RunFrame();
+//-----------------------------------------------------------------------------
+// Purpose: Moves pulling of callback messages of the user pipe to a background
+//			thread. SteamAPI_RunCallbacks() then only dispatches what the thread
+//			has queued.
+//-----------------------------------------------------------------------------
+bool SteamAPI_StartCallbackPump(uint32 unPollIntervalMicroseconds)
+{
+	if (!g_hSteamPipe)
+		return false;
+
+	return CallbackMgr_StartPump(g_hSteamPipe, unPollIntervalMicroseconds);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Stops background thread of the user pipe.
+//-----------------------------------------------------------------------------
+void SteamAPI_StopCallbackPump()
+{
+	if (g_hSteamPipe)
+		CallbackMgr_StopPump(g_hSteamPipe);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Turns recording of callback dispatch statistics on or off
+//-----------------------------------------------------------------------------
+void SteamAPI_SetCallbackStatsEnabled(bool bEnabled)
+{
+	CallbackMgr_SetStatsEnabled(bEnabled);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Returns callback dispatch statistics recorded so far
+//-----------------------------------------------------------------------------
+int SteamAPI_GetCallbackStats(SteamCallbackStats_t *pStats, int cMaxStats)
+{
+	return CallbackMgr_GetStats(pStats, cMaxStats);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Zeroes callback dispatch statistics
+//-----------------------------------------------------------------------------
+void SteamAPI_ResetCallbackStats()
+{
+	CallbackMgr_ResetStats();
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Registers listener that is run through a non-virtual thunk
+//-----------------------------------------------------------------------------
+void SteamAPI_RegisterStaticCallback(const SteamCallbackDescriptor_t *pDescriptor, SteamCallbackThunk_t pfnThunk, void *pContext)
+{
+	CallbackMgr_RegisterStaticCallback(pDescriptor, pfnThunk, pContext);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Unregisters listener that is run through a non-virtual thunk
+//-----------------------------------------------------------------------------
+void SteamAPI_UnregisterStaticCallback(const SteamCallbackDescriptor_t *pDescriptor, SteamCallbackThunk_t pfnThunk, void *pContext)
+{
+	CallbackMgr_UnregisterStaticCallback(pDescriptor, pfnThunk, pContext);
 }
 
 //-----------------------------------------------------------------------------
@@ -333,6 +434,54 @@ void SteamAPI_UnregisterCallResult(CCallbackBase *pCallback, SteamAPICall_t hAPI
 	CallbackMgr_UnregisterCallResult(pCallback, hAPICall);
 }
 
+//-----------------------------------------------------------------------------
+// Purpose: Creates listener that owns a set of call results
+//-----------------------------------------------------------------------------
+HSteamCallResultGroup SteamAPI_CreateCallResultGroup(const SteamCallbackDescriptor_t *pDescriptor, SteamCallResultGroupThunk_t pfnThunk, void *pContext)
+{
+	return CallbackMgr_CreateCallResultGroup(pDescriptor, pfnThunk, pContext);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Destroys call result group along with its pending call results
+//-----------------------------------------------------------------------------
+void SteamAPI_DestroyCallResultGroup(HSteamCallResultGroup hGroup)
+{
+	CallbackMgr_DestroyCallResultGroup(hGroup);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Adds API call to the group, returns its index within the group
+//-----------------------------------------------------------------------------
+int SteamAPI_AddCallResultToGroup(HSteamCallResultGroup hGroup, SteamAPICall_t hAPICall)
+{
+	return CallbackMgr_AddToCallResultGroup(hGroup, hAPICall);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Returns how many call results of the group are still pending
+//-----------------------------------------------------------------------------
+int SteamAPI_GetCallResultGroupPending(HSteamCallResultGroup hGroup)
+{
+	return CallbackMgr_GetCallResultGroupPending(hGroup);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Hands out memory for a coroutine frame
+//-----------------------------------------------------------------------------
+void* SteamAPI_AllocCoroutineFrame(uint32 cubFrame)
+{
+	return CallbackMgr_AllocCoroutineFrame(cubFrame);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Returns memory of a coroutine frame
+//-----------------------------------------------------------------------------
+void SteamAPI_FreeCoroutineFrame(void *pFrame, uint32 cubFrame)
+{
+	CallbackMgr_FreeCoroutineFrame(pFrame, cubFrame);
+}
+
 //-----------------------------------------------------------------------------
 // Purpose: Setter for global variable g_bCatchExceptionsInCallbacks. 
 //-----------------------------------------------------------------------------
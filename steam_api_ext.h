@@ -0,0 +1,821 @@
+//========= Copyright  1996-2001, Valve LLC, All rights reserved. ============
+//
+// Purpose: Extensions to the steam_api interface exported by this module.
+//
+// $NoKeywords: $
+//=============================================================================
+#ifndef STEAM_API_EXT_H
+#define STEAM_API_EXT_H
+#pragma once
+
+//-----------------------------------------------------------------------------
+// 
+// Init flags
+// 
+// Purpose: Change how the next SteamAPI_Init() brings the API up, set them 
+//			before calling it.
+// 
+//			k_ESteamAPIInitLazyInterfaces - Init fetches only the interfaces it
+//			needs itself. SteamFriends(), SteamRemoteStorage() and the other
+//			accessors fetch theirs when first called, from any thread. Init
+//			no longer fails when some interface is missing, its accessor 
+//			returns nullptr instead.
+// 
+//			k_ESteamAPIInitParallelPreload - The minidump and game overlay 
+//			modules are loaded on worker threads while steamclient is being
+//			loaded, Init waits for them before they are first used.
+// 
+//			k_ESteamAPIInitHeadless - The game overlay renderer is never loaded,
+//			for tools and bots that don't render anything.
+// 
+//			k_ESteamAPIInitDeferOverlay - The game overlay renderer is loaded by
+//			SteamAPI_LoadGameOverlay() instead of Init. Call it before the 
+//			graphics device is created, the renderer hooks device creation.
+// 
+//-----------------------------------------------------------------------------
+
+enum ESteamAPIInitFlags
+{
+	k_ESteamAPIInitLazyInterfaces	= (1 << 0),
+	k_ESteamAPIInitParallelPreload	= (1 << 1),
+	k_ESteamAPIInitHeadless			= (1 << 2),
+	k_ESteamAPIInitDeferOverlay		= (1 << 3),
+};
+
+S_API void SteamAPI_SetInitFlags(uint32 unFlags);
+S_API uint32 SteamAPI_GetInitFlags();
+
+// Loads the game overlay renderer deferred by k_ESteamAPIInitDeferOverlay, 
+// returns true if it's loaded. Always false with k_ESteamAPIInitHeadless.
+S_API bool SteamAPI_LoadGameOverlay();
+
+//-----------------------------------------------------------------------------
+// 
+// Init report
+// 
+// Purpose: What the last successful SteamAPI_Init() did and how long it took.
+//			While the game overlay renderer is not loaded, m_cubOverlayNotLoaded
+//			is the size of the renderer module that wasn't mapped, comparing
+//			the report with a run that loads it tells the time saved.
+// 
+//-----------------------------------------------------------------------------
+
+struct SteamInitReport_t
+{
+	uint32	m_unFlags;						// ESteamAPIInitFlags Init was called with
+	uint64	m_nInitMicroseconds;
+
+	bool	m_bOverlayLoaded;
+	uint64	m_nOverlayLoadMicroseconds;		// Zero if Steam loaded it already
+	uint64	m_cubOverlayImage;				// Address space the renderer is mapped into
+	uint64	m_cubOverlayNotLoaded;			// Size of renderer module file
+};
+
+S_API void SteamAPI_GetInitReport(SteamInitReport_t *pReport);
+
+//-----------------------------------------------------------------------------
+// 
+// Interface cache
+// 
+// Purpose: Interfaces fetched from steamclient are kept per process, keyed by
+//			the interface, its version name, user and pipe. Every module that
+//			calls CSteamAPIContext::Init() gets the version it was built with,
+//			but each distinct version is fetched only once. Shutdown clears it.
+// 
+//-----------------------------------------------------------------------------
+
+enum ESteamInterface
+{
+	k_ESteamInterfaceUser,
+	k_ESteamInterfaceFriends,
+	k_ESteamInterfaceUtils,					// Fetched per pipe, user is ignored
+	k_ESteamInterfaceMatchmaking,
+	k_ESteamInterfaceMatchmakingServers,
+	k_ESteamInterfaceUserStats,
+	k_ESteamInterfaceApps,
+	k_ESteamInterfaceNetworking,
+	k_ESteamInterfaceRemoteStorage,
+	k_ESteamInterfaceScreenshots,
+	k_ESteamInterfaceHTTP,
+};
+
+S_API void* SteamAPI_GetCachedInterface(ESteamInterface eInterface, HSteamUser hSteamUser, HSteamPipe hSteamPipe, const char *pchVersion);
+
+//-----------------------------------------------------------------------------
+// 
+// Getter cache
+// 
+// Purpose: When enabled, results of the getters below are remembered instead
+//			of asking steamclient every time. They are forgotten when the pipe
+//			they were asked on dispatches SteamServersConnected_t, 
+//			SteamServersDisconnected_t or GSPolicyResponse_t, and on shutdown.
+//			SteamAPI_RunCallbacks() also stops fetching the utilities every
+//			frame. Off by default.
+// 
+//-----------------------------------------------------------------------------
+
+S_API void SteamAPI_SetGetterCacheEnabled(bool bEnabled);
+
+S_API uint32 SteamAPI_GetAppID();
+S_API uint64 SteamAPI_GetSteamID();
+S_API bool SteamAPI_BLoggedOn();
+
+// SteamGameServer_BSecure() and SteamGameServer_GetSteamID() are cached too
+S_API bool SteamGameServer_BLoggedOn();
+
+//-----------------------------------------------------------------------------
+// 
+// IPC tracing
+// 
+// Purpose: When enabled, interfaces returned by the accessors from then on
+//			are wrapped in proxies counting and timing every method call, each
+//			of which is a round-trip to steamclient. Overloaded methods are
+//			reported with the type they differ by, e.g. "GetStat(float)". It
+//			can be turned on or off at any time, pointers kept by the caller
+//			stay as they were handed out. Off by default.
+// 
+//-----------------------------------------------------------------------------
+
+struct SteamIPCTraceStats_t
+{
+	const char*	m_pszInterface;
+	const char*	m_pszMethod;
+
+	uint64		m_nCalls;
+	uint64		m_nTotalNanoseconds;
+	uint64		m_nMaxNanoseconds;
+};
+
+S_API void SteamAPI_SetIPCTracingEnabled(bool bEnabled);
+
+// Fills up to cMaxStats entries, one per method called so far, and returns how
+// many there are, so it can be called with nullptr first to size the array.
+S_API int SteamAPI_GetIPCTraceStats(SteamIPCTraceStats_t *pStats, int cMaxStats);
+S_API void SteamAPI_ResetIPCTraceStats();
+
+//-----------------------------------------------------------------------------
+// 
+// Game server instances
+// 
+// Purpose: Several game servers in one process, each with its own pipe, user
+//			and interfaces, sharing one loaded steamclient module. Callbacks of
+//			an instance are dispatched by SteamGameServer_RunInstanceCallbacks(),
+//			instances can be run on different threads. Game server listeners
+//			registered the usual way get messages of every instance, so with
+//			instances run on several threads they are called concurrently and
+//			must be thread-safe, Steam_GetHSteamUserCurrent() tells which one
+//			is being dispatched. Listeners registered with 
+//			SteamGameServer_RegisterInstanceCallback() only get messages of 
+//			their instance, on the thread dispatching it. The 
+//			SteamGameServer_*() API keeps working with the server set up by 
+//			SteamGameServer_Init().
+// 
+//-----------------------------------------------------------------------------
+
+typedef int32 HSteamGameServer;
+
+struct SteamGameServerInterfaces_t
+{
+	HSteamPipe				m_hSteamPipe;
+	HSteamUser				m_hSteamUser;
+
+	ISteamGameServer*		m_pSteamGameServer;
+	ISteamUtils*			m_pSteamGameServerUtils;
+	ISteamApps*				m_pSteamGameServerApps;
+	ISteamNetworking*		m_pSteamGameServerNetworking;
+	ISteamGameServerStats*	m_pSteamGameServerStats;
+	ISteamHTTP*				m_pSteamGameServerHTTP;
+};
+
+// Returns 0 when the game server couldn't be set up
+S_API HSteamGameServer SteamGameServer_CreateInstance(uint32 unIP, uint16 usSteamPort, uint16 usGamePort, uint16 usQueryPort, EServerMode eServerMode, const char *pchVersionString);
+
+// Waits for callbacks of the instance running on other threads. Called from one
+// of its own callbacks, the instance is torn down once they return.
+S_API void SteamGameServer_DestroyInstance(HSteamGameServer hInstance);
+
+S_API bool SteamGameServer_GetInstanceInterfaces(HSteamGameServer hInstance, SteamGameServerInterfaces_t *pInterfaces);
+S_API void SteamGameServer_RunInstanceCallbacks(HSteamGameServer hInstance);
+
+// Registers pCallback as game server listener of the instance. It's removed by
+// SteamAPI_UnregisterCallback(), before the instance is destroyed.
+S_API bool SteamGameServer_RegisterInstanceCallback(HSteamGameServer hInstance, CCallbackBase *pCallback, int iCallback);
+
+//-----------------------------------------------------------------------------
+// Purpose: CCallback of one game server instance
+//
+//	class CMyServer
+//	{
+//		void OnPolicyResponse(GSPolicyResponse_t *pParam);
+//		CGameServerInstanceCallback<CMyServer, GSPolicyResponse_t> m_PolicyResponse;
+//	};
+//
+//	m_PolicyResponse.Register(hInstance, this, &CMyServer::OnPolicyResponse);
+//-----------------------------------------------------------------------------
+template<class T, class P>
+class CGameServerInstanceCallback : public CCallbackBase
+{
+public:
+	typedef void (T::*func_t)(P*);
+
+	CGameServerInstanceCallback() :
+		m_pObj(nullptr),
+		m_Func(nullptr)
+	{
+	}
+
+	~CGameServerInstanceCallback()
+	{
+		Unregister();
+	}
+
+	bool Register(HSteamGameServer hInstance, T *pObj, func_t Func)
+	{
+		if (!pObj || !Func)
+			return false;
+
+		Unregister();
+
+		m_pObj = pObj;
+		m_Func = Func;
+		return SteamGameServer_RegisterInstanceCallback(hInstance, this, P::k_iCallback);
+	}
+
+	void Unregister()
+	{
+		if (m_nCallbackFlags & k_ECallbackFlagsRegistered)
+			SteamAPI_UnregisterCallback(this);
+	}
+
+	bool IsRegistered() const
+	{
+		return (m_nCallbackFlags & k_ECallbackFlagsRegistered) != 0;
+	}
+
+protected:
+	virtual void Run(void *pvParam)
+	{
+		(m_pObj->*m_Func)(static_cast<P*>(pvParam));
+	}
+
+	virtual void Run(void *pvParam, bool bIOFailure, SteamAPICall_t hSteamAPICall)
+	{
+		Run(pvParam);
+	}
+
+	virtual int GetCallbackSizeBytes()
+	{
+		return sizeof(P);
+	}
+
+	CGameServerInstanceCallback(const CGameServerInstanceCallback&) = delete;
+	CGameServerInstanceCallback& operator=(const CGameServerInstanceCallback&) = delete;
+
+private:
+	T*		m_pObj;
+	func_t	m_Func;
+};
+
+S_API HSteamUser Steam_GetHSteamUserCurrent();
+
+//-----------------------------------------------------------------------------
+// 
+// Asynchronous game server init
+// 
+// Purpose: Same as SteamGameServer_Init(), but steam is brought up on a worker
+//			thread while the caller carries on. Stage can be polled, and the
+//			completion routine is called from the worker once it's done. The
+//			game server accessors return nothing until the stage is 
+//			k_ESteamGameServerInitSucceeded, and SteamGameServer_Init() fails
+//			while the worker is running. Returns false if initialization is in
+//			progress or done already. A failed worker releases everything it 
+//			set up, either init can be retried without a shutdown.
+// 
+//-----------------------------------------------------------------------------
+
+enum ESteamGameServerInitStage
+{
+	k_ESteamGameServerInitNone,
+	k_ESteamGameServerInitLoadingModule,
+	k_ESteamGameServerInitCreatingUser,
+	k_ESteamGameServerInitFetchingInterfaces,
+	k_ESteamGameServerInitStartingServer,
+	k_ESteamGameServerInitSucceeded,
+	k_ESteamGameServerInitFailed,
+};
+
+typedef void (*SteamGameServerInitCompleted_t)(bool bSuccess, void *pContext);
+
+S_API bool SteamGameServer_InitAsync(uint32 unIP, uint16 usSteamPort, uint16 usGamePort, uint16 usQueryPort, EServerMode eServerMode, const char *pchVersionString, SteamGameServerInitCompleted_t pfnCompleted, void *pContext);
+S_API ESteamGameServerInitStage SteamGameServer_GetInitStage();
+
+//-----------------------------------------------------------------------------
+// 
+// Game server warm restart
+// 
+// Purpose: When enabled, SteamGameServer_Shutdown() only logs the server off
+//			and keeps the module, pipe, user and interfaces around. The next
+//			SteamGameServer_Init() with the same IP and steam port reuses them
+//			and only initializes the server again, anything else sets up a new
+//			one. Safe mode servers are always shut down. Disabling releases the
+//			server kept around. Callbacks still pending from the previous
+//			session are dropped, the restarted server only gets its own.
+// 
+//-----------------------------------------------------------------------------
+
+S_API void SteamGameServer_SetWarmRestart(bool bEnabled);
+
+//-----------------------------------------------------------------------------
+// 
+// Budgeted callback dispatch
+// 
+// Purpose: Same as SteamAPI_RunCallbacks() and SteamGameServer_RunCallbacks(),
+//			but dispatching stops once the time budget (in microseconds) is 
+//			spent. Messages that didn't fit are kept, in order, and dispatched
+//			first by the next call on the same pipe.
+// 
+//-----------------------------------------------------------------------------
+
+S_API void SteamAPI_RunCallbacksBudget(uint32 unBudgetMicroseconds);
+S_API void SteamGameServer_RunCallbacksBudget(uint32 unBudgetMicroseconds);
+
+//-----------------------------------------------------------------------------
+// 
+// Background callback pump
+// 
+// Purpose: Starts a thread that pulls callback messages out of the pipe and
+//			queues them, so RunCallbacks() only has to dispatch them. The pipe 
+//			is polled every unPollIntervalMicroseconds while it is empty, 
+//			intervals below 50us are raised to that. Call from the thread that
+//			runs callbacks. Shutdown stops the pump.
+// 
+//-----------------------------------------------------------------------------
+
+S_API bool SteamAPI_StartCallbackPump(uint32 unPollIntervalMicroseconds);
+S_API void SteamAPI_StopCallbackPump();
+S_API bool SteamGameServer_StartCallbackPump(uint32 unPollIntervalMicroseconds);
+S_API void SteamGameServer_StopCallbackPump();
+
+//-----------------------------------------------------------------------------
+// 
+// Callback dispatch statistics
+// 
+// Purpose: Per callback identifier counters, kept separately for client pipe
+//			listeners, game server pipe listeners and call results. Recording
+//			is off by default, when off dispatch doesn't read the clock. Time
+//			of call results is not counted again in the SteamAPICallCompleted_t
+//			message that completed them.
+// 
+//-----------------------------------------------------------------------------
+
+#define STEAM_CALLBACK_STATS_HISTOGRAM_BUCKETS	32
+
+struct SteamCallbackStats_t
+{
+	int		m_iCallback;
+	bool	m_bGameServer;				// Dispatched on game server pipe
+	bool	m_bCallResult;				// Delivered as a call result
+
+	uint64	m_nCount;
+	uint64	m_nTotalRunNanoseconds;		// Time spent in Run() of all listeners
+	uint64	m_nMaxRunNanoseconds;
+	uint64	m_cubTotalPayload;
+
+	// Run() time distribution. Bucket i starts at (2 + (i & 1)) << (9 + i / 2)
+	// nanoseconds: 1024, 1536, 2048, 3072, ... The first bucket also holds 
+	// everything below, the last one everything above.
+	uint32	m_rgnHistogram[STEAM_CALLBACK_STATS_HISTOGRAM_BUCKETS];
+};
+
+S_API void SteamAPI_SetCallbackStatsEnabled(bool bEnabled);
+
+// Fills up to cMaxStats entries and returns how many there are, so it can be
+// called with nullptr first to size the array.
+S_API int SteamAPI_GetCallbackStats(SteamCallbackStats_t *pStats, int cMaxStats);
+S_API void SteamAPI_ResetCallbackStats();
+
+//-----------------------------------------------------------------------------
+// 
+// Static callback registration
+// 
+// Purpose: Listeners described at compile time. Dispatch calls the thunk 
+//			directly with the payload instead of going through the virtual
+//			CCallbackBase::Run(), so the handler can be inlined into it. A
+//			listener is identified by the thunk and context pair, the rules of
+//			SteamAPI_RegisterCallback() and SteamAPI_UnregisterCallback() apply.
+// 
+//-----------------------------------------------------------------------------
+
+struct SteamCallbackDescriptor_t
+{
+	int		m_iCallback;
+	int		m_cubParam;			// Messages with smaller payload are not delivered
+	bool	m_bGameServer;
+};
+
+typedef void (*SteamCallbackThunk_t)(void *pContext, void *pvParam);
+
+S_API void SteamAPI_RegisterStaticCallback(const SteamCallbackDescriptor_t *pDescriptor, SteamCallbackThunk_t pfnThunk, void *pContext);
+S_API void SteamAPI_UnregisterStaticCallback(const SteamCallbackDescriptor_t *pDescriptor, SteamCallbackThunk_t pfnThunk, void *pContext);
+
+//-----------------------------------------------------------------------------
+// Purpose: Drop-in for CCallback when the handler is known at compile time
+//
+//	class CMyServer
+//	{
+//		void OnPolicyResponse(GSPolicyResponse_t *pParam);
+//		CStaticCallback<CMyServer, GSPolicyResponse_t, &CMyServer::OnPolicyResponse, true> m_PolicyResponse;
+//	};
+//-----------------------------------------------------------------------------
+template<class T, class P, void (T::*Func)(P*), bool bGameServer = false>
+class CStaticCallback
+{
+public:
+	static constexpr SteamCallbackDescriptor_t k_Descriptor = { P::k_iCallback, (int)sizeof(P), bGameServer };
+
+	CStaticCallback() :
+		m_pObj(nullptr)
+	{
+	}
+
+	CStaticCallback(T *pObj) :
+		m_pObj(nullptr)
+	{
+		Register(pObj);
+	}
+
+	~CStaticCallback()
+	{
+		Unregister();
+	}
+
+	void Register(T *pObj)
+	{
+		if (m_pObj)
+			Unregister();
+
+		m_pObj = pObj;
+		SteamAPI_RegisterStaticCallback(&k_Descriptor, &Thunk, pObj);
+	}
+
+	void Unregister()
+	{
+		if (!m_pObj)
+			return;
+
+		SteamAPI_UnregisterStaticCallback(&k_Descriptor, &Thunk, m_pObj);
+		m_pObj = nullptr;
+	}
+
+	bool IsRegistered() const
+	{
+		return m_pObj != nullptr;
+	}
+
+private:
+	static void Thunk(void *pContext, void *pvParam)
+	{
+		(static_cast<T*>(pContext)->*Func)(static_cast<P*>(pvParam));
+	}
+
+	CStaticCallback(const CStaticCallback&) = delete;
+	CStaticCallback& operator=(const CStaticCallback&) = delete;
+
+private:
+	T* m_pObj;
+};
+
+//-----------------------------------------------------------------------------
+// 
+// Call result groups
+// 
+// Purpose: One listener waiting for any number of API calls of the same kind,
+//			instead of a CCallResult per call. The thunk gets the handle and its
+//			index within the group, which counts handles in the order they were
+//			added. Destroying the group doesn't walk its pending handles, their
+//			completions are dropped. The descriptor's m_bGameServer is unused,
+//			call results are matched by handle.
+// 
+//-----------------------------------------------------------------------------
+
+typedef uint32 HSteamCallResultGroup;
+
+typedef void (*SteamCallResultGroupThunk_t)(void *pContext, void *pvParam, bool bIOFailure, SteamAPICall_t hAPICall, int iIndex);
+
+// Returns 0 when no more groups can be created
+S_API HSteamCallResultGroup SteamAPI_CreateCallResultGroup(const SteamCallbackDescriptor_t *pDescriptor, SteamCallResultGroupThunk_t pfnThunk, void *pContext);
+S_API void SteamAPI_DestroyCallResultGroup(HSteamCallResultGroup hGroup);
+
+// Returns -1 if the group doesn't exist or the handle is invalid
+S_API int SteamAPI_AddCallResultToGroup(HSteamCallResultGroup hGroup, SteamAPICall_t hAPICall);
+S_API int SteamAPI_GetCallResultGroupPending(HSteamCallResultGroup hGroup);
+
+//-----------------------------------------------------------------------------
+// Purpose: Drop-in for a set of CCallResult objects, such as CMultipleCallResults
+//
+//	class CDownloadManager
+//	{
+//		void OnHTTPRequestCompleted(HTTPRequestCompleted_t *pParam, bool bIOFailure, SteamAPICall_t hAPICall, int iIndex);
+//		CCallResultGroup<CDownloadManager, HTTPRequestCompleted_t, &CDownloadManager::OnHTTPRequestCompleted> m_HTTPRequestCompleted;
+//	};
+//-----------------------------------------------------------------------------
+template<class T, class P, void (T::*Func)(P*, bool, SteamAPICall_t, int)>
+class CCallResultGroup
+{
+public:
+	static constexpr SteamCallbackDescriptor_t k_Descriptor = { P::k_iCallback, (int)sizeof(P), false };
+
+	CCallResultGroup() :
+		m_hGroup(0)
+	{
+	}
+
+	CCallResultGroup(T *pObj) :
+		m_hGroup(0)
+	{
+		Create(pObj);
+	}
+
+	~CCallResultGroup()
+	{
+		Destroy();
+	}
+
+	bool Create(T *pObj)
+	{
+		Destroy();
+
+		m_hGroup = SteamAPI_CreateCallResultGroup(&k_Descriptor, &Thunk, pObj);
+		return m_hGroup != 0;
+	}
+
+	void Destroy()
+	{
+		if (!m_hGroup)
+			return;
+
+		SteamAPI_DestroyCallResultGroup(m_hGroup);
+		m_hGroup = 0;
+	}
+
+	int AddCall(SteamAPICall_t hAPICall)
+	{
+		return SteamAPI_AddCallResultToGroup(m_hGroup, hAPICall);
+	}
+
+	int GetPending() const
+	{
+		return SteamAPI_GetCallResultGroupPending(m_hGroup);
+	}
+
+private:
+	static void Thunk(void *pContext, void *pvParam, bool bIOFailure, SteamAPICall_t hAPICall, int iIndex)
+	{
+		(static_cast<T*>(pContext)->*Func)(static_cast<P*>(pvParam), bIOFailure, hAPICall, iIndex);
+	}
+
+	CCallResultGroup(const CCallResultGroup&) = delete;
+	CCallResultGroup& operator=(const CCallResultGroup&) = delete;
+
+private:
+	HSteamCallResultGroup m_hGroup;
+};
+
+//-----------------------------------------------------------------------------
+// 
+// Call result coroutines
+// 
+// Purpose: co_await on a SteamAPICall_t instead of a CCallResult listener. The
+//			coroutine is resumed from inside of the call result dispatch, on the
+//			thread running callbacks of the pipe the call completes on. Frames
+//			of CSteamAsync coroutines come from a pool kept by this module.
+//
+//	CSteamAsync Download(const char *pszURL)
+//	{
+//		SteamAPICall_t hAPICall;
+//		...
+//		SteamAPICallResult_t<HTTPRequestCompleted_t> Result = co_await CSteamAPICallAwaiter<HTTPRequestCompleted_t>(hAPICall);
+//		...
+//	}
+// 
+//-----------------------------------------------------------------------------
+
+// Returns nullptr when out of memory
+S_API void* SteamAPI_AllocCoroutineFrame(uint32 cubFrame);
+S_API void SteamAPI_FreeCoroutineFrame(void *pFrame, uint32 cubFrame);
+
+#if defined(__cpp_impl_coroutine)
+
+#include <coroutine>
+#include <exception>
+
+//-----------------------------------------------------------------------------
+// Purpose: What the awaited call completed with. m_bIOFailure is also set when
+//			the handle was invalid, m_Data is left zeroed then.
+//-----------------------------------------------------------------------------
+template<class T>
+struct SteamAPICallResult_t
+{
+	T		m_Data;
+	bool	m_bIOFailure;
+};
+
+//-----------------------------------------------------------------------------
+// Purpose: Awaiter of one API call, registered as its call result while the 
+//			coroutine is suspended.
+//-----------------------------------------------------------------------------
+template<class T>
+class CSteamAPICallAwaiter : private CCallbackBase
+{
+public:
+	explicit CSteamAPICallAwaiter(SteamAPICall_t hAPICall) :
+		m_hAPICall(hAPICall),
+		m_Result()
+	{
+		m_iCallback = T::k_iCallback;
+		m_Result.m_bIOFailure = true;
+	}
+
+	// Only destroyed while pending along with a coroutine that never resumes
+	~CSteamAPICallAwaiter()
+	{
+		if (m_hAPICall != k_uAPICallInvalid)
+			SteamAPI_UnregisterCallResult(this, m_hAPICall);
+	}
+
+	bool await_ready() const
+	{
+		return m_hAPICall == k_uAPICallInvalid;
+	}
+
+	void await_suspend(std::coroutine_handle<> hCoroutine)
+	{
+		m_hCoroutine = hCoroutine;
+
+		// Resumed from OnSteamAPICallCompleted() on the thread dispatching the
+		// pipe. If another thread dispatches it, that can happen before this
+		// returns, so nothing is touched after registering.
+		SteamAPI_RegisterCallResult(this, m_hAPICall);
+	}
+
+	SteamAPICallResult_t<T> await_resume() const
+	{
+		return m_Result;
+	}
+
+private:
+	virtual void Run(void *pvParam)
+	{
+	}
+
+	virtual void Run(void *pvParam, bool bIOFailure, SteamAPICall_t hAPICall)
+	{
+		// Payload is only valid for the duration of this call
+		m_Result.m_Data = *static_cast<T*>(pvParam);
+		m_Result.m_bIOFailure = bIOFailure;
+
+		// Call result was already dropped by the manager
+		m_hAPICall = k_uAPICallInvalid;
+
+		m_hCoroutine.resume();
+	}
+
+	virtual int GetCallbackSizeBytes()
+	{
+		return sizeof(T);
+	}
+
+	CSteamAPICallAwaiter(const CSteamAPICallAwaiter&) = delete;
+	CSteamAPICallAwaiter& operator=(const CSteamAPICallAwaiter&) = delete;
+
+private:
+	SteamAPICall_t				m_hAPICall;
+	SteamAPICallResult_t<T>		m_Result;
+	std::coroutine_handle<>		m_hCoroutine;
+};
+
+//-----------------------------------------------------------------------------
+// Purpose: Fire and forget coroutine. Runs until the first co_await right away
+//			and frees its frame once it returns. Coroutines whose frame can't
+//			be allocated are not run at all.
+//-----------------------------------------------------------------------------
+class CSteamAsync
+{
+public:
+	struct promise_type
+	{
+		CSteamAsync get_return_object() { return CSteamAsync(); }
+		static CSteamAsync get_return_object_on_allocation_failure() { return CSteamAsync(); }
+
+		std::suspend_never initial_suspend() noexcept { return {}; }
+		std::suspend_never final_suspend() noexcept { return {}; }
+
+		void return_void() {}
+		void unhandled_exception() { std::terminate(); }
+
+		static void* operator new(size_t cubFrame) noexcept
+		{
+			return SteamAPI_AllocCoroutineFrame((uint32)cubFrame);
+		}
+
+		static void operator delete(void *pFrame, size_t cubFrame)
+		{
+			SteamAPI_FreeCoroutineFrame(pFrame, (uint32)cubFrame);
+		}
+	};
+};
+
+#endif
+
+//-----------------------------------------------------------------------------
+// 
+// Steam client paths
+// 
+// Purpose: Where the client is installed and its process id are looked up 
+//			once and shared by every Init call. Call this after the client was
+//			started, restarted or moved to look them up again. Failed Init 
+//			does so by itself.
+// 
+//-----------------------------------------------------------------------------
+
+S_API void SteamAPI_InvalidateSteamPaths();
+
+//-----------------------------------------------------------------------------
+// 
+// Symbol bindings
+// 
+// Purpose: Lists every routine looked up from steam modules so far, with the
+//			name it was found under or nullptr when the module doesn't export 
+//			it. Fills up to cMaxBindings entries and returns how many there 
+//			are, so it can be called with nullptr first to size the array.
+// 
+//-----------------------------------------------------------------------------
+
+struct SteamSymbolBinding_t
+{
+	const char*	m_pszModule;
+	const char*	m_pszSymbol;
+	const char*	m_pszBoundName;			// nullptr if missing
+};
+
+S_API int SteamAPI_GetSymbolBindings(SteamSymbolBinding_t *pBindings, int cMaxBindings);
+
+//-----------------------------------------------------------------------------
+// 
+// Steamclient stand-ins
+// 
+// Purpose: Lets the module run without Steam, for load tests and benchmarks.
+//			
+//			SteamClientModuleOverride environment variable names a module that
+//			is loaded in place of steamclient by every Init call. The module 
+//			has to export the SteamClient012 factory through CreateInterface
+//			and Steam_BGetCallback, Steam_FreeLastCallback and 
+//			Steam_GetAPICallResult. steamclient_standin/ is such a module, it
+//			replays a scenario file, see standin.h.
+// 
+//			SteamAPI_SetCallbackSource() feeds the callback manager from inside
+//			of the process instead, drive it with Steam_RunCallbacks() on any 
+//			pipe handle. Pass nullptr to go back to steamclient. Must not be
+//			called while callbacks are being run.
+// 
+//-----------------------------------------------------------------------------
+
+#define STEAMCLIENT_MODULE_OVERRIDE_ENV		"SteamClientModuleOverride"
+
+struct SteamCallbackSource_t
+{
+	bool (*m_pfnBGetCallback)(HSteamPipe hSteamPipe, CallbackMsg_t *pCallbackMsg);
+	void (*m_pfnFreeLastCallback)(HSteamPipe hSteamPipe);
+	bool (*m_pfnGetAPICallResult)(HSteamPipe hSteamPipe, SteamAPICall_t hSteamAPICall, void *pCallback, int cubCallback, int iCallbackExpected, bool *pbFailed);
+};
+
+S_API void SteamAPI_SetCallbackSource(const SteamCallbackSource_t *pSource);
+
+//-----------------------------------------------------------------------------
+// 
+// Callback manager counters
+// 
+// Purpose: Monotonic totals since the module was loaded, never reset. Take a
+//			snapshot before and after a run and divide the difference by the 
+//			number of operations, e.g. allocations per dispatched message. 
+//			Together with a callback source this measures dispatch, 
+//			registration and call result completion without Steam, run
+//			times are recorded by the dispatch statistics above.
+// 
+//-----------------------------------------------------------------------------
+
+struct SteamCallbackMgrCounters_t
+{
+	uint64	m_nMessagesDispatched;		// Messages handed to listeners, all pipes
+	uint64	m_nCallResultsCompleted;	// Call results that were run
+	uint64	m_nCallResultsUnclaimed;	// Completions nobody was registered for
+	uint64	m_nRegistryOps;				// Register and unregister calls of any kind
+	uint64	m_nAllocations;				// Heap allocations made by the manager
+	uint64	m_cubAllocated;
+	uint64	m_cubScratchBytesAvoided;	// Call result payloads served without allocating
+	uint32	m_nOutstandingCallResults;	// Call results currently registered
+};
+
+S_API void SteamAPI_GetCallbackMgrCounters(SteamCallbackMgrCounters_t *pCounters);
+
+#endif
\ No newline at end of file
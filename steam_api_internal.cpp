@@ -7,6 +7,11 @@
 
 #include "steam_api_pch.h"
 
+#include <chrono>
+#include <mutex>
+
+#include <sys/stat.h>
+
 //-----------------------------------------------------------------------------
 // 
 // Internal global variables
@@ -27,12 +32,20 @@ HMODULE				g_hSteamGameOverlayRendererModule = NULL;
 // of steamclient API.
 CSteamAPIContext	g_SteamAPIContext;
 
+// What the last successful initialization did, guarded by overlay lock
+static SteamInitReport_t	s_SteamInitReport;
+static std::mutex			s_GameOverlayLock;
+
 // We're allowing to catch exceptions inside callback handling code by default
 bool				g_bCatchExceptionsInCallbacks = true;
 
+// ESteamAPIInitFlags set by SteamAPI_SetInitFlags()
+uint32				g_unSteamAPIInitFlags = 0;
+
 //-----------------------------------------------------------------------------
 // Purpose: Module names that the SteamAPI module accesses
 //-----------------------------------------------------------------------------
+#ifdef _WIN32
 const char* k_pszSteamClientModuleName = "steamclient.dll";
 const char* k_pszSteamClientModule64Name = "steamclient64.dll";
 const char* k_pszSteamModuleName = "steam.dll";
@@ -40,6 +53,15 @@ const char* k_pszSteamUIModuleName = "steamui.dll";
 const char* k_pszSteamConsoleModuleName = "steamconsole.dll";
 const char* k_pszSteamGameOverlayRendererModuleName = "gameoverlayrenderer.dll";
 const char* k_pszSteamBinAudioModuleName = "bin\\audio.dll";
+#else
+const char* k_pszSteamClientModuleName = "steamclient.so";
+const char* k_pszSteamClientModule64Name = "steamclient.so";
+const char* k_pszSteamModuleName = "steam.so";
+const char* k_pszSteamUIModuleName = "steamui.so";
+const char* k_pszSteamConsoleModuleName = "steamconsole.so";
+const char* k_pszSteamGameOverlayRendererModuleName = "gameoverlayrenderer.so";
+const char* k_pszSteamBinAudioModuleName = "bin/audio.so";
+#endif
 
 //-----------------------------------------------------------------------------
 // Purpose: Minidump routines
@@ -97,6 +119,10 @@ EServerMode		g_eGameServerMode;
 // Handle to steamclient module for game server client
 HMODULE			g_hSteamGameServerModule;
 
+// Local binding of game server user
+static uint32	s_unGameServerIP;
+static uint16	s_usGameServerSteamPort;
+
 //-----------------------------------------------------------------------------
 // 
 // Internal Steam API routines
@@ -109,20 +135,53 @@ HMODULE			g_hSteamGameServerModule;
 //-----------------------------------------------------------------------------
 bool SteamAPI_InitInternal(bool safe)
 {
-	char		SteamAPPId[12];
-	AppId_t		AppID;
-	ISteamUser*	pSteamUser;
-	ISteamUtils*pSteamUtils;
+	char				SteamAPPId[12];
+	AppId_t				AppID;
+	ISteamUser*			pSteamUser;
+	ISteamUtils*		pSteamUtils;
+	CSteamAPIContext	Context;
+	bool				bPreload;
+	bool				bLoadOverlay;
 
 	// Already initialized
 	if (g_pSteamClient != nullptr)
 		return true;
 
+	auto Start = std::chrono::steady_clock::now();
+
+	{
+		std::lock_guard<std::mutex> Lock(s_GameOverlayLock);
+
+		s_SteamInitReport = {};
+		s_SteamInitReport.m_unFlags = g_unSteamAPIInitFlags;
+	}
+
+	bPreload = (g_unSteamAPIInitFlags & k_ESteamAPIInitParallelPreload) != 0;
+	bLoadOverlay = (g_unSteamAPIInitFlags & (k_ESteamAPIInitHeadless | k_ESteamAPIInitDeferOverlay)) == 0;
+
+	// Load the other modules while steamclient is being loaded
+	if (bPreload)
+	{
+		Steam_StartPreload(Steam_PreloadMinidumpInterface);
+
+		if (bLoadOverlay)
+			Steam_StartPreload([] { Steam_LoadGameOverlayRenderer(); });
+	}
+
 	// Get steam client interface and module handle to steamclient.dll or steam.dll
 	g_pSteamClient = SteamAPI_Init_Internal(&g_hSteamClientModule, false);
 
 	if (!g_pSteamClient)
+	{
+		// Don't keep what was preloaded for nothing
+		if (bPreload)
+		{
+			Steam_JoinPreloads();
+			Steam_ShutdownMinidumpInterface();
+		}
+
 		return false;
+	}
 
 	g_hSteamPipe = g_pSteamClient->CreateSteamPipe();
 	g_hSteamUser = g_pSteamClient->ConnectToGlobalUser(g_hSteamPipe);
@@ -145,13 +204,19 @@ bool SteamAPI_InitInternal(bool safe)
 	// Unsafe mode
 	else
 	{
-		if (!g_SteamAPIContext.Init())
+		// Accessors fetch interfaces on first use, only what's needed to finish
+		// initialization is fetched below.
+		Context.Clear();
+
+		if (!(g_unSteamAPIInitFlags & k_ESteamAPIInitLazyInterfaces) && !Context.Init())
 		{
 			SteamAPI_Shutdown();
 			return false;
 		}
 
-		pSteamUtils = g_SteamAPIContext.m_pSteamUtils;
+		Steam_SetGlobalAPIContext(&Context);
+
+		pSteamUtils = SteamUtils();
 	}
 
 	// Try to retreive current app id
@@ -170,7 +235,7 @@ bool SteamAPI_InitInternal(bool safe)
 	}
 
 	// If the steam app id weren't set already, we have to set it now
-	if (!GetEnvironmentVariableA("SteamAppId", nullptr, NULL))
+	if (!Steam_GetEnvironmentVariable("SteamAppId", nullptr, NULL))
 	{
 		snprintf(SteamAPPId, sizeof(SteamAPPId), "%u", AppID);
 		SteamAPPId[sizeof(SteamAPPId) - 1] = '\0';
@@ -182,8 +247,14 @@ bool SteamAPI_InitInternal(bool safe)
 
 	CallbackMgr_RegisterInterfaceFuncs(g_hSteamClientModule);
 
+	// Modules are ready to be used from here on
+	if (bPreload)
+		Steam_JoinPreloads();
+
 	Steam_LoadMinidumpInterface();
-	Steam_LoadGameOverlayRenderer();
+
+	if (bLoadOverlay)
+		Steam_LoadGameOverlayRenderer();
 
 	if (safe != false)
 	{
@@ -194,12 +265,22 @@ bool SteamAPI_InitInternal(bool safe)
 	}
 	else
 	{
-		if (g_SteamAPIContext.m_pSteamUser)
-			Steam_SetMinidumpSteamID(g_SteamAPIContext.m_pSteamUser->GetSteamID().ConvertToUint64());
+		pSteamUser = SteamUser();
+
+		if (pSteamUser)
+			Steam_SetMinidumpSteamID(pSteamUser->GetSteamID().ConvertToUint64());
 		else
 			Steam_SetMinidumpSteamID(0);
 	}
 
+	auto Elapsed = std::chrono::steady_clock::now() - Start;
+
+	{
+		std::lock_guard<std::mutex> Lock(s_GameOverlayLock);
+
+		s_SteamInitReport.m_nInitMicroseconds = std::chrono::duration_cast<std::chrono::microseconds>(Elapsed).count();
+	}
+
 	return true;
 }
 
@@ -210,29 +291,45 @@ bool SteamAPI_InitInternal(bool safe)
 //			(current active) path.
 // 
 // Note:	Also, g_szSteamClientPath is set upon calling ConfigureSteamClientPath()
-//			if wasn't already.
+//			if wasn't already. When STEAMCLIENT_MODULE_OVERRIDE_ENV is set, that
+//			module is loaded instead and Steam doesn't have to be running.
 //-----------------------------------------------------------------------------
 ISteamClient* SteamAPI_Init_Internal(HMODULE* SteamModule, bool TryLocal)
 {
-	char SteamClientPath[MAX_PATH];
-	char DebugBuffer[1024];
+	char	SteamClientPath[MAX_PATH];
+	char	DebugBuffer[1024];
+	DWORD	dwOverrideLength;
 
 	if (!SteamModule)
 		return false;
 
-	*g_szSteamClientPath = '\0';
 	*SteamClientPath = '\0';
 
 	memset(SteamClientPath + 1, NULL, sizeof(SteamClientPath) - 1);
 
+	dwOverrideLength = Steam_GetEnvironmentVariable(STEAMCLIENT_MODULE_OVERRIDE_ENV, SteamClientPath, sizeof(SteamClientPath));
+
+	// Stand-in module, don't fall back to the real one if it can't be loaded
+	if (dwOverrideLength != NULL && dwOverrideLength < sizeof(SteamClientPath))
+	{
+		*SteamModule = Steam_LoadModule(SteamClientPath);
+
+		if (!*SteamModule)
+		{
+			snprintf(DebugBuffer, sizeof(DebugBuffer), "[S_API FAIL] SteamAPI_Init() failed; Steam_LoadModule failed to load override: %s\n", SteamClientPath);
+			DebugBuffer[sizeof(DebugBuffer) - 1] = '\0';
+			OutputDebugStringA(DebugBuffer);
+			return nullptr;
+		}
+	}
 	// Try to get online running instance of steam
-	if (ConfigureSteamClientPath(SteamClientPath, sizeof(SteamClientPath)))
+	else if (ConfigureSteamClientPath(SteamClientPath, sizeof(SteamClientPath)))
 	{
 		if (SteamAPI_IsSteamRunning())
 		{
 			*SteamModule = Steam_LoadModule(SteamClientPath);
 
-			if (!SteamModule)
+			if (!*SteamModule)
 			{
 				snprintf(DebugBuffer, sizeof(DebugBuffer), "[S_API FAIL] SteamAPI_Init() failed; Steam_LoadModule failed to load: %s\n", SteamClientPath);
 				DebugBuffer[sizeof(DebugBuffer) - 1] = '\0';
@@ -254,6 +351,9 @@ ISteamClient* SteamAPI_Init_Internal(HMODULE* SteamModule, bool TryLocal)
 		if (!*SteamModule)
 		{
 			OutputDebugStringA("[S_API FAIL] SteamAPI_Init() failed; unable to locate a running instance of Steam, or a local steamclient.dll.\n");
+
+			// Steam may be started before the next attempt
+			Steam_InvalidateClientPaths();
 			return false;
 		}
 	}
@@ -266,8 +366,11 @@ ISteamClient* SteamAPI_Init_Internal(HMODULE* SteamModule, bool TryLocal)
 //-----------------------------------------------------------------------------
 void SteamAPI_Shutdown_Internal(HMODULE hSteamServerModule)
 {
+	// Failed init may still have modules being preloaded
+	Steam_JoinPreloads();
+
 	if (hSteamServerModule)
-		FreeLibrary(hSteamServerModule);
+		Steam_UnloadModule(hSteamServerModule);
 
 	Steam_ShutdownMinidumpInterface();
 }
@@ -279,180 +382,458 @@ void SteamAPI_Shutdown_Internal(HMODULE hSteamServerModule)
 //-----------------------------------------------------------------------------
 
 //-----------------------------------------------------------------------------
-// Purpose: Setups connection to the game server. Initialitzes global data
-//			for the game server internal API.
+// Purpose: Tells whoever follows initialization of the context about the stage
 //-----------------------------------------------------------------------------
-bool SteamGameServer_Init_Internal(uint32 unIP, uint16 usSteamPort, uint32 usGamePort, int usQueryPort, EServerMode eServerMode, const char* pchVersionString, bool bSafe)
+static void ReportGameServerInitStage(SteamGameServerContext_t *pContext, ESteamGameServerInitStage eStage)
+{
+	if (pContext->m_pfnInitProgress)
+		pContext->m_pfnInitProgress(eStage);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Initializes the game server of the context, which has all of its
+//			interfaces set up already.
+//-----------------------------------------------------------------------------
+static bool StartGameServerContext(SteamGameServerContext_t *pContext, uint32 usGamePort, int usQueryPort, const char* pchVersionString, bool bSafe)
 {
 	uint32	unFlags;
 	AppId_t	nGameAppId;
 
-	g_eGameServerMode = eServerMode;
+	unFlags = (pContext->m_eServerMode != eServerModeAuthenticationAndSecure) ? eServerModeInvalid : eServerModeAuthentication;
+
+	if (pContext->m_eServerMode == eServerModeNoAuthentication)
+		unFlags |= 32;
+
+	// Try to obtain game APP identification number, we need this for breakpad and
+	// game server initialization.
+	nGameAppId = pContext->m_pSteamGameServerUtils->GetAppID();
+
+	if (nGameAppId == k_uAppIdInvalid)
+		return false;
+
+	// Finally initialize game server by calling its internal API, if this fail, we have to return
+	if (!pContext->m_pSteamGameServer->InitGameServer(pContext->m_unIP, usGamePort, usQueryPort, unFlags, nGameAppId, pchVersionString))
+		return false;
+
+	// While in safe mode, we can clear these out, they aren't needed at this point
+	if (bSafe != false)
+	{
+		pContext->m_pSteamGameServer = nullptr;
+		pContext->m_pSteamGameServerUtils = nullptr;
+	}
+
+	// Load interfaces we need and exit
+	Steam_RegisterInterfaceFuncs(pContext->m_hModule);
+	SteamAPI_SetBreakpadAppID(nGameAppId);
+	Steam_LoadMinidumpInterface();
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Setups connection to the game server. Initializes the context with
+//			its own pipe, user and interfaces. steamclient module is shared by
+//			all contexts, it's loaded only once.
+//-----------------------------------------------------------------------------
+bool Steam_InitGameServerContext(SteamGameServerContext_t *pContext, uint32 unIP, uint16 usSteamPort, uint32 usGamePort, int usQueryPort, EServerMode eServerMode, const char* pchVersionString, bool bSafe)
+{
+	pContext->m_eServerMode = eServerMode;
+	pContext->m_unIP = unIP;
+	pContext->m_usSteamPort = usSteamPort;
 	
 	// Locate and setup steam game server module
-	g_pSteamClientGameServer = SteamAPI_Init_Internal(&g_hSteamGameServerModule, true);
+	ReportGameServerInitStage(pContext, k_ESteamGameServerInitLoadingModule);
 
-	if (!g_pSteamClientGameServer)
+	pContext->m_pSteamClient = SteamAPI_Init_Internal(&pContext->m_hModule, true);
+
+	if (!pContext->m_pSteamClient)
 		return false;
 
+	ReportGameServerInitStage(pContext, k_ESteamGameServerInitCreatingUser);
+
 	// Set the local IP and Port to bind to. This must be called before CreateLocalUser().
-	g_pSteamClientGameServer->SetLocalIPBinding(unIP, usSteamPort);
+	pContext->m_pSteamClient->SetLocalIPBinding(unIP, usSteamPort);
 
 	// Create local user object for this server class object
-	g_hSteamGameServerUser = g_pSteamClientGameServer->CreateLocalUser(&g_hSteamGameServerPipe, k_EAccountTypeGameServer);
+	pContext->m_hSteamUser = pContext->m_pSteamClient->CreateLocalUser(&pContext->m_hSteamPipe, k_EAccountTypeGameServer);
 
-	if (!g_hSteamGameServerUser || !g_hSteamGameServerPipe)
+	if (!pContext->m_hSteamUser || !pContext->m_hSteamPipe)
 		return false;
 
+	ReportGameServerInitStage(pContext, k_ESteamGameServerInitFetchingInterfaces);
+
 	// Create game server object for us
-	g_pSteamGameServer = g_pSteamClientGameServer->GetISteamGameServer(g_hSteamGameServerUser, g_hSteamGameServerPipe, STEAMGAMESERVER_INTERFACE_VERSION);
+	pContext->m_pSteamGameServer = pContext->m_pSteamClient->GetISteamGameServer(pContext->m_hSteamUser, pContext->m_hSteamPipe, STEAMGAMESERVER_INTERFACE_VERSION);
 
-	if (!g_pSteamGameServer)
+	if (!pContext->m_pSteamGameServer)
 		return false;
 
 	// Create game server utility object
-	g_pSteamGameServerUtils = g_pSteamClientGameServer->GetISteamUtils(g_hSteamGameServerPipe, STEAMUTILS_INTERFACE_VERSION);
+	pContext->m_pSteamGameServerUtils = pContext->m_pSteamClient->GetISteamUtils(pContext->m_hSteamPipe, STEAMUTILS_INTERFACE_VERSION);
 
-	if (!g_pSteamGameServerUtils)
+	if (!pContext->m_pSteamGameServerUtils)
 		return false;
 
 	// Create game server app object
-	g_pSteamGameServerApps = g_pSteamClientGameServer->GetISteamApps(g_hSteamGameServerUser, g_hSteamGameServerPipe, STEAMAPPS_INTERFACE_VERSION);
+	pContext->m_pSteamGameServerApps = pContext->m_pSteamClient->GetISteamApps(pContext->m_hSteamUser, pContext->m_hSteamPipe, STEAMAPPS_INTERFACE_VERSION);
 
-	if (!g_pSteamGameServerApps)
+	if (!pContext->m_pSteamGameServerApps)
 		return false;
 
 	// Create game server HTTP object
-	g_pSteamGameServerHTTP = g_pSteamClientGameServer->GetISteamHTTP(g_hSteamGameServerUser, g_hSteamGameServerPipe, STEAMHTTP_INTERFACE_VERSION);
+	pContext->m_pSteamGameServerHTTP = pContext->m_pSteamClient->GetISteamHTTP(pContext->m_hSteamUser, pContext->m_hSteamPipe, STEAMHTTP_INTERFACE_VERSION);
 
-	if (!g_pSteamGameServerHTTP)
+	if (!pContext->m_pSteamGameServerHTTP)
 		return false;
 
 	// Networking and server stats have to be established in non-safe mode
 	if (bSafe != true)
 	{
 		// Create game server networking object
-		g_pSteamGameServerNetworking = g_pSteamClientGameServer->GetISteamNetworking(g_hSteamGameServerUser, g_hSteamGameServerPipe, STEAMNETWORKING_INTERFACE_VERSION);
+		pContext->m_pSteamGameServerNetworking = pContext->m_pSteamClient->GetISteamNetworking(pContext->m_hSteamUser, pContext->m_hSteamPipe, STEAMNETWORKING_INTERFACE_VERSION);
 
-		if (!g_pSteamGameServerNetworking)
+		if (!pContext->m_pSteamGameServerNetworking)
 			return false;
 
 		// Create game server stats object
-		g_pSteamGameServerStats = g_pSteamClientGameServer->GetISteamGameServerStats(g_hSteamGameServerUser, g_hSteamGameServerPipe, STEAMGAMESERVERSTATS_INTERFACE_VERSION);
+		pContext->m_pSteamGameServerStats = pContext->m_pSteamClient->GetISteamGameServerStats(pContext->m_hSteamUser, pContext->m_hSteamPipe, STEAMGAMESERVERSTATS_INTERFACE_VERSION);
 
-		if (!g_pSteamGameServerStats)
+		if (!pContext->m_pSteamGameServerStats)
 			return false;
 	}
 
-	unFlags = (g_eGameServerMode != eServerModeAuthenticationAndSecure) ? eServerModeInvalid : eServerModeAuthentication;
+	ReportGameServerInitStage(pContext, k_ESteamGameServerInitStartingServer);
 
-	if (g_eGameServerMode == eServerModeNoAuthentication)
-		unFlags |= 32;
+	return StartGameServerContext(pContext, usGamePort, usQueryPort, pchVersionString, bSafe);
+}
 
-	// Try to obtain game APP identification number, we need this for breakpad and
-	// game server initialization.
-	nGameAppId = g_pSteamGameServerUtils->GetAppID();
+//-----------------------------------------------------------------------------
+// Purpose: Releases user and pipe of the context. The module is left loaded,
+//			returns false if the context has no client to release them from.
+//-----------------------------------------------------------------------------
+bool Steam_ShutdownGameServerContext(SteamGameServerContext_t *pContext)
+{
+	if (pContext->m_pSteamGameServer && pContext->m_pSteamGameServer->BLoggedOn())
+		pContext->m_pSteamGameServer->LogOff();
 
-	if (nGameAppId == k_uAppIdInvalid)
+	if (!pContext->m_pSteamClient)
 		return false;
 
-	// Finally initialize game server by calling its internal API, if this fail, we have to return
-	if (!g_pSteamGameServer->InitGameServer(unIP, usGamePort, usQueryPort, unFlags, nGameAppId, pchVersionString))
+	if (pContext->m_hSteamPipe && pContext->m_hSteamUser)
+		pContext->m_pSteamClient->ReleaseUser(pContext->m_hSteamPipe, pContext->m_hSteamUser);
+
+	pContext->m_pSteamGameServer = nullptr;
+
+	// Pump thread must be done with the pipe before it's released, and its
+	// dispatch context is handed to the next pipe
+	if (pContext->m_hSteamPipe)
+		CallbackMgr_ReleasePipe(pContext->m_hSteamPipe);
+
+	if (pContext->m_hSteamPipe)
+		pContext->m_pSteamClient->BReleaseSteamPipe(pContext->m_hSteamPipe);
+
+	pContext->m_hSteamPipe = NULL;
+
+	// Other contexts keep their pipes open
+	pContext->m_pSteamClient->BShutdownIfAllPipesClosed();
+	pContext->m_pSteamClient = nullptr;
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Copies the global game server data into the context
+//-----------------------------------------------------------------------------
+void Steam_GetGameServerGlobals(SteamGameServerContext_t *pContext)
+{
+	pContext->m_eServerMode = g_eGameServerMode;
+	pContext->m_hModule = g_hSteamGameServerModule;
+	pContext->m_unIP = s_unGameServerIP;
+	pContext->m_usSteamPort = s_usGameServerSteamPort;
+	pContext->m_pSteamClient = g_pSteamClientGameServer;
+	pContext->m_hSteamPipe = g_hSteamGameServerPipe;
+	pContext->m_hSteamUser = g_hSteamGameServerUser;
+	pContext->m_pSteamGameServer = g_pSteamGameServer;
+	pContext->m_pSteamGameServerUtils = g_pSteamGameServerUtils;
+	pContext->m_pSteamGameServerApps = g_pSteamGameServerApps;
+	pContext->m_pSteamGameServerNetworking = g_pSteamGameServerNetworking;
+	pContext->m_pSteamGameServerStats = g_pSteamGameServerStats;
+	pContext->m_pSteamGameServerHTTP = g_pSteamGameServerHTTP;
+	pContext->m_pfnInitProgress = nullptr;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Makes the context the one used by the global game server API
+//-----------------------------------------------------------------------------
+void Steam_SetGameServerGlobals(const SteamGameServerContext_t *pContext)
+{
+	g_eGameServerMode = pContext->m_eServerMode;
+	g_hSteamGameServerModule = pContext->m_hModule;
+	s_unGameServerIP = pContext->m_unIP;
+	s_usGameServerSteamPort = pContext->m_usSteamPort;
+	g_pSteamClientGameServer = pContext->m_pSteamClient;
+	g_hSteamGameServerPipe = pContext->m_hSteamPipe;
+	g_hSteamGameServerUser = pContext->m_hSteamUser;
+	g_pSteamGameServer = pContext->m_pSteamGameServer;
+	g_pSteamGameServerUtils = pContext->m_pSteamGameServerUtils;
+	g_pSteamGameServerApps = pContext->m_pSteamGameServerApps;
+	g_pSteamGameServerNetworking = pContext->m_pSteamGameServerNetworking;
+	g_pSteamGameServerStats = pContext->m_pSteamGameServerStats;
+	g_pSteamGameServerHTTP = pContext->m_pSteamGameServerHTTP;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Setups connection to the game server. Initialitzes global data
+//			for the game server internal API.
+//-----------------------------------------------------------------------------
+bool SteamGameServer_Init_Internal(uint32 unIP, uint16 usSteamPort, uint32 usGamePort, int usQueryPort, EServerMode eServerMode, const char* pchVersionString, bool bSafe)
+{
+	SteamGameServerContext_t	Context;
+	bool						bResult;
+
+	Steam_GetGameServerGlobals(&Context);
+
+	if (Steam_TakeParkedGameServerContext(&Context, unIP, usSteamPort, bSafe))
+		bResult = Steam_RestartGameServerContext(&Context, usGamePort, usQueryPort, eServerMode, pchVersionString);
+	else
+		bResult = Steam_InitGameServerContext(&Context, unIP, usSteamPort, usGamePort, usQueryPort, eServerMode, pchVersionString, bSafe);
+
+	// Published even when failed, shutdown releases what was set up
+	Steam_SetGameServerGlobals(&Context);
+
+	return bResult;
+}
+
+//-----------------------------------------------------------------------------
+// 
+// Steam game server warm restart
+// 
+//-----------------------------------------------------------------------------
+
+// Game server kept around by the last shutdown, valid when it has a client
+static SteamGameServerContext_t	s_ParkedGameServer;
+static bool						s_bGameServerWarmRestart = false;
+static std::mutex				s_ParkedGameServerLock;
+
+//-----------------------------------------------------------------------------
+// Purpose: Shuts down the parked game server for good. Caller holds the lock.
+//-----------------------------------------------------------------------------
+static void ReleaseParkedGameServer()
+{
+	if (!s_ParkedGameServer.m_pSteamClient)
+		return;
+
+	if (Steam_ShutdownGameServerContext(&s_ParkedGameServer) && s_ParkedGameServer.m_hModule)
+		SteamAPI_Shutdown_Internal(s_ParkedGameServer.m_hModule);
+
+	s_ParkedGameServer = SteamGameServerContext_t();
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Enables or disables parking the game server on shutdown
+//-----------------------------------------------------------------------------
+void Steam_SetGameServerWarmRestart(bool bEnabled)
+{
+	std::lock_guard<std::mutex> Lock(s_ParkedGameServerLock);
+
+	s_bGameServerWarmRestart = bEnabled;
+
+	if (!bEnabled)
+		ReleaseParkedGameServer();
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Logs the game server of the context off and keeps the rest of it
+//			for the next init. Returns false if it has to be shut down instead.
+//-----------------------------------------------------------------------------
+bool Steam_ParkGameServerContext(const SteamGameServerContext_t *pContext)
+{
+	std::lock_guard<std::mutex> Lock(s_ParkedGameServerLock);
+
+	if (!s_bGameServerWarmRestart)
 		return false;
 
-	// While in safe mode, we can clear these out, they aren't needed at this point
-	if (bSafe != false)
+	// Safe mode doesn't keep the game server interface, there is nothing to restart
+	if (!pContext->m_pSteamClient || !pContext->m_pSteamGameServer || !pContext->m_hSteamUser)
+		return false;
+
+	// Only one can be kept around
+	ReleaseParkedGameServer();
+
+	if (pContext->m_pSteamGameServer->BLoggedOn())
+		pContext->m_pSteamGameServer->LogOff();
+
+	// Nothing of this session may reach listeners of the next one
+	CallbackMgr_DiscardPipeMessages(pContext->m_hSteamPipe);
+
+	s_ParkedGameServer = *pContext;
+	s_ParkedGameServer.m_pfnInitProgress = nullptr;
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Hands the parked game server over to the context, if it was set up
+//			with the same local binding. Parked one that doesn't fit is shut 
+//			down, returns false then and when there's none.
+//-----------------------------------------------------------------------------
+bool Steam_TakeParkedGameServerContext(SteamGameServerContext_t *pContext, uint32 unIP, uint16 usSteamPort, bool bSafe)
+{
+	void (*pfnInitProgress)(ESteamGameServerInitStage eStage);
+
+	std::lock_guard<std::mutex> Lock(s_ParkedGameServerLock);
+
+	if (!s_ParkedGameServer.m_pSteamClient)
+		return false;
+
+	if (bSafe || s_ParkedGameServer.m_unIP != unIP || s_ParkedGameServer.m_usSteamPort != usSteamPort)
 	{
-		g_pSteamGameServer = nullptr;
-		g_pSteamGameServerUtils = nullptr;
+		ReleaseParkedGameServer();
+		return false;
 	}
 
-	// Load interfaces we need and exit
-	Steam_RegisterInterfaceFuncs(g_hSteamGameServerModule);
-	SteamAPI_SetBreakpadAppID(nGameAppId);
-	Steam_LoadMinidumpInterface();
+	// Received while parked, e.g. the response to the log off
+	CallbackMgr_DiscardPipeMessages(s_ParkedGameServer.m_hSteamPipe);
+
+	pfnInitProgress = pContext->m_pfnInitProgress;
+
+	*pContext = s_ParkedGameServer;
+	pContext->m_pfnInitProgress = pfnInitProgress;
+
+	s_ParkedGameServer = SteamGameServerContext_t();
 
 	return true;
 }
 
+//-----------------------------------------------------------------------------
+// Purpose: Initializes the game server of a context taken from the parked one
+//			again, with the new parameters.
+//-----------------------------------------------------------------------------
+bool Steam_RestartGameServerContext(SteamGameServerContext_t *pContext, uint32 usGamePort, int usQueryPort, EServerMode eServerMode, const char* pchVersionString)
+{
+	pContext->m_eServerMode = eServerMode;
+
+	ReportGameServerInitStage(pContext, k_ESteamGameServerInitStartingServer);
+
+	return StartGameServerContext(pContext, usGamePort, usQueryPort, pchVersionString, false);
+}
+
 //-----------------------------------------------------------------------------
 // 
 // Minidump internal API
 // 
 //-----------------------------------------------------------------------------
 
+// Initialization routines of either module, looked up with the rest of them
+static pfnSteamClientMiniDumpInit_t	s_pfnSteamClientMiniDumpInit = nullptr;
+static pfnSteamMiniDumpInit_t		s_pfnSteamMiniDumpInit = nullptr;
+
+// Set once the initialization routine was called for the bound module
+static std::atomic<bool>			s_bMinidumpInterfaceInitialized(false);
+
+// Breakpad interface of steamclient.dll
+static SteamSymbol_t s_rgSteamClientMinidumpSymbols[] =
+{
+	{ "Breakpad_SteamWriteMiniDumpUsingExceptionInfoWithBuildId",	reinterpret_cast<void**>(&s_pfnSteamMiniDumpFn) },
+	{ "Breakpad_SteamWriteMiniDumpSetComment",						reinterpret_cast<void**>(&s_pfnSteamWriteMiniDumpSetComment) },
+	{ "Breakpad_SteamSetSteamID",									reinterpret_cast<void**>(&s_pfnSteamSetSteamID) },
+	{ "Breakpad_SteamSetAppID",										reinterpret_cast<void**>(&s_pfnSteamSetAppID) },
+	{ "Breakpad_SteamMiniDumpInit",									reinterpret_cast<void**>(&s_pfnSteamClientMiniDumpInit) },
+};
+
+// Minidump interface of steam.dll, it has no steam id and app id routines
+static SteamSymbol_t s_rgSteamMinidumpSymbols[] =
+{
+	{ "SteamWriteMiniDumpUsingExceptionInfoWithBuildId",			reinterpret_cast<void**>(&s_pfnSteamMiniDumpFn) },
+	{ "SteamWriteMiniDumpSetComment",								reinterpret_cast<void**>(&s_pfnSteamWriteMiniDumpSetComment) },
+	{ "SteamMiniDumpInit",											reinterpret_cast<void**>(&s_pfnSteamMiniDumpInit) },
+};
+
+static SteamSymbolTable_t s_SteamClientMinidumpSymbols = { "steamclient", s_rgSteamClientMinidumpSymbols, Q_ARRAYSIZE(s_rgSteamClientMinidumpSymbols) };
+static SteamSymbolTable_t s_SteamMinidumpSymbols = { "steam", s_rgSteamMinidumpSymbols, Q_ARRAYSIZE(s_rgSteamMinidumpSymbols) };
+
 //-----------------------------------------------------------------------------
-// Purpose: Tries to locate all routines from the minidump interface API exposed
-//			by either the steam.dll or steamclient.dll module.
+// Purpose: Loads either steam.dll or steamclient.dll module and binds the 
+//			minidump interface API routines exposed by it. Returns false if the
+//			module couldn't be loaded.
 //-----------------------------------------------------------------------------
-void Steam_LoadMinidumpInterface()
+static bool Steam_ResolveMinidumpInterface()
 {
-	pfnSteamClientMiniDumpInit_t	pfnSteamClientMiniDumpInit;
-	pfnSteamMiniDumpInit_t			pfnSteamMiniDumpInit;
-	HMODULE							hSteamModule;
-
 	// Try this first for steamclient.dll and if we fail, try steam.dll
 	if (s_BreakpadInfo != STEAM_BREAKPAD_STEAM)
 	{
+		if (Steam_IsSymbolTableBound(&s_SteamClientMinidumpSymbols))
+			return true;
+
 		g_MiniDumpSteamClientDllModule.Load();
-		hSteamModule = g_MiniDumpSteamClientDllModule.m_hModule;
 
-		if (!hSteamModule)
-			return;
+		if (!g_MiniDumpSteamClientDllModule.m_hModule)
+			return false;
 
 		printf("Looking up breakpad interfaces from steamclient\n");
 
-		// Breakpad_SteamWriteMiniDumpUsingExceptionInfoWithBuildId
-		s_pfnSteamMiniDumpFn = reinterpret_cast<pfnSteamMiniDumpFn_t>(GetProcAddress(hSteamModule, "Breakpad_SteamWriteMiniDumpUsingExceptionInfoWithBuildId"));
+		return Steam_BindSymbols(&s_SteamClientMinidumpSymbols, g_MiniDumpSteamClientDllModule.m_hModule);
+	}
+	// Try to load from steam.dll
+	else
+	{
+		if (Steam_IsSymbolTableBound(&s_SteamMinidumpSymbols))
+			return true;
 
-		// Breakpad_SteamWriteMiniDumpSetComment
-		s_pfnSteamWriteMiniDumpSetComment = reinterpret_cast<pfnSteamWriteMiniDumpSetComment_t>(GetProcAddress(hSteamModule, "Breakpad_SteamWriteMiniDumpSetComment"));
+		g_MiniDumpSteamDllModule.Load();
 
-		// Breakpad_SteamSetSteamID
-		s_pfnSteamSetSteamID = reinterpret_cast<pfnSteamSetSteamID_t>(GetProcAddress(hSteamModule, "Breakpad_SteamSetSteamID"));
+		if (!g_MiniDumpSteamDllModule.m_hModule)
+			return false;
+
+		return Steam_BindSymbols(&s_SteamMinidumpSymbols, g_MiniDumpSteamDllModule.m_hModule);
+	}
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Binds the minidump interface ahead of Steam_LoadMinidumpInterface(),
+//			run by the module preloader.
+//-----------------------------------------------------------------------------
+void Steam_PreloadMinidumpInterface()
+{
+	Steam_ResolveMinidumpInterface();
+}
 
-		// Breakpad_SteamSetAppID
-		s_pfnSteamSetAppID = reinterpret_cast<pfnSteamSetAppID_t>(GetProcAddress(hSteamModule, "Breakpad_SteamSetAppID"));
+//-----------------------------------------------------------------------------
+// Purpose: Tries to locate all routines from the minidump interface API exposed
+//			by either the steam.dll or steamclient.dll module and initializes it.
+//			Does nothing once the interface was initialized.
+//-----------------------------------------------------------------------------
+void Steam_LoadMinidumpInterface()
+{
+	if (s_bMinidumpInterfaceInitialized.load(std::memory_order_acquire))
+		return;
 
-		// Breakpad_SteamMiniDumpInit
-		pfnSteamClientMiniDumpInit = reinterpret_cast<pfnSteamClientMiniDumpInit_t>(GetProcAddress(hSteamModule, "Breakpad_SteamMiniDumpInit"));
+	if (!Steam_ResolveMinidumpInterface())
+		return;
 
-		if (pfnSteamClientMiniDumpInit)
+	if (s_BreakpadInfo != STEAM_BREAKPAD_STEAM)
+	{
+		if (s_pfnSteamClientMiniDumpInit)
 		{
 			printf("Calling BreakpadMiniDumpSystemInit\n");
-			pfnSteamClientMiniDumpInit(g_BreakpadLastAppId,
-									   g_pchBreakpadVersion,
-									   g_szBreakpadTimestamp,
-									   g_bBreakpadFullMemoryDumps,
-									   g_pvBreakpadContext,
-									   g_pfnBreakpadPreMinidumpCallback);
+			s_pfnSteamClientMiniDumpInit(g_BreakpadLastAppId,
+										 g_pchBreakpadVersion,
+										 g_szBreakpadTimestamp,
+										 g_bBreakpadFullMemoryDumps,
+										 g_pvBreakpadContext,
+										 g_pfnBreakpadPreMinidumpCallback);
 
 			if (g_SteamMinidumpSID)
 				Steam_SetMinidumpSteamID(g_SteamMinidumpSID);
 		}
 	}
-	// Try to load from steam.dll
 	else
 	{
-		g_MiniDumpSteamDllModule.Load();
-		hSteamModule = g_MiniDumpSteamDllModule.m_hModule;
-
-		if (!hSteamModule)
-			return;
-
-		// SteamWriteMiniDumpUsingExceptionInfoWithBuildId
-		s_pfnSteamMiniDumpFn = reinterpret_cast<pfnSteamMiniDumpFn_t>(GetProcAddress(hSteamModule, "SteamWriteMiniDumpUsingExceptionInfoWithBuildId"));
-
-		// SteamWriteMiniDumpSetComment
-		s_pfnSteamWriteMiniDumpSetComment = reinterpret_cast<pfnSteamWriteMiniDumpSetComment_t>(GetProcAddress(hSteamModule, "SteamWriteMiniDumpUsingExceptionInfoWithBuildId"));
-
-		s_pfnSteamSetSteamID = nullptr;
-
-		pfnSteamMiniDumpInit = reinterpret_cast<pfnSteamMiniDumpInit_t>(GetProcAddress(hSteamModule, "SteamMiniDumpInit"));
-
-		if (pfnSteamMiniDumpInit)
-			pfnSteamMiniDumpInit();
+		if (s_pfnSteamMiniDumpInit)
+			s_pfnSteamMiniDumpInit();
 	}
+
+	s_bMinidumpInterfaceInitialized.store(true, std::memory_order_release);
 }
 
 //-----------------------------------------------------------------------------
@@ -464,8 +845,10 @@ void Steam_LoadMinidumpInterface()
 //-----------------------------------------------------------------------------
 void Steam_ShutdownMinidumpInterface()
 {
-	s_pfnSteamMiniDumpFn = nullptr;
-	s_pfnSteamWriteMiniDumpSetComment = nullptr;
+	Steam_UnbindSymbols(&s_SteamClientMinidumpSymbols);
+	Steam_UnbindSymbols(&s_SteamMinidumpSymbols);
+
+	s_bMinidumpInterfaceInitialized.store(false, std::memory_order_release);
 
 	if (s_BreakpadInfo != STEAM_BREAKPAD_STEAM)
 	{
@@ -476,7 +859,7 @@ void Steam_ShutdownMinidumpInterface()
 		if (!g_MiniDumpSteamClientDllModule.m_hModule)
 			return;
 
-		FreeLibrary(g_MiniDumpSteamClientDllModule.m_hModule);
+		Steam_UnloadModule(g_MiniDumpSteamClientDllModule.m_hModule);
 		g_MiniDumpSteamClientDllModule.m_hModule = nullptr;
 	}
 	else
@@ -488,7 +871,7 @@ void Steam_ShutdownMinidumpInterface()
 		if (!g_MiniDumpSteamDllModule.m_hModule)
 			return;
 
-		FreeLibrary(g_MiniDumpSteamDllModule.m_hModule);
+		Steam_UnloadModule(g_MiniDumpSteamDllModule.m_hModule);
 		g_MiniDumpSteamDllModule.m_hModule = nullptr;
 	}
 }
@@ -500,30 +883,94 @@ void Steam_ShutdownMinidumpInterface()
 //-----------------------------------------------------------------------------
 
 //-----------------------------------------------------------------------------
-// Purpose: Tries to load steam overlay renderer library. Also if the steam client
-//			path is invalid or hasn't been set yet, the function calls subroutine
-//			ConfigureSteamClientPath() which setups path to the steam client dll.
+// Purpose: Builds path of the overlay renderer inside steam client directory
+//-----------------------------------------------------------------------------
+static void Steam_GetGameOverlayRendererPath(char *pszPath, size_t cubPath)
+{
+	snprintf(pszPath, cubPath, "%s%c%s", Steam_GetClientPaths()->m_szClientDirectory, PLATFORM_SLASH, k_pszSteamGameOverlayRendererModuleName);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Tries to load steam overlay renderer library from the steam client
+//			directory, unless it's loaded already.
 //-----------------------------------------------------------------------------
 bool Steam_LoadGameOverlayRenderer()
 {
 	char szGameOverlayRendererPath[MAX_PATH];
 
-	g_hSteamGameOverlayRendererModule = GetModuleHandleA(k_pszSteamGameOverlayRendererModuleName);
+	std::lock_guard<std::mutex> Lock(s_GameOverlayLock);
+
+	g_hSteamGameOverlayRendererModule = Steam_GetLoadedModule(k_pszSteamGameOverlayRendererModuleName);
 
 	// If the module was loaded already before, we don't have to load it again
 	if (g_hSteamGameOverlayRendererModule)
+	{
+		s_SteamInitReport.m_bOverlayLoaded = true;
+		s_SteamInitReport.m_cubOverlayImage = Steam_GetModuleImageSize(g_hSteamGameOverlayRendererModule);
 		return true;
-
-	// Have to look for steam client path if this hasn't been done already
-	ConfigureSteamClientPath(nullptr, NULL);
+	}
 
 	// Append GOR module name to steam directory and try to load the module
-	snprintf(szGameOverlayRendererPath, sizeof(szGameOverlayRendererPath), "%s\\%s", g_szSteamClientPath, k_pszSteamGameOverlayRendererModuleName);
+	Steam_GetGameOverlayRendererPath(szGameOverlayRendererPath, sizeof(szGameOverlayRendererPath));
+
+	auto Start = std::chrono::steady_clock::now();
 
 	g_hSteamGameOverlayRendererModule = Steam_LoadModule(szGameOverlayRendererPath);
 
+	auto Elapsed = std::chrono::steady_clock::now() - Start;
+
 	if (g_hSteamGameOverlayRendererModule)
+	{
+		s_SteamInitReport.m_bOverlayLoaded = true;
+		s_SteamInitReport.m_nOverlayLoadMicroseconds = std::chrono::duration_cast<std::chrono::microseconds>(Elapsed).count();
+		s_SteamInitReport.m_cubOverlayImage = Steam_GetModuleImageSize(g_hSteamGameOverlayRendererModule);
 		return true;
+	}
 
 	return false;
 }
+
+//-----------------------------------------------------------------------------
+// Purpose: Loads the overlay renderer that initialization left out because of
+//			k_ESteamAPIInitDeferOverlay. Headless initialization never loads it.
+//-----------------------------------------------------------------------------
+bool Steam_LoadDeferredGameOverlayRenderer()
+{
+	uint32 unFlags;
+
+	// Init rewrites the report under the lock
+	{
+		std::lock_guard<std::mutex> Lock(s_GameOverlayLock);
+
+		unFlags = s_SteamInitReport.m_unFlags;
+	}
+
+	if (!g_pSteamClient || (unFlags & k_ESteamAPIInitHeadless))
+		return false;
+
+	return Steam_LoadGameOverlayRenderer();
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Copies out the initialization report. Size of the overlay renderer
+//			module file is filled in while it isn't loaded.
+//-----------------------------------------------------------------------------
+void Steam_GetInitReport(SteamInitReport_t *pReport)
+{
+	char		szGameOverlayRendererPath[MAX_PATH];
+	struct stat	FileInfo;
+
+	{
+		std::lock_guard<std::mutex> Lock(s_GameOverlayLock);
+
+		*pReport = s_SteamInitReport;
+	}
+
+	if (pReport->m_bOverlayLoaded || !g_pSteamClient)
+		return;
+
+	Steam_GetGameOverlayRendererPath(szGameOverlayRendererPath, sizeof(szGameOverlayRendererPath));
+
+	if (stat(szGameOverlayRendererPath, &FileInfo) == 0)
+		pReport->m_cubOverlayNotLoaded = FileInfo.st_size;
+}
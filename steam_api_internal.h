@@ -8,6 +8,8 @@
 #define STEAM_API_INTERNAL_H
 #pragma once
 
+#include "steam_api_ext.h"
+
 //-----------------------------------------------------------------------------
 // Purpose: This is used by the internal steam api code.
 //-----------------------------------------------------------------------------
@@ -65,6 +67,8 @@ extern HMODULE			g_hSteamGameOverlayRendererModule;
 
 extern bool				g_bCatchExceptionsInCallbacks;
 
+extern uint32			g_unSteamAPIInitFlags;
+
 //-----------------------------------------------------------------------------
 // Purpose: Module names that the SteamAPI module accesses
 //-----------------------------------------------------------------------------
@@ -132,6 +136,35 @@ extern EServerMode g_eGameServerMode;
 
 extern HMODULE g_hSteamGameServerModule;
 
+//-----------------------------------------------------------------------------
+// Purpose: Everything one game server is set up with. The global game server
+//			API uses the one kept in the globals above, instances created by
+//			SteamGameServer_CreateInstance() each have their own.
+//-----------------------------------------------------------------------------
+struct SteamGameServerContext_t
+{
+	EServerMode				m_eServerMode;
+	HMODULE					m_hModule;
+
+	// Local binding the user was created with
+	uint32					m_unIP;
+	uint16					m_usSteamPort;
+
+	ISteamClient*			m_pSteamClient;
+	HSteamPipe				m_hSteamPipe;
+	HSteamUser				m_hSteamUser;
+
+	ISteamGameServer*		m_pSteamGameServer;
+	ISteamUtils*			m_pSteamGameServerUtils;
+	ISteamApps*				m_pSteamGameServerApps;
+	ISteamNetworking*		m_pSteamGameServerNetworking;
+	ISteamGameServerStats*	m_pSteamGameServerStats;
+	ISteamHTTP*				m_pSteamGameServerHTTP;
+
+	// Told about every stage Steam_InitGameServerContext() enters, if set
+	void					(*m_pfnInitProgress)(ESteamGameServerInitStage eStage);
+};
+
 //-----------------------------------------------------------------------------
 // 
 // Exported API declaration
@@ -234,7 +267,8 @@ inline void CSteamAPIContext::Clear()
 
 //-----------------------------------------------------------------------------
 // Purpose: This function must be inlined so the module using steam_api.dll 
-//			gets the version names they want.
+//			gets the version names they want. Interfaces come from the process
+//			wide cache, other modules asking for the same versions reuse them.
 //-----------------------------------------------------------------------------
 inline bool CSteamAPIContext::Init()
 {
@@ -244,47 +278,47 @@ inline bool CSteamAPIContext::Init()
 	HSteamUser hSteamUser = SteamAPI_GetHSteamUser();
 	HSteamPipe hSteamPipe = SteamAPI_GetHSteamPipe();
 
-	m_pSteamUser = SteamClient()->GetISteamUser(hSteamUser, hSteamPipe, STEAMUSER_INTERFACE_VERSION);
+	m_pSteamUser = static_cast<ISteamUser*>(SteamAPI_GetCachedInterface(k_ESteamInterfaceUser, hSteamUser, hSteamPipe, STEAMUSER_INTERFACE_VERSION));
 	if (!m_pSteamUser)
 		return false;
 
-	m_pSteamFriends = SteamClient()->GetISteamFriends(hSteamUser, hSteamPipe, STEAMFRIENDS_INTERFACE_VERSION);
+	m_pSteamFriends = static_cast<ISteamFriends*>(SteamAPI_GetCachedInterface(k_ESteamInterfaceFriends, hSteamUser, hSteamPipe, STEAMFRIENDS_INTERFACE_VERSION));
 	if (!m_pSteamFriends)
 		return false;
 
-	m_pSteamUtils = SteamClient()->GetISteamUtils(hSteamPipe, STEAMUTILS_INTERFACE_VERSION);
+	m_pSteamUtils = static_cast<ISteamUtils*>(SteamAPI_GetCachedInterface(k_ESteamInterfaceUtils, hSteamUser, hSteamPipe, STEAMUTILS_INTERFACE_VERSION));
 	if (!m_pSteamUtils)
 		return false;
 
-	m_pSteamMatchmaking = SteamClient()->GetISteamMatchmaking(hSteamUser, hSteamPipe, STEAMMATCHMAKING_INTERFACE_VERSION);
+	m_pSteamMatchmaking = static_cast<ISteamMatchmaking*>(SteamAPI_GetCachedInterface(k_ESteamInterfaceMatchmaking, hSteamUser, hSteamPipe, STEAMMATCHMAKING_INTERFACE_VERSION));
 	if (!m_pSteamMatchmaking)
 		return false;
 
-	m_pSteamMatchmakingServers = SteamClient()->GetISteamMatchmakingServers(hSteamUser, hSteamPipe, STEAMMATCHMAKINGSERVERS_INTERFACE_VERSION);
+	m_pSteamMatchmakingServers = static_cast<ISteamMatchmakingServers*>(SteamAPI_GetCachedInterface(k_ESteamInterfaceMatchmakingServers, hSteamUser, hSteamPipe, STEAMMATCHMAKINGSERVERS_INTERFACE_VERSION));
 	if (!m_pSteamMatchmakingServers)
 		return false;
 
-	m_pSteamUserStats = SteamClient()->GetISteamUserStats(hSteamUser, hSteamPipe, STEAMUSERSTATS_INTERFACE_VERSION);
+	m_pSteamUserStats = static_cast<ISteamUserStats*>(SteamAPI_GetCachedInterface(k_ESteamInterfaceUserStats, hSteamUser, hSteamPipe, STEAMUSERSTATS_INTERFACE_VERSION));
 	if (!m_pSteamUserStats)
 		return false;
 
-	m_pSteamApps = SteamClient()->GetISteamApps(hSteamUser, hSteamPipe, STEAMAPPS_INTERFACE_VERSION);
+	m_pSteamApps = static_cast<ISteamApps*>(SteamAPI_GetCachedInterface(k_ESteamInterfaceApps, hSteamUser, hSteamPipe, STEAMAPPS_INTERFACE_VERSION));
 	if (!m_pSteamApps)
 		return false;
 
-	m_pSteamNetworking = SteamClient()->GetISteamNetworking(hSteamUser, hSteamPipe, STEAMNETWORKING_INTERFACE_VERSION);
+	m_pSteamNetworking = static_cast<ISteamNetworking*>(SteamAPI_GetCachedInterface(k_ESteamInterfaceNetworking, hSteamUser, hSteamPipe, STEAMNETWORKING_INTERFACE_VERSION));
 	if (!m_pSteamNetworking)
 		return false;
 
-	m_pSteamRemoteStorage = SteamClient()->GetISteamRemoteStorage(hSteamUser, hSteamPipe, STEAMREMOTESTORAGE_INTERFACE_VERSION);
+	m_pSteamRemoteStorage = static_cast<ISteamRemoteStorage*>(SteamAPI_GetCachedInterface(k_ESteamInterfaceRemoteStorage, hSteamUser, hSteamPipe, STEAMREMOTESTORAGE_INTERFACE_VERSION));
 	if (!m_pSteamRemoteStorage)
 		return false;
 
-	m_pSteamScreenshots = SteamClient()->GetISteamScreenshots(hSteamUser, hSteamPipe, STEAMSCREENSHOTS_INTERFACE_VERSION);
+	m_pSteamScreenshots = static_cast<ISteamScreenshots*>(SteamAPI_GetCachedInterface(k_ESteamInterfaceScreenshots, hSteamUser, hSteamPipe, STEAMSCREENSHOTS_INTERFACE_VERSION));
 	if (!m_pSteamScreenshots)
 		return false;
 
-	m_pSteamHTTP = SteamClient()->GetISteamHTTP(hSteamUser, hSteamPipe, STEAMHTTP_INTERFACE_VERSION);
+	m_pSteamHTTP = static_cast<ISteamHTTP*>(SteamAPI_GetCachedInterface(k_ESteamInterfaceHTTP, hSteamUser, hSteamPipe, STEAMHTTP_INTERFACE_VERSION));
 	if (!m_pSteamHTTP)
 		return false;
 
@@ -295,7 +329,46 @@ inline bool CSteamAPIContext::Init()
 	return true;
 }
 
+// Slots are read by the accessors on any thread, see Steam_SetGlobalAPIContext()
 extern CSteamAPIContext g_SteamAPIContext;
+extern void Steam_SetGlobalAPIContext(const CSteamAPIContext *pContext);
+
+extern void Steam_ClearInterfaceCache();
+
+//-----------------------------------------------------------------------------
+// Purpose: Values kept by the getter cache, separately for the user and the 
+//			game server pipe
+//-----------------------------------------------------------------------------
+enum ESteamGetterValue
+{
+	k_ESteamGetterAppID,
+	k_ESteamGetterSteamID,
+	k_ESteamGetterLoggedOn,
+	k_ESteamGetterSecure,
+
+	k_ESteamGetterMax
+};
+
+extern bool Steam_IsGetterCacheEnabled();
+extern uint64 Steam_GetMemoizedValue(bool bGameServer, ESteamGetterValue eValue, uint64 (*pfnFetch)());
+extern void Steam_InvalidateGetterCache(bool bGameServer);
+
+//-----------------------------------------------------------------------------
+// Purpose: Wrap interfaces into IPC trace proxies, when tracing is enabled
+//-----------------------------------------------------------------------------
+extern ISteamUser* Steam_TraceInterface(ISteamUser *pInterface);
+extern ISteamFriends* Steam_TraceInterface(ISteamFriends *pInterface);
+extern ISteamUtils* Steam_TraceInterface(ISteamUtils *pInterface);
+extern ISteamMatchmaking* Steam_TraceInterface(ISteamMatchmaking *pInterface);
+extern ISteamMatchmakingServers* Steam_TraceInterface(ISteamMatchmakingServers *pInterface);
+extern ISteamUserStats* Steam_TraceInterface(ISteamUserStats *pInterface);
+extern ISteamApps* Steam_TraceInterface(ISteamApps *pInterface);
+extern ISteamNetworking* Steam_TraceInterface(ISteamNetworking *pInterface);
+extern ISteamRemoteStorage* Steam_TraceInterface(ISteamRemoteStorage *pInterface);
+extern ISteamScreenshots* Steam_TraceInterface(ISteamScreenshots *pInterface);
+extern ISteamGameServer* Steam_TraceInterface(ISteamGameServer *pInterface);
+extern ISteamGameServerStats* Steam_TraceInterface(ISteamGameServerStats *pInterface);
+extern ISteamHTTP* Steam_TraceInterface(ISteamHTTP *pInterface);
 
 //-----------------------------------------------------------------------------
 // 
@@ -417,8 +490,23 @@ extern void SteamAPI_Shutdown_Internal(HMODULE hSteamServerModule);
 // 
 //-----------------------------------------------------------------------------
 
+// Game servers set up by SteamGameServer_CreateInstance(), each with its own pipe
+#define MAX_GAMESERVER_INSTANCES	32
+
 extern bool SteamGameServer_Init_Internal(uint32 unIP, uint16 usSteamPort, uint32 usGamePort, int usQueryPort, EServerMode eServerMode, const char* pchVersionString, bool bSafe);
 
+extern bool Steam_InitGameServerContext(SteamGameServerContext_t *pContext, uint32 unIP, uint16 usSteamPort, uint32 usGamePort, int usQueryPort, EServerMode eServerMode, const char* pchVersionString, bool bSafe);
+extern bool Steam_ShutdownGameServerContext(SteamGameServerContext_t *pContext);
+extern void Steam_GetGameServerGlobals(SteamGameServerContext_t *pContext);
+extern void Steam_SetGameServerGlobals(const SteamGameServerContext_t *pContext);
+
+extern bool Steam_IsGameServerReady();
+
+extern void Steam_SetGameServerWarmRestart(bool bEnabled);
+extern bool Steam_ParkGameServerContext(const SteamGameServerContext_t *pContext);
+extern bool Steam_TakeParkedGameServerContext(SteamGameServerContext_t *pContext, uint32 unIP, uint16 usSteamPort, bool bSafe);
+extern bool Steam_RestartGameServerContext(SteamGameServerContext_t *pContext, uint32 usGamePort, int usQueryPort, EServerMode eServerMode, const char* pchVersionString);
+
 //-----------------------------------------------------------------------------
 // 
 // Minidump internal API
@@ -426,6 +514,7 @@ extern bool SteamGameServer_Init_Internal(uint32 unIP, uint16 usSteamPort, uint3
 //-----------------------------------------------------------------------------
 
 extern void Steam_LoadMinidumpInterface();
+extern void Steam_PreloadMinidumpInterface();
 extern void Steam_ShutdownMinidumpInterface();
 
 //-----------------------------------------------------------------------------
@@ -435,5 +524,8 @@ extern void Steam_ShutdownMinidumpInterface();
 //-----------------------------------------------------------------------------
 
 extern bool Steam_LoadGameOverlayRenderer();
+extern bool Steam_LoadDeferredGameOverlayRenderer();
+
+extern void Steam_GetInitReport(SteamInitReport_t *pReport);
 
 #endif
\ No newline at end of file
@@ -7,17 +7,28 @@
 
 #include "steam_api_pch.h"
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 //-----------------------------------------------------------------------------
 // 
 // Steam gameserver API
 // 
 //-----------------------------------------------------------------------------
 
+static bool BeginInitSync();
+
 //-----------------------------------------------------------------------------
 // Purpose: Setups game server API and data in a 'safe' way.
 //-----------------------------------------------------------------------------
 bool SteamGameServer_InitSafe(uint32 unIP, uint16 usSteamPort, uint16 usGamePort, uint16 usQueryPort, EServerMode eServerMode, const char *pchVersionString)
 {
+	// Worker of the asynchronous init is setting up the same globals
+	if (!BeginInitSync())
+		return false;
+
 	return SteamGameServer_Init_Internal(unIP, usSteamPort, usGamePort, usQueryPort, eServerMode, pchVersionString, true);
 }
 
@@ -26,39 +37,229 @@ bool SteamGameServer_InitSafe(uint32 unIP, uint16 usSteamPort, uint16 usGamePort
 //-----------------------------------------------------------------------------
 bool SteamGameServer_Init(uint32 unIP, uint16 usSteamPort, uint16 usGamePort, uint16 usQueryPort, EServerMode eServerMode, const char *pchVersionString)
 {
+	// Worker of the asynchronous init is setting up the same globals
+	if (!BeginInitSync())
+		return false;
+
 	return SteamGameServer_Init_Internal(unIP, usSteamPort, usGamePort, usQueryPort, eServerMode, pchVersionString, false);
 }
 
 //-----------------------------------------------------------------------------
-// Purpose: Shutsdown gameserver API
+// 
+// Steam gameserver asynchronous init
+// 
 //-----------------------------------------------------------------------------
-void SteamGameServer_Shutdown()
+
+// Parameters the worker initializes the game server with
+struct GameServerInitAsync_t
+{
+	uint32							m_unIP;
+	uint16							m_usSteamPort;
+	uint16							m_usGamePort;
+	uint16							m_usQueryPort;
+	EServerMode						m_eServerMode;
+	char							m_szVersionString[64];
+
+	SteamGameServerInitCompleted_t	m_pfnCompleted;
+	void*							m_pContext;
+};
+
+static std::atomic<ESteamGameServerInitStage>	s_eInitAsyncStage(k_ESteamGameServerInitNone);
+static std::thread::id							s_InitAsyncWorkerId;
+static bool										s_bInitAsyncRunning = false;
+static std::mutex								s_InitAsyncLock;
+static std::condition_variable					s_InitAsyncDone;
+
+//-----------------------------------------------------------------------------
+// Purpose: Progress routine of the context initialized by the worker
+//-----------------------------------------------------------------------------
+static void SetInitAsyncStage(ESteamGameServerInitStage eStage)
+{
+	s_eInitAsyncStage.store(eStage, std::memory_order_release);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Releases pipe, user and module of the context. Returns false and
+//			leaves it as it is if it has no client.
+//-----------------------------------------------------------------------------
+static bool ReleaseGameServerContext(SteamGameServerContext_t *pContext)
+{
+	if (!Steam_ShutdownGameServerContext(pContext))
+		return false;
+
+	Steam_InvalidateGetterCache(true);
+
+	if (pContext->m_hModule)
+		SteamAPI_Shutdown_Internal(pContext->m_hModule);
+
+	pContext->m_hModule = nullptr;
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Worker thread, initializes the game server and publishes it
+//-----------------------------------------------------------------------------
+static void InitAsyncWorker(GameServerInitAsync_t InitAsync)
+{
+	SteamGameServerContext_t	Context;
+	bool						bSuccess;
+
+	Steam_GetGameServerGlobals(&Context);
+	Context.m_pfnInitProgress = SetInitAsyncStage;
+
+	if (Steam_TakeParkedGameServerContext(&Context, InitAsync.m_unIP, InitAsync.m_usSteamPort, false))
+	{
+		bSuccess = Steam_RestartGameServerContext(&Context, InitAsync.m_usGamePort, InitAsync.m_usQueryPort, InitAsync.m_eServerMode, InitAsync.m_szVersionString);
+	}
+	else
+	{
+		bSuccess = Steam_InitGameServerContext(&Context, InitAsync.m_unIP, InitAsync.m_usSteamPort, InitAsync.m_usGamePort, InitAsync.m_usQueryPort, 
+											   InitAsync.m_eServerMode, InitAsync.m_szVersionString, false);
+	}
+
+	// Nothing is left half set up, so init can be retried without a shutdown
+	if (!bSuccess)
+		ReleaseGameServerContext(&Context);
+
+	Context.m_pfnInitProgress = nullptr;
+	Steam_SetGameServerGlobals(&Context);
+
+	SetInitAsyncStage(bSuccess ? k_ESteamGameServerInitSucceeded : k_ESteamGameServerInitFailed);
+
+	if (InitAsync.m_pfnCompleted)
+		InitAsync.m_pfnCompleted(bSuccess, InitAsync.m_pContext);
+
+	std::lock_guard<std::mutex> Lock(s_InitAsyncLock);
+
+	s_bInitAsyncRunning = false;
+	s_InitAsyncDone.notify_all();
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Called by the synchronous init. Returns false from 
+//			SteamGameServer_InitAsync() until the completion routine has 
+//			returned, otherwise clears the stage a failed worker left behind so
+//			the accessors aren't held back by it.
+//-----------------------------------------------------------------------------
+static bool BeginInitSync()
+{
+	std::lock_guard<std::mutex> Lock(s_InitAsyncLock);
+
+	if (s_bInitAsyncRunning)
+		return false;
+
+	SetInitAsyncStage(k_ESteamGameServerInitNone);
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Returns true if the game server globals can be read. They're set up
+//			by the worker of the asynchronous init without a lock, and only
+//			published once the stage is k_ESteamGameServerInitSucceeded.
+//-----------------------------------------------------------------------------
+bool Steam_IsGameServerReady()
+{
+	ESteamGameServerInitStage eStage;
+
+	eStage = s_eInitAsyncStage.load(std::memory_order_acquire);
+
+	// Not initialized asynchronously at all, or it's done
+	return eStage == k_ESteamGameServerInitNone || eStage == k_ESteamGameServerInitSucceeded;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Waits until the worker is done. Returns right away when called from 
+//			the completion routine.
+//-----------------------------------------------------------------------------
+static void WaitForInitAsync()
 {
-	if (g_pSteamGameServer && g_pSteamGameServer->BLoggedOn())
-		g_pSteamGameServer->LogOff();
+	std::unique_lock<std::mutex> Lock(s_InitAsyncLock);
 
-	if (!g_pSteamClientGameServer)
+	if (s_InitAsyncWorkerId == std::this_thread::get_id())
 		return;
 
-	if (g_hSteamGameServerPipe && g_hSteamGameServerUser)
-		g_pSteamClientGameServer->ReleaseUser(g_hSteamGameServerPipe, g_hSteamGameServerUser);
+	s_InitAsyncDone.wait(Lock, [] { return !s_bInitAsyncRunning; });
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Setups game server API and data on a worker thread.
+//-----------------------------------------------------------------------------
+bool SteamGameServer_InitAsync(uint32 unIP, uint16 usSteamPort, uint16 usGamePort, uint16 usQueryPort, EServerMode eServerMode, const char *pchVersionString, SteamGameServerInitCompleted_t pfnCompleted, void *pContext)
+{
+	GameServerInitAsync_t InitAsync;
+
+	InitAsync.m_unIP = unIP;
+	InitAsync.m_usSteamPort = usSteamPort;
+	InitAsync.m_usGamePort = usGamePort;
+	InitAsync.m_usQueryPort = usQueryPort;
+	InitAsync.m_eServerMode = eServerMode;
+	InitAsync.m_pfnCompleted = pfnCompleted;
+	InitAsync.m_pContext = pContext;
+
+	// Caller's string may be gone by the time the worker gets to it
+	strncpy(InitAsync.m_szVersionString, pchVersionString ? pchVersionString : "", sizeof(InitAsync.m_szVersionString));
+	InitAsync.m_szVersionString[sizeof(InitAsync.m_szVersionString) - 1] = '\0';
+
+	std::lock_guard<std::mutex> Lock(s_InitAsyncLock);
+
+	if (s_bInitAsyncRunning || g_pSteamClientGameServer)
+		return false;
+
+	// Accessors return nothing from now on, until the worker has succeeded
+	s_bInitAsyncRunning = true;
+	SetInitAsyncStage(k_ESteamGameServerInitLoadingModule);
+
+	// Not joined, shutdown waits for it through s_InitAsyncDone
+	std::thread Worker(InitAsyncWorker, InitAsync);
+	s_InitAsyncWorkerId = Worker.get_id();
+	Worker.detach();
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Returns how far the asynchronous initialization got
+//-----------------------------------------------------------------------------
+ESteamGameServerInitStage SteamGameServer_GetInitStage()
+{
+	return s_eInitAsyncStage.load(std::memory_order_acquire);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Shutsdown gameserver API
+//-----------------------------------------------------------------------------
+void SteamGameServer_Shutdown()
+{
+	SteamGameServerContext_t Context;
+
+	// Initialization still running on the worker has to finish first
+	WaitForInitAsync();
 
-	g_pSteamGameServer = nullptr;
+	SetInitAsyncStage(k_ESteamGameServerInitNone);
 
-	if (g_hSteamGameServerPipe)
-		g_pSteamClientGameServer->BReleaseSteamPipe(g_hSteamGameServerPipe);
+	Steam_GetGameServerGlobals(&Context);
 
-	g_hSteamGameServerPipe = NULL;
+	// Kept for warm restart, global API acts as if it was shut down
+	if (Steam_ParkGameServerContext(&Context))
+	{
+		Context = SteamGameServerContext_t();
+		Steam_SetGameServerGlobals(&Context);
 
-	if (g_pSteamClientGameServer)
-		g_pSteamClientGameServer->BShutdownIfAllPipesClosed();
+		Steam_InvalidateGetterCache(true);
+		return;
+	}
 
-	g_pSteamClientGameServer = nullptr;
+	ReleaseGameServerContext(&Context);
 
-	if (g_hSteamGameServerModule)
-		SteamAPI_Shutdown_Internal(g_hSteamGameServerModule);
+	Steam_SetGameServerGlobals(&Context);
+}
 
-	g_hSteamGameServerModule = nullptr;
+//-----------------------------------------------------------------------------
+// Purpose: Enables or disables keeping the game server around on shutdown
+//-----------------------------------------------------------------------------
+void SteamGameServer_SetWarmRestart(bool bEnabled)
+{
+	Steam_SetGameServerWarmRestart(bEnabled);
 }
 
 //-----------------------------------------------------------------------------
@@ -66,13 +267,27 @@ void SteamGameServer_Shutdown()
 //-----------------------------------------------------------------------------
 bool SteamGameServer_BSecure()
 {
+	if (!Steam_IsGameServerReady())
+		return false;
+
 	if (g_eGameServerMode == eServerModeNoAuthentication)
 		return false;
 
 	if (!g_pSteamGameServer)
 		return false;
 
-	return g_pSteamGameServer->BSecure();
+	return Steam_GetMemoizedValue(true, k_ESteamGetterSecure, [] () -> uint64 { return g_pSteamGameServer->BSecure(); }) != 0;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Returns true if the game server is logged on to steam servers
+//-----------------------------------------------------------------------------
+bool SteamGameServer_BLoggedOn()
+{
+	if (!Steam_IsGameServerReady() || !g_pSteamGameServer)
+		return false;
+
+	return Steam_GetMemoizedValue(true, k_ESteamGetterLoggedOn, [] () -> uint64 { return g_pSteamGameServer->BLoggedOn(); }) != 0;
 }
 
 //-----------------------------------------------------------------------------
@@ -81,7 +296,7 @@ bool SteamGameServer_BSecure()
 //-----------------------------------------------------------------------------
 uint32 SteamGameServer_GetIPCCallCount()
 {
-	if (!g_pSteamGameServerUtils)
+	if (!Steam_IsGameServerReady() || !g_pSteamGameServerUtils)
 		return NULL;
 
 	return g_pSteamGameServerUtils->GetIPCCallCount();
@@ -93,13 +308,267 @@ uint32 SteamGameServer_GetIPCCallCount()
 //-----------------------------------------------------------------------------
 uint64 SteamGameServer_GetSteamID()
 {
+	if (!Steam_IsGameServerReady())
+		return NULL;
+
 	if (g_eGameServerMode == eServerModeNoAuthentication)
 		return (1ull << (64 - 8));
 
 	if (!g_pSteamGameServer)
 		return NULL;
 
-	return g_pSteamGameServer->GetSteamID().ConvertToUint64();
+	return Steam_GetMemoizedValue(true, k_ESteamGetterSteamID, [] () -> uint64 { return g_pSteamGameServer->GetSteamID().ConvertToUint64(); });
+}
+
+//-----------------------------------------------------------------------------
+// 
+// Steam gameserver instances
+// 
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// Purpose: Slot of a game server instance. The slot stays taken until the 
+//			instance is torn down, a destroyed instance isn't found anymore
+//			but its context lives on while callbacks of it are running.
+//-----------------------------------------------------------------------------
+struct GameServerInstance_t
+{
+	SteamGameServerContext_t*	m_pContext;
+	int							m_cDispatches;
+	bool						m_bDestroyed;
+
+	// Destroyed from inside of its own callbacks, the dispatch tears it down
+	bool						m_bDestroyDeferred;
+};
+
+// Instance handle is the slot index plus one
+static GameServerInstance_t			s_rgGameServerInstances[MAX_GAMESERVER_INSTANCES];
+static std::mutex					s_GameServerInstancesLock;
+static std::condition_variable		s_GameServerInstanceIdle;
+
+// Instance the current thread is running callbacks of
+static thread_local HSteamGameServer t_hDispatchingGameServer = 0;
+
+// Setting up and tearing down instances goes through shared module state
+static std::mutex					s_GameServerSetupLock;
+
+//-----------------------------------------------------------------------------
+// Purpose: Releases everything the instance was set up with and frees it
+//-----------------------------------------------------------------------------
+static void DestroyGameServerContext(SteamGameServerContext_t *pContext)
+{
+	Steam_ShutdownGameServerContext(pContext);
+
+	// Dropping our reference only, other instances may still use the module
+	if (pContext->m_hModule)
+		Steam_UnloadModule(pContext->m_hModule);
+
+	delete pContext;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Tears down context of the instance and frees its slot
+//-----------------------------------------------------------------------------
+static void TeardownGameServerInstance(GameServerInstance_t *pInstance)
+{
+	{
+		std::lock_guard<std::mutex> SetupLock(s_GameServerSetupLock);
+
+		DestroyGameServerContext(pInstance->m_pContext);
+	}
+
+	std::lock_guard<std::mutex> Lock(s_GameServerInstancesLock);
+
+	pInstance->m_pContext = nullptr;
+	pInstance->m_bDestroyed = false;
+	pInstance->m_bDestroyDeferred = false;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Returns slot of the instance, nullptr if there's no such instance
+//			or it's being destroyed. Instances lock must be held.
+//-----------------------------------------------------------------------------
+static GameServerInstance_t* FindGameServerInstance(HSteamGameServer hInstance)
+{
+	GameServerInstance_t* pInstance;
+
+	if (hInstance <= 0 || hInstance > MAX_GAMESERVER_INSTANCES)
+		return nullptr;
+
+	pInstance = &s_rgGameServerInstances[hInstance - 1];
+
+	if (!pInstance->m_pContext || pInstance->m_bDestroyed)
+		return nullptr;
+
+	return pInstance;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Setups a game server with its own pipe and user, in addition to the
+//			one SteamGameServer_Init() setups.
+//-----------------------------------------------------------------------------
+HSteamGameServer SteamGameServer_CreateInstance(uint32 unIP, uint16 usSteamPort, uint16 usGamePort, uint16 usQueryPort, EServerMode eServerMode, const char *pchVersionString)
+{
+	SteamGameServerContext_t* pContext;
+
+	std::lock_guard<std::mutex> SetupLock(s_GameServerSetupLock);
+
+	pContext = new SteamGameServerContext_t();
+
+	if (!Steam_InitGameServerContext(pContext, unIP, usSteamPort, usGamePort, usQueryPort, eServerMode, pchVersionString, false))
+	{
+		DestroyGameServerContext(pContext);
+		return 0;
+	}
+
+	{
+		std::lock_guard<std::mutex> Lock(s_GameServerInstancesLock);
+
+		for (int i = 0; i < MAX_GAMESERVER_INSTANCES; i++)
+		{
+			if (s_rgGameServerInstances[i].m_pContext)
+				continue;
+
+			s_rgGameServerInstances[i].m_pContext = pContext;
+			s_rgGameServerInstances[i].m_cDispatches = 0;
+			return i + 1;
+		}
+	}
+
+	// Out of instance slots
+	DestroyGameServerContext(pContext);
+	return 0;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Logs off the instance and releases its pipe and user
+// Note:	Waits for SteamGameServer_RunInstanceCallbacks() of the instance
+//			running on other threads. Called from inside of its own callbacks,
+//			the instance is torn down once they return.
+//-----------------------------------------------------------------------------
+void SteamGameServer_DestroyInstance(HSteamGameServer hInstance)
+{
+	GameServerInstance_t* pInstance;
+
+	{
+		std::unique_lock<std::mutex> Lock(s_GameServerInstancesLock);
+
+		pInstance = FindGameServerInstance(hInstance);
+
+		if (!pInstance)
+			return;
+
+		// Not handed out to new dispatches from now on
+		pInstance->m_bDestroyed = true;
+
+		if (t_hDispatchingGameServer == hInstance)
+		{
+			pInstance->m_bDestroyDeferred = true;
+			return;
+		}
+
+		s_GameServerInstanceIdle.wait(Lock, [pInstance] { return pInstance->m_cDispatches == 0; });
+	}
+
+	TeardownGameServerInstance(pInstance);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Fills interfaces of the instance, returns false if there's no such
+//			instance.
+//-----------------------------------------------------------------------------
+bool SteamGameServer_GetInstanceInterfaces(HSteamGameServer hInstance, SteamGameServerInterfaces_t *pInterfaces)
+{
+	SteamGameServerContext_t*	pContext;
+	GameServerInstance_t*		pInstance;
+
+	std::lock_guard<std::mutex> Lock(s_GameServerInstancesLock);
+
+	pInstance = FindGameServerInstance(hInstance);
+
+	if (!pInstance)
+		return false;
+
+	pContext = pInstance->m_pContext;
+
+	pInterfaces->m_hSteamPipe = pContext->m_hSteamPipe;
+	pInterfaces->m_hSteamUser = pContext->m_hSteamUser;
+	pInterfaces->m_pSteamGameServer = Steam_TraceInterface(pContext->m_pSteamGameServer);
+	pInterfaces->m_pSteamGameServerUtils = Steam_TraceInterface(pContext->m_pSteamGameServerUtils);
+	pInterfaces->m_pSteamGameServerApps = Steam_TraceInterface(pContext->m_pSteamGameServerApps);
+	pInterfaces->m_pSteamGameServerNetworking = Steam_TraceInterface(pContext->m_pSteamGameServerNetworking);
+	pInterfaces->m_pSteamGameServerStats = Steam_TraceInterface(pContext->m_pSteamGameServerStats);
+	pInterfaces->m_pSteamGameServerHTTP = Steam_TraceInterface(pContext->m_pSteamGameServerHTTP);
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Runs callbacks on pipe of the instance. The instance is held while
+//			they run, SteamGameServer_DestroyInstance() waits for it.
+//-----------------------------------------------------------------------------
+void SteamGameServer_RunInstanceCallbacks(HSteamGameServer hInstance)
+{
+	GameServerInstance_t*	pInstance;
+	HSteamGameServer		hPrevInstance;
+	HSteamPipe				hSteamPipe;
+	bool					bTeardown;
+
+	{
+		std::lock_guard<std::mutex> Lock(s_GameServerInstancesLock);
+
+		pInstance = FindGameServerInstance(hInstance);
+		if (!pInstance || !pInstance->m_pContext->m_hSteamPipe)
+			return;
+
+		hSteamPipe = pInstance->m_pContext->m_hSteamPipe;
+		pInstance->m_cDispatches++;
+	}
+
+	hPrevInstance = t_hDispatchingGameServer;
+	t_hDispatchingGameServer = hInstance;
+
+	CallbackMgr_RunCallbacks(hSteamPipe, true);
+
+	t_hDispatchingGameServer = hPrevInstance;
+
+	{
+		std::lock_guard<std::mutex> Lock(s_GameServerInstancesLock);
+
+		pInstance->m_cDispatches--;
+		bTeardown = pInstance->m_cDispatches == 0 && pInstance->m_bDestroyDeferred;
+
+		// Somebody else tears it down otherwise
+		if (bTeardown)
+			pInstance->m_bDestroyDeferred = false;
+	}
+
+	s_GameServerInstanceIdle.notify_all();
+
+	if (bTeardown)
+		TeardownGameServerInstance(pInstance);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Registers game server listener that is only run for messages of 
+//			the instance, returns false if there's no such instance.
+// Note:	Such listener is only ever run by the thread dispatching the 
+//			instance. It's removed by SteamAPI_UnregisterCallback(), which has
+//			to be done before the instance is destroyed, the pipe may be handed
+//			to the next one.
+//-----------------------------------------------------------------------------
+bool SteamGameServer_RegisterInstanceCallback(HSteamGameServer hInstance, CCallbackBase *pCallback, int iCallback)
+{
+	GameServerInstance_t* pInstance;
+
+	std::lock_guard<std::mutex> Lock(s_GameServerInstancesLock);
+
+	pInstance = FindGameServerInstance(hInstance);
+	if (!pInstance || !pInstance->m_pContext->m_hSteamPipe)
+		return false;
+
+	CallbackMgr_RegisterPipeCallback(pCallback, iCallback, pInstance->m_pContext->m_hSteamPipe);
+	return true;
 }
 
 //-----------------------------------------------------------------------------
@@ -113,6 +582,36 @@ uint64 SteamGameServer_GetSteamID()
 //-----------------------------------------------------------------------------
 void SteamGameServer_RunCallbacks()
 {
-	if (g_hSteamGameServerPipe)
+	if (Steam_IsGameServerReady() && g_hSteamGameServerPipe)
 		Steam_RunCallbacks(g_hSteamGameServerPipe, true);
 }
+
+//-----------------------------------------------------------------------------
+// Purpose: Runs callbacks on steam game server pipe within a time budget
+//-----------------------------------------------------------------------------
+void SteamGameServer_RunCallbacksBudget(uint32 unBudgetMicroseconds)
+{
+	if (Steam_IsGameServerReady() && g_hSteamGameServerPipe)
+		CallbackMgr_RunCallbacksBudget(g_hSteamGameServerPipe, true, unBudgetMicroseconds);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Moves pulling of callback messages of game server pipe to a 
+//			background thread
+//-----------------------------------------------------------------------------
+bool SteamGameServer_StartCallbackPump(uint32 unPollIntervalMicroseconds)
+{
+	if (!Steam_IsGameServerReady() || !g_hSteamGameServerPipe)
+		return false;
+
+	return CallbackMgr_StartPump(g_hSteamGameServerPipe, unPollIntervalMicroseconds);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Stops background thread of game server pipe
+//-----------------------------------------------------------------------------
+void SteamGameServer_StopCallbackPump()
+{
+	if (Steam_IsGameServerReady() && g_hSteamGameServerPipe)
+		CallbackMgr_StopPump(g_hSteamGameServerPipe);
+}
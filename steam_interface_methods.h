@@ -0,0 +1,420 @@
+//========= Copyright  1996-2001, Valve LLC, All rights reserved. ============
+//
+// Purpose: Methods of the steamclient interfaces fetched by this module, as
+//			lists to generate implementations of them from.
+//
+// $NoKeywords: $
+//=============================================================================
+#ifndef STEAM_INTERFACE_METHODS_H
+#define STEAM_INTERFACE_METHODS_H
+#pragma once
+
+//-----------------------------------------------------------------------------
+// 
+// Interface methods
+// 
+// Each entry is X(return type, method, (parameters), (arguments)), in the
+// order the interface declares them. Overloads are XO(return type, method,
+// tag, (parameters), (arguments)), the tag tells them apart. Trace proxies
+// and the steamclient stand-in override every method, so a list must match 
+// the interface version fetched by this module exactly.
+// 
+//-----------------------------------------------------------------------------
+
+#define STEAMUSER_INTERFACE_METHODS(X, XO) \
+	X(HSteamUser,					GetHSteamUser,							(), ()) \
+	X(bool,							BLoggedOn,								(), ()) \
+	X(CSteamID,						GetSteamID,								(), ()) \
+	X(int,							InitiateGameConnection,					(void *pAuthBlob, int cbMaxAuthBlob, CSteamID steamIDGameServer, uint32 unIPServer, uint16 usPortServer, bool bSecure), (pAuthBlob, cbMaxAuthBlob, steamIDGameServer, unIPServer, usPortServer, bSecure)) \
+	X(void,							TerminateGameConnection,				(uint32 unIPServer, uint16 usPortServer), (unIPServer, usPortServer)) \
+	X(void,							TrackAppUsageEvent,						(CGameID gameID, int eAppUsageEvent, const char *pchExtraInfo), (gameID, eAppUsageEvent, pchExtraInfo)) \
+	X(bool,							GetUserDataFolder,						(char *pchBuffer, int cubBuffer), (pchBuffer, cubBuffer)) \
+	X(void,							StartVoiceRecording,					(), ()) \
+	X(void,							StopVoiceRecording,						(), ()) \
+	X(EVoiceResult,					GetAvailableVoice,						(uint32 *pcbCompressed, uint32 *pcbUncompressed, uint32 nUncompressedVoiceDesiredSampleRate), (pcbCompressed, pcbUncompressed, nUncompressedVoiceDesiredSampleRate)) \
+	X(EVoiceResult,					GetVoice,								(bool bWantCompressed, void *pDestBuffer, uint32 cbDestBufferSize, uint32 *nBytesWritten, bool bWantUncompressed, void *pUncompressedDestBuffer, uint32 cbUncompressedDestBufferSize, uint32 *nUncompressBytesWritten, uint32 nUncompressedVoiceDesiredSampleRate), (bWantCompressed, pDestBuffer, cbDestBufferSize, nBytesWritten, bWantUncompressed, pUncompressedDestBuffer, cbUncompressedDestBufferSize, nUncompressBytesWritten, nUncompressedVoiceDesiredSampleRate)) \
+	X(EVoiceResult,					DecompressVoice,						(const void *pCompressed, uint32 cbCompressed, void *pDestBuffer, uint32 cbDestBufferSize, uint32 *nBytesWritten, uint32 nDesiredSampleRate), (pCompressed, cbCompressed, pDestBuffer, cbDestBufferSize, nBytesWritten, nDesiredSampleRate)) \
+	X(uint32,						GetVoiceOptimalSampleRate,				(), ()) \
+	X(HAuthTicket,					GetAuthSessionTicket,					(void *pTicket, int cbMaxTicket, uint32 *pcbTicket), (pTicket, cbMaxTicket, pcbTicket)) \
+	X(EBeginAuthSessionResult,		BeginAuthSession,						(const void *pAuthTicket, int cbAuthTicket, CSteamID steamID), (pAuthTicket, cbAuthTicket, steamID)) \
+	X(void,							EndAuthSession,							(CSteamID steamID), (steamID)) \
+	X(void,							CancelAuthTicket,						(HAuthTicket hAuthTicket), (hAuthTicket)) \
+	X(EUserHasLicenseForAppResult,	UserHasLicenseForApp,					(CSteamID steamID, AppId_t appID), (steamID, appID)) \
+	X(bool,							BIsBehindNAT,							(), ()) \
+	X(void,							AdvertiseGame,							(CSteamID steamIDGameServer, uint32 unIPServer, uint16 usPortServer), (steamIDGameServer, unIPServer, usPortServer)) \
+	X(SteamAPICall_t,				RequestEncryptedAppTicket,				(void *pDataToInclude, int cbDataToInclude), (pDataToInclude, cbDataToInclude)) \
+	X(bool,							GetEncryptedAppTicket,					(void *pTicket, int cbMaxTicket, uint32 *pcbTicket), (pTicket, cbMaxTicket, pcbTicket))
+
+#define STEAMFRIENDS_INTERFACE_METHODS(X, XO) \
+	X(const char*,					GetPersonaName,							(), ()) \
+	X(SteamAPICall_t,				SetPersonaName,							(const char *pchPersonaName), (pchPersonaName)) \
+	X(EPersonaState,				GetPersonaState,						(), ()) \
+	X(int,							GetFriendCount,							(int iFriendFlags), (iFriendFlags)) \
+	X(CSteamID,						GetFriendByIndex,						(int iFriend, int iFriendFlags), (iFriend, iFriendFlags)) \
+	X(EFriendRelationship,			GetFriendRelationship,					(CSteamID steamIDFriend), (steamIDFriend)) \
+	X(EPersonaState,				GetFriendPersonaState,					(CSteamID steamIDFriend), (steamIDFriend)) \
+	X(const char*,					GetFriendPersonaName,					(CSteamID steamIDFriend), (steamIDFriend)) \
+	X(bool,							GetFriendGamePlayed,					(CSteamID steamIDFriend, FriendGameInfo_t *pFriendGameInfo), (steamIDFriend, pFriendGameInfo)) \
+	X(const char*,					GetFriendPersonaNameHistory,			(CSteamID steamIDFriend, int iPersonaName), (steamIDFriend, iPersonaName)) \
+	X(bool,							HasFriend,								(CSteamID steamIDFriend, int iFriendFlags), (steamIDFriend, iFriendFlags)) \
+	X(int,							GetClanCount,							(), ()) \
+	X(CSteamID,						GetClanByIndex,							(int iClan), (iClan)) \
+	X(const char*,					GetClanName,							(CSteamID steamIDClan), (steamIDClan)) \
+	X(const char*,					GetClanTag,								(CSteamID steamIDClan), (steamIDClan)) \
+	X(bool,							GetClanActivityCounts,					(CSteamID steamIDClan, int *pnOnline, int *pnInGame, int *pnChatting), (steamIDClan, pnOnline, pnInGame, pnChatting)) \
+	X(SteamAPICall_t,				DownloadClanActivityCounts,				(CSteamID *psteamIDClans, int cClansToRequest), (psteamIDClans, cClansToRequest)) \
+	X(int,							GetFriendCountFromSource,				(CSteamID steamIDSource), (steamIDSource)) \
+	X(CSteamID,						GetFriendFromSourceByIndex,				(CSteamID steamIDSource, int iFriend), (steamIDSource, iFriend)) \
+	X(bool,							IsUserInSource,							(CSteamID steamIDUser, CSteamID steamIDSource), (steamIDUser, steamIDSource)) \
+	X(void,							SetInGameVoiceSpeaking,					(CSteamID steamIDUser, bool bSpeaking), (steamIDUser, bSpeaking)) \
+	X(void,							ActivateGameOverlay,					(const char *pchDialog), (pchDialog)) \
+	X(void,							ActivateGameOverlayToUser,				(const char *pchDialog, CSteamID steamID), (pchDialog, steamID)) \
+	X(void,							ActivateGameOverlayToWebPage,			(const char *pchURL), (pchURL)) \
+	X(void,							ActivateGameOverlayToStore,				(AppId_t nAppID), (nAppID)) \
+	X(void,							SetPlayedWith,							(CSteamID steamIDUserPlayedWith), (steamIDUserPlayedWith)) \
+	X(void,							ActivateGameOverlayInviteDialog,		(CSteamID steamIDLobby), (steamIDLobby)) \
+	X(int,							GetSmallFriendAvatar,					(CSteamID steamIDFriend), (steamIDFriend)) \
+	X(int,							GetMediumFriendAvatar,					(CSteamID steamIDFriend), (steamIDFriend)) \
+	X(int,							GetLargeFriendAvatar,					(CSteamID steamIDFriend), (steamIDFriend)) \
+	X(bool,							RequestUserInformation,					(CSteamID steamIDUser, bool bRequireNameOnly), (steamIDUser, bRequireNameOnly)) \
+	X(SteamAPICall_t,				RequestClanOfficerList,					(CSteamID steamIDClan), (steamIDClan)) \
+	X(CSteamID,						GetClanOwner,							(CSteamID steamIDClan), (steamIDClan)) \
+	X(int,							GetClanOfficerCount,					(CSteamID steamIDClan), (steamIDClan)) \
+	X(CSteamID,						GetClanOfficerByIndex,					(CSteamID steamIDClan, int iOfficer), (steamIDClan, iOfficer)) \
+	X(uint32,						GetUserRestrictions,					(), ()) \
+	X(bool,							SetRichPresence,						(const char *pchKey, const char *pchValue), (pchKey, pchValue)) \
+	X(void,							ClearRichPresence,						(), ()) \
+	X(const char*,					GetFriendRichPresence,					(CSteamID steamIDFriend, const char *pchKey), (steamIDFriend, pchKey)) \
+	X(int,							GetFriendRichPresenceKeyCount,			(CSteamID steamIDFriend), (steamIDFriend)) \
+	X(const char*,					GetFriendRichPresenceKeyByIndex,		(CSteamID steamIDFriend, int iKey), (steamIDFriend, iKey)) \
+	X(void,							RequestFriendRichPresence,				(CSteamID steamIDFriend), (steamIDFriend)) \
+	X(bool,							InviteUserToGame,						(CSteamID steamIDFriend, const char *pchConnectString), (steamIDFriend, pchConnectString)) \
+	X(int,							GetCoplayFriendCount,					(), ()) \
+	X(CSteamID,						GetCoplayFriend,						(int iCoplayFriend), (iCoplayFriend)) \
+	X(int,							GetFriendCoplayTime,					(CSteamID steamIDFriend), (steamIDFriend)) \
+	X(AppId_t,						GetFriendCoplayGame,					(CSteamID steamIDFriend), (steamIDFriend)) \
+	X(SteamAPICall_t,				JoinClanChatRoom,						(CSteamID steamIDClan), (steamIDClan)) \
+	X(bool,							LeaveClanChatRoom,						(CSteamID steamIDClan), (steamIDClan)) \
+	X(int,							GetClanChatMemberCount,					(CSteamID steamIDClan), (steamIDClan)) \
+	X(CSteamID,						GetChatMemberByIndex,					(CSteamID steamIDClan, int iUser), (steamIDClan, iUser)) \
+	X(bool,							SendClanChatMessage,					(CSteamID steamIDClanChat, const char *pchText), (steamIDClanChat, pchText)) \
+	X(int,							GetClanChatMessage,						(CSteamID steamIDClanChat, int iMessage, void *prgchText, int cchTextMax, EChatEntryType *peChatEntryType, CSteamID *psteamidChatter), (steamIDClanChat, iMessage, prgchText, cchTextMax, peChatEntryType, psteamidChatter)) \
+	X(bool,							IsClanChatAdmin,						(CSteamID steamIDClanChat, CSteamID steamIDUser), (steamIDClanChat, steamIDUser)) \
+	X(bool,							IsClanChatWindowOpenInSteam,			(CSteamID steamIDClanChat), (steamIDClanChat)) \
+	X(bool,							OpenClanChatWindowInSteam,				(CSteamID steamIDClanChat), (steamIDClanChat)) \
+	X(bool,							CloseClanChatWindowInSteam,				(CSteamID steamIDClanChat), (steamIDClanChat)) \
+	X(bool,							SetListenForFriendsMessages,			(bool bInterceptEnabled), (bInterceptEnabled)) \
+	X(bool,							ReplyToFriendMessage,					(CSteamID steamIDFriend, const char *pchMsgToSend), (steamIDFriend, pchMsgToSend)) \
+	X(int,							GetFriendMessage,						(CSteamID steamIDFriend, int iMessageID, void *pvData, int cubData, EChatEntryType *peChatEntryType), (steamIDFriend, iMessageID, pvData, cubData, peChatEntryType)) \
+	X(SteamAPICall_t,				GetFollowerCount,						(CSteamID steamID), (steamID)) \
+	X(SteamAPICall_t,				IsFollowing,							(CSteamID steamID), (steamID)) \
+	X(SteamAPICall_t,				EnumerateFollowingList,					(uint32 unStartIndex), (unStartIndex))
+
+#define STEAMUTILS_INTERFACE_METHODS(X, XO) \
+	X(uint32,						GetSecondsSinceAppActive,				(), ()) \
+	X(uint32,						GetSecondsSinceComputerActive,			(), ()) \
+	X(EUniverse,					GetConnectedUniverse,					(), ()) \
+	X(uint32,						GetServerRealTime,						(), ()) \
+	X(const char*,					GetIPCountry,							(), ()) \
+	X(bool,							GetImageSize,							(int iImage, uint32 *pnWidth, uint32 *pnHeight), (iImage, pnWidth, pnHeight)) \
+	X(bool,							GetImageRGBA,							(int iImage, uint8 *pubDest, int nDestBufferSize), (iImage, pubDest, nDestBufferSize)) \
+	X(bool,							GetCSERIPPort,							(uint32 *unIP, uint16 *usPort), (unIP, usPort)) \
+	X(uint8,						GetCurrentBatteryPower,					(), ()) \
+	X(uint32,						GetAppID,								(), ()) \
+	X(void,							SetOverlayNotificationPosition,			(ENotificationPosition eNotificationPosition), (eNotificationPosition)) \
+	X(bool,							IsAPICallCompleted,						(SteamAPICall_t hSteamAPICall, bool *pbFailed), (hSteamAPICall, pbFailed)) \
+	X(ESteamAPICallFailure,			GetAPICallFailureReason,				(SteamAPICall_t hSteamAPICall), (hSteamAPICall)) \
+	X(bool,							GetAPICallResult,						(SteamAPICall_t hSteamAPICall, void *pCallback, int cubCallback, int iCallbackExpected, bool *pbFailed), (hSteamAPICall, pCallback, cubCallback, iCallbackExpected, pbFailed)) \
+	X(void,							RunFrame,								(), ()) \
+	X(uint32,						GetIPCCallCount,						(), ()) \
+	X(void,							SetWarningMessageHook,					(SteamAPIWarningMessageHook_t pFunction), (pFunction)) \
+	X(bool,							IsOverlayEnabled,						(), ()) \
+	X(bool,							BOverlayNeedsPresent,					(), ()) \
+	X(SteamAPICall_t,				CheckFileSignature,						(const char *szFileName), (szFileName))
+
+#define STEAMMATCHMAKING_INTERFACE_METHODS(X, XO) \
+	X(int,							GetFavoriteGameCount,					(), ()) \
+	X(bool,							GetFavoriteGame,						(int iGame, AppId_t *pnAppID, uint32 *pnIP, uint16 *pnConnPort, uint16 *pnQueryPort, uint32 *punFlags, uint32 *pRTime32LastPlayedOnServer), (iGame, pnAppID, pnIP, pnConnPort, pnQueryPort, punFlags, pRTime32LastPlayedOnServer)) \
+	X(int,							AddFavoriteGame,						(AppId_t nAppID, uint32 nIP, uint16 nConnPort, uint16 nQueryPort, uint32 unFlags, uint32 rTime32LastPlayedOnServer), (nAppID, nIP, nConnPort, nQueryPort, unFlags, rTime32LastPlayedOnServer)) \
+	X(bool,							RemoveFavoriteGame,						(AppId_t nAppID, uint32 nIP, uint16 nConnPort, uint16 nQueryPort, uint32 unFlags), (nAppID, nIP, nConnPort, nQueryPort, unFlags)) \
+	X(SteamAPICall_t,				RequestLobbyList,						(), ()) \
+	X(void,							AddRequestLobbyListStringFilter,		(const char *pchKeyToMatch, const char *pchValueToMatch, ELobbyComparison eComparisonType), (pchKeyToMatch, pchValueToMatch, eComparisonType)) \
+	X(void,							AddRequestLobbyListNumericalFilter,		(const char *pchKeyToMatch, int nValueToMatch, ELobbyComparison eComparisonType), (pchKeyToMatch, nValueToMatch, eComparisonType)) \
+	X(void,							AddRequestLobbyListNearValueFilter,		(const char *pchKeyToMatch, int nValueToBeCloseTo), (pchKeyToMatch, nValueToBeCloseTo)) \
+	X(void,							AddRequestLobbyListFilterSlotsAvailable,	(int nSlotsAvailable), (nSlotsAvailable)) \
+	X(void,							AddRequestLobbyListDistanceFilter,		(ELobbyDistanceFilter eLobbyDistanceFilter), (eLobbyDistanceFilter)) \
+	X(void,							AddRequestLobbyListResultCountFilter,	(int cMaxResults), (cMaxResults)) \
+	X(void,							AddRequestLobbyListCompatibleMembersFilter,	(CSteamID steamIDLobby), (steamIDLobby)) \
+	X(CSteamID,						GetLobbyByIndex,						(int iLobby), (iLobby)) \
+	X(SteamAPICall_t,				CreateLobby,							(ELobbyType eLobbyType, int cMaxMembers), (eLobbyType, cMaxMembers)) \
+	X(SteamAPICall_t,				JoinLobby,								(CSteamID steamIDLobby), (steamIDLobby)) \
+	X(void,							LeaveLobby,								(CSteamID steamIDLobby), (steamIDLobby)) \
+	X(bool,							InviteUserToLobby,						(CSteamID steamIDLobby, CSteamID steamIDInvitee), (steamIDLobby, steamIDInvitee)) \
+	X(int,							GetNumLobbyMembers,						(CSteamID steamIDLobby), (steamIDLobby)) \
+	X(CSteamID,						GetLobbyMemberByIndex,					(CSteamID steamIDLobby, int iMember), (steamIDLobby, iMember)) \
+	X(const char*,					GetLobbyData,							(CSteamID steamIDLobby, const char *pchKey), (steamIDLobby, pchKey)) \
+	X(bool,							SetLobbyData,							(CSteamID steamIDLobby, const char *pchKey, const char *pchValue), (steamIDLobby, pchKey, pchValue)) \
+	X(int,							GetLobbyDataCount,						(CSteamID steamIDLobby), (steamIDLobby)) \
+	X(bool,							GetLobbyDataByIndex,					(CSteamID steamIDLobby, int iLobbyData, char *pchKey, int cchKeyBufferSize, char *pchValue, int cchValueBufferSize), (steamIDLobby, iLobbyData, pchKey, cchKeyBufferSize, pchValue, cchValueBufferSize)) \
+	X(bool,							DeleteLobbyData,						(CSteamID steamIDLobby, const char *pchKey), (steamIDLobby, pchKey)) \
+	X(const char*,					GetLobbyMemberData,						(CSteamID steamIDLobby, CSteamID steamIDUser, const char *pchKey), (steamIDLobby, steamIDUser, pchKey)) \
+	X(void,							SetLobbyMemberData,						(CSteamID steamIDLobby, const char *pchKey, const char *pchValue), (steamIDLobby, pchKey, pchValue)) \
+	X(bool,							SendLobbyChatMsg,						(CSteamID steamIDLobby, const void *pvMsgBody, int cubMsgBody), (steamIDLobby, pvMsgBody, cubMsgBody)) \
+	X(int,							GetLobbyChatEntry,						(CSteamID steamIDLobby, int iChatID, CSteamID *pSteamIDUser, void *pvData, int cubData, EChatEntryType *peChatEntryType), (steamIDLobby, iChatID, pSteamIDUser, pvData, cubData, peChatEntryType)) \
+	X(bool,							RequestLobbyData,						(CSteamID steamIDLobby), (steamIDLobby)) \
+	X(void,							SetLobbyGameServer,						(CSteamID steamIDLobby, uint32 unGameServerIP, uint16 unGameServerPort, CSteamID steamIDGameServer), (steamIDLobby, unGameServerIP, unGameServerPort, steamIDGameServer)) \
+	X(bool,							GetLobbyGameServer,						(CSteamID steamIDLobby, uint32 *punGameServerIP, uint16 *punGameServerPort, CSteamID *psteamIDGameServer), (steamIDLobby, punGameServerIP, punGameServerPort, psteamIDGameServer)) \
+	X(bool,							SetLobbyMemberLimit,					(CSteamID steamIDLobby, int cMaxMembers), (steamIDLobby, cMaxMembers)) \
+	X(int,							GetLobbyMemberLimit,					(CSteamID steamIDLobby), (steamIDLobby)) \
+	X(bool,							SetLobbyType,							(CSteamID steamIDLobby, ELobbyType eLobbyType), (steamIDLobby, eLobbyType)) \
+	X(bool,							SetLobbyJoinable,						(CSteamID steamIDLobby, bool bLobbyJoinable), (steamIDLobby, bLobbyJoinable)) \
+	X(CSteamID,						GetLobbyOwner,							(CSteamID steamIDLobby), (steamIDLobby)) \
+	X(bool,							SetLobbyOwner,							(CSteamID steamIDLobby, CSteamID steamIDNewOwner), (steamIDLobby, steamIDNewOwner)) \
+	X(bool,							SetLinkedLobby,							(CSteamID steamIDLobby, CSteamID steamIDLobbyDependent), (steamIDLobby, steamIDLobbyDependent))
+
+#define STEAMMATCHMAKINGSERVERS_INTERFACE_METHODS(X, XO) \
+	X(HServerListRequest,			RequestInternetServerList,				(AppId_t iApp, MatchMakingKeyValuePair_t **ppchFilters, uint32 nFilters, ISteamMatchmakingServerListResponse *pRequestServersResponse), (iApp, ppchFilters, nFilters, pRequestServersResponse)) \
+	X(HServerListRequest,			RequestLANServerList,					(AppId_t iApp, ISteamMatchmakingServerListResponse *pRequestServersResponse), (iApp, pRequestServersResponse)) \
+	X(HServerListRequest,			RequestFriendsServerList,				(AppId_t iApp, MatchMakingKeyValuePair_t **ppchFilters, uint32 nFilters, ISteamMatchmakingServerListResponse *pRequestServersResponse), (iApp, ppchFilters, nFilters, pRequestServersResponse)) \
+	X(HServerListRequest,			RequestFavoritesServerList,				(AppId_t iApp, MatchMakingKeyValuePair_t **ppchFilters, uint32 nFilters, ISteamMatchmakingServerListResponse *pRequestServersResponse), (iApp, ppchFilters, nFilters, pRequestServersResponse)) \
+	X(HServerListRequest,			RequestHistoryServerList,				(AppId_t iApp, MatchMakingKeyValuePair_t **ppchFilters, uint32 nFilters, ISteamMatchmakingServerListResponse *pRequestServersResponse), (iApp, ppchFilters, nFilters, pRequestServersResponse)) \
+	X(HServerListRequest,			RequestSpectatorServerList,				(AppId_t iApp, MatchMakingKeyValuePair_t **ppchFilters, uint32 nFilters, ISteamMatchmakingServerListResponse *pRequestServersResponse), (iApp, ppchFilters, nFilters, pRequestServersResponse)) \
+	X(void,							ReleaseRequest,							(HServerListRequest hServerListRequest), (hServerListRequest)) \
+	X(gameserveritem_t*,			GetServerDetails,						(HServerListRequest hRequest, int iServer), (hRequest, iServer)) \
+	X(void,							CancelQuery,							(HServerListRequest hRequest), (hRequest)) \
+	X(void,							RefreshQuery,							(HServerListRequest hRequest), (hRequest)) \
+	X(bool,							IsRefreshing,							(HServerListRequest hRequest), (hRequest)) \
+	X(int,							GetServerCount,							(HServerListRequest hRequest), (hRequest)) \
+	X(void,							RefreshServer,							(HServerListRequest hRequest, int iServer), (hRequest, iServer)) \
+	X(HServerQuery,					PingServer,								(uint32 unIP, uint16 usPort, ISteamMatchmakingPingResponse *pRequestServersResponse), (unIP, usPort, pRequestServersResponse)) \
+	X(HServerQuery,					PlayerDetails,							(uint32 unIP, uint16 usPort, ISteamMatchmakingPlayersResponse *pRequestServersResponse), (unIP, usPort, pRequestServersResponse)) \
+	X(HServerQuery,					ServerRules,							(uint32 unIP, uint16 usPort, ISteamMatchmakingRulesResponse *pRequestServersResponse), (unIP, usPort, pRequestServersResponse)) \
+	X(void,							CancelServerQuery,						(HServerQuery hServerQuery), (hServerQuery))
+
+#define STEAMUSERSTATS_INTERFACE_METHODS(X, XO) \
+	X(bool,							RequestCurrentStats,					(), ()) \
+	XO(bool,						GetStat,								int32, (const char *pchName, int32 *pData), (pchName, pData)) \
+	XO(bool,						GetStat,								float, (const char *pchName, float *pData), (pchName, pData)) \
+	XO(bool,						SetStat,								int32, (const char *pchName, int32 nData), (pchName, nData)) \
+	XO(bool,						SetStat,								float, (const char *pchName, float fData), (pchName, fData)) \
+	X(bool,							UpdateAvgRateStat,						(const char *pchName, float flCountThisSession, double dSessionLength), (pchName, flCountThisSession, dSessionLength)) \
+	X(bool,							GetAchievement,							(const char *pchName, bool *pbAchieved), (pchName, pbAchieved)) \
+	X(bool,							SetAchievement,							(const char *pchName), (pchName)) \
+	X(bool,							ClearAchievement,						(const char *pchName), (pchName)) \
+	X(bool,							GetAchievementAndUnlockTime,			(const char *pchName, bool *pbAchieved, uint32 *punUnlockTime), (pchName, pbAchieved, punUnlockTime)) \
+	X(bool,							StoreStats,								(), ()) \
+	X(int,							GetAchievementIcon,						(const char *pchName), (pchName)) \
+	X(const char*,					GetAchievementDisplayAttribute,			(const char *pchName, const char *pchKey), (pchName, pchKey)) \
+	X(bool,							IndicateAchievementProgress,			(const char *pchName, uint32 nCurProgress, uint32 nMaxProgress), (pchName, nCurProgress, nMaxProgress)) \
+	X(SteamAPICall_t,				RequestUserStats,						(CSteamID steamIDUser), (steamIDUser)) \
+	XO(bool,						GetUserStat,							int32, (CSteamID steamIDUser, const char *pchName, int32 *pData), (steamIDUser, pchName, pData)) \
+	XO(bool,						GetUserStat,							float, (CSteamID steamIDUser, const char *pchName, float *pData), (steamIDUser, pchName, pData)) \
+	X(bool,							GetUserAchievement,						(CSteamID steamIDUser, const char *pchName, bool *pbAchieved), (steamIDUser, pchName, pbAchieved)) \
+	X(bool,							GetUserAchievementAndUnlockTime,		(CSteamID steamIDUser, const char *pchName, bool *pbAchieved, uint32 *punUnlockTime), (steamIDUser, pchName, pbAchieved, punUnlockTime)) \
+	X(bool,							ResetAllStats,							(bool bAchievementsToo), (bAchievementsToo)) \
+	X(SteamAPICall_t,				FindOrCreateLeaderboard,				(const char *pchLeaderboardName, ELeaderboardSortMethod eLeaderboardSortMethod, ELeaderboardDisplayType eLeaderboardDisplayType), (pchLeaderboardName, eLeaderboardSortMethod, eLeaderboardDisplayType)) \
+	X(SteamAPICall_t,				FindLeaderboard,						(const char *pchLeaderboardName), (pchLeaderboardName)) \
+	X(const char*,					GetLeaderboardName,						(SteamLeaderboard_t hSteamLeaderboard), (hSteamLeaderboard)) \
+	X(int,							GetLeaderboardEntryCount,				(SteamLeaderboard_t hSteamLeaderboard), (hSteamLeaderboard)) \
+	X(ELeaderboardSortMethod,		GetLeaderboardSortMethod,				(SteamLeaderboard_t hSteamLeaderboard), (hSteamLeaderboard)) \
+	X(ELeaderboardDisplayType,		GetLeaderboardDisplayType,				(SteamLeaderboard_t hSteamLeaderboard), (hSteamLeaderboard)) \
+	X(SteamAPICall_t,				DownloadLeaderboardEntries,				(SteamLeaderboard_t hSteamLeaderboard, ELeaderboardDataRequest eLeaderboardDataRequest, int nRangeStart, int nRangeEnd), (hSteamLeaderboard, eLeaderboardDataRequest, nRangeStart, nRangeEnd)) \
+	X(SteamAPICall_t,				DownloadLeaderboardEntriesForUsers,		(SteamLeaderboard_t hSteamLeaderboard, CSteamID *prgUsers, int cUsers), (hSteamLeaderboard, prgUsers, cUsers)) \
+	X(bool,							GetDownloadedLeaderboardEntry,			(SteamLeaderboardEntries_t hSteamLeaderboardEntries, int index, LeaderboardEntry_t *pLeaderboardEntry, int32 *pDetails, int cDetailsMax), (hSteamLeaderboardEntries, index, pLeaderboardEntry, pDetails, cDetailsMax)) \
+	X(SteamAPICall_t,				UploadLeaderboardScore,					(SteamLeaderboard_t hSteamLeaderboard, ELeaderboardUploadScoreMethod eLeaderboardUploadScoreMethod, int32 nScore, const int32 *pScoreDetails, int cScoreDetailsCount), (hSteamLeaderboard, eLeaderboardUploadScoreMethod, nScore, pScoreDetails, cScoreDetailsCount)) \
+	X(SteamAPICall_t,				AttachLeaderboardUGC,					(SteamLeaderboard_t hSteamLeaderboard, UGCHandle_t hUGC), (hSteamLeaderboard, hUGC)) \
+	X(SteamAPICall_t,				GetNumberOfCurrentPlayers,				(), ()) \
+	X(SteamAPICall_t,				RequestGlobalAchievementPercentages,	(), ()) \
+	X(int,							GetMostAchievedAchievementInfo,			(char *pchName, uint32 unNameBufLen, float *pflPercent, bool *pbAchieved), (pchName, unNameBufLen, pflPercent, pbAchieved)) \
+	X(int,							GetNextMostAchievedAchievementInfo,		(int iIteratorPrevious, char *pchName, uint32 unNameBufLen, float *pflPercent, bool *pbAchieved), (iIteratorPrevious, pchName, unNameBufLen, pflPercent, pbAchieved)) \
+	X(bool,							GetAchievementAchievedPercent,			(const char *pchName, float *pflPercent), (pchName, pflPercent)) \
+	X(SteamAPICall_t,				RequestGlobalStats,						(int nHistoryDays), (nHistoryDays)) \
+	XO(bool,						GetGlobalStat,							int64, (const char *pchStatName, int64 *pData), (pchStatName, pData)) \
+	XO(bool,						GetGlobalStat,							double, (const char *pchStatName, double *pData), (pchStatName, pData)) \
+	XO(int32,						GetGlobalStatHistory,					int64, (const char *pchStatName, int64 *pData, uint32 cubData), (pchStatName, pData, cubData)) \
+	XO(int32,						GetGlobalStatHistory,					double, (const char *pchStatName, double *pData, uint32 cubData), (pchStatName, pData, cubData))
+
+#define STEAMAPPS_INTERFACE_METHODS(X, XO) \
+	X(bool,							BIsSubscribed,							(), ()) \
+	X(bool,							BIsLowViolence,							(), ()) \
+	X(bool,							BIsCybercafe,							(), ()) \
+	X(bool,							BIsVACBanned,							(), ()) \
+	X(const char*,					GetCurrentGameLanguage,					(), ()) \
+	X(const char*,					GetAvailableGameLanguages,				(), ()) \
+	X(bool,							BIsSubscribedApp,						(AppId_t appID), (appID)) \
+	X(bool,							BIsDlcInstalled,						(AppId_t appID), (appID)) \
+	X(uint32,						GetEarliestPurchaseUnixTime,			(AppId_t nAppID), (nAppID)) \
+	X(bool,							BIsSubscribedFromFreeWeekend,			(), ()) \
+	X(int,							GetDLCCount,							(), ()) \
+	X(bool,							BGetDLCDataByIndex,						(int iDLC, AppId_t *pAppID, bool *pbAvailable, char *pchName, int cchNameBufferSize), (iDLC, pAppID, pbAvailable, pchName, cchNameBufferSize)) \
+	X(void,							InstallDLC,								(AppId_t nAppID), (nAppID)) \
+	X(void,							UninstallDLC,							(AppId_t nAppID), (nAppID)) \
+	X(void,							RequestAppProofOfPurchaseKey,			(AppId_t nAppID), (nAppID)) \
+	X(bool,							GetCurrentBetaName,						(char *pchName, int cchNameBufferSize), (pchName, cchNameBufferSize)) \
+	X(bool,							MarkContentCorrupt,						(bool bMissingFilesOnly), (bMissingFilesOnly)) \
+	X(uint32,						GetInstalledDepots,						(DepotId_t *pvecDepots, uint32 cMaxDepots), (pvecDepots, cMaxDepots)) \
+	X(uint32,						GetAppInstallDir,						(AppId_t appID, char *pchFolder, uint32 cchFolderBufferSize), (appID, pchFolder, cchFolderBufferSize)) \
+	X(bool,							BIsAppInstalled,						(AppId_t appID), (appID))
+
+#define STEAMNETWORKING_INTERFACE_METHODS(X, XO) \
+	X(bool,							SendP2PPacket,							(CSteamID steamIDRemote, const void *pubData, uint32 cubData, EP2PSend eP2PSendType, int nChannel), (steamIDRemote, pubData, cubData, eP2PSendType, nChannel)) \
+	X(bool,							IsP2PPacketAvailable,					(uint32 *pcubMsgSize, int nChannel), (pcubMsgSize, nChannel)) \
+	X(bool,							ReadP2PPacket,							(void *pubDest, uint32 cubDest, uint32 *pcubMsgSize, CSteamID *psteamIDRemote, int nChannel), (pubDest, cubDest, pcubMsgSize, psteamIDRemote, nChannel)) \
+	X(bool,							AcceptP2PSessionWithUser,				(CSteamID steamIDRemote), (steamIDRemote)) \
+	X(bool,							CloseP2PSessionWithUser,				(CSteamID steamIDRemote), (steamIDRemote)) \
+	X(bool,							CloseP2PChannelWithUser,				(CSteamID steamIDRemote, int nChannel), (steamIDRemote, nChannel)) \
+	X(bool,							GetP2PSessionState,						(CSteamID steamIDRemote, P2PSessionState_t *pConnectionState), (steamIDRemote, pConnectionState)) \
+	X(bool,							AllowP2PPacketRelay,					(bool bAllow), (bAllow)) \
+	X(SNetListenSocket_t,			CreateListenSocket,						(int nVirtualP2PPort, uint32 nIP, uint16 nPort, bool bAllowUseOfPacketRelay), (nVirtualP2PPort, nIP, nPort, bAllowUseOfPacketRelay)) \
+	X(SNetSocket_t,					CreateP2PConnectionSocket,				(CSteamID steamIDTarget, int nVirtualPort, int nTimeoutSec, bool bAllowUseOfPacketRelay), (steamIDTarget, nVirtualPort, nTimeoutSec, bAllowUseOfPacketRelay)) \
+	X(SNetSocket_t,					CreateConnectionSocket,					(uint32 nIP, uint16 nPort, int nTimeoutSec), (nIP, nPort, nTimeoutSec)) \
+	X(bool,							DestroySocket,							(SNetSocket_t hSocket, bool bNotifyRemoteEnd), (hSocket, bNotifyRemoteEnd)) \
+	X(bool,							DestroyListenSocket,					(SNetListenSocket_t hSocket, bool bNotifyRemoteEnd), (hSocket, bNotifyRemoteEnd)) \
+	X(bool,							SendDataOnSocket,						(SNetSocket_t hSocket, void *pubData, uint32 cubData, bool bReliable), (hSocket, pubData, cubData, bReliable)) \
+	X(bool,							IsDataAvailableOnSocket,				(SNetSocket_t hSocket, uint32 *pcubMsgSize), (hSocket, pcubMsgSize)) \
+	X(bool,							RetrieveDataFromSocket,					(SNetSocket_t hSocket, void *pubDest, uint32 cubDest, uint32 *pcubMsgSize), (hSocket, pubDest, cubDest, pcubMsgSize)) \
+	X(bool,							IsDataAvailable,						(SNetListenSocket_t hListenSocket, uint32 *pcubMsgSize, SNetSocket_t *phSocket), (hListenSocket, pcubMsgSize, phSocket)) \
+	X(bool,							RetrieveData,							(SNetListenSocket_t hListenSocket, void *pubDest, uint32 cubDest, uint32 *pcubMsgSize, SNetSocket_t *phSocket), (hListenSocket, pubDest, cubDest, pcubMsgSize, phSocket)) \
+	X(bool,							GetSocketInfo,							(SNetSocket_t hSocket, CSteamID *pSteamIDRemote, int *peSocketStatus, uint32 *punIPRemote, uint16 *punPortRemote), (hSocket, pSteamIDRemote, peSocketStatus, punIPRemote, punPortRemote)) \
+	X(bool,							GetListenSocketInfo,					(SNetListenSocket_t hListenSocket, uint32 *pnIP, uint16 *pnPort), (hListenSocket, pnIP, pnPort)) \
+	X(ESNetSocketConnectionType,	GetSocketConnectionType,				(SNetSocket_t hSocket), (hSocket)) \
+	X(int,							GetMaxPacketSize,						(SNetSocket_t hSocket), (hSocket))
+
+#define STEAMREMOTESTORAGE_INTERFACE_METHODS(X, XO) \
+	X(bool,							FileWrite,								(const char *pchFile, const void *pvData, int32 cubData), (pchFile, pvData, cubData)) \
+	X(int32,						FileRead,								(const char *pchFile, void *pvData, int32 cubDataToRead), (pchFile, pvData, cubDataToRead)) \
+	X(bool,							FileForget,								(const char *pchFile), (pchFile)) \
+	X(bool,							FileDelete,								(const char *pchFile), (pchFile)) \
+	X(SteamAPICall_t,				FileShare,								(const char *pchFile), (pchFile)) \
+	X(bool,							SetSyncPlatforms,						(const char *pchFile, ERemoteStoragePlatform eRemoteStoragePlatform), (pchFile, eRemoteStoragePlatform)) \
+	X(UGCFileWriteStreamHandle_t,	FileWriteStreamOpen,					(const char *pchFile), (pchFile)) \
+	X(bool,							FileWriteStreamWriteChunk,				(UGCFileWriteStreamHandle_t writeHandle, const void *pvData, int32 cubData), (writeHandle, pvData, cubData)) \
+	X(bool,							FileWriteStreamClose,					(UGCFileWriteStreamHandle_t writeHandle), (writeHandle)) \
+	X(bool,							FileWriteStreamCancel,					(UGCFileWriteStreamHandle_t writeHandle), (writeHandle)) \
+	X(bool,							FileExists,								(const char *pchFile), (pchFile)) \
+	X(bool,							FilePersisted,							(const char *pchFile), (pchFile)) \
+	X(int32,						GetFileSize,							(const char *pchFile), (pchFile)) \
+	X(int64,						GetFileTimestamp,						(const char *pchFile), (pchFile)) \
+	X(ERemoteStoragePlatform,		GetSyncPlatforms,						(const char *pchFile), (pchFile)) \
+	X(int32,						GetFileCount,							(), ()) \
+	X(const char*,					GetFileNameAndSize,						(int iFile, int32 *pnFileSizeInBytes), (iFile, pnFileSizeInBytes)) \
+	X(bool,							GetQuota,								(int32 *pnTotalBytes, int32 *puAvailableBytes), (pnTotalBytes, puAvailableBytes)) \
+	X(bool,							IsCloudEnabledForAccount,				(), ()) \
+	X(bool,							IsCloudEnabledForApp,					(), ()) \
+	X(void,							SetCloudEnabledForApp,					(bool bEnabled), (bEnabled)) \
+	X(SteamAPICall_t,				UGCDownload,							(UGCHandle_t hContent), (hContent)) \
+	X(bool,							GetUGCDownloadProgress,					(UGCHandle_t hContent, int32 *pnBytesDownloaded, int32 *pnBytesExpected), (hContent, pnBytesDownloaded, pnBytesExpected)) \
+	X(bool,							GetUGCDetails,							(UGCHandle_t hContent, AppId_t *pnAppID, char **ppchName, int32 *pnFileSizeInBytes, CSteamID *pSteamIDOwner), (hContent, pnAppID, ppchName, pnFileSizeInBytes, pSteamIDOwner)) \
+	X(int32,						UGCRead,								(UGCHandle_t hContent, void *pvData, int32 cubDataToRead, uint32 cOffset), (hContent, pvData, cubDataToRead, cOffset)) \
+	X(int32,						GetCachedUGCCount,						(), ()) \
+	X(UGCHandle_t,					GetCachedUGCHandle,						(int32 iCachedContent), (iCachedContent)) \
+	X(SteamAPICall_t,				PublishWorkshopFile,					(const char *pchFile, const char *pchPreviewFile, AppId_t nConsumerAppId, const char *pchTitle, const char *pchDescription, ERemoteStoragePublishedFileVisibility eVisibility, SteamParamStringArray_t *pTags, EWorkshopFileType eWorkshopFileType), (pchFile, pchPreviewFile, nConsumerAppId, pchTitle, pchDescription, eVisibility, pTags, eWorkshopFileType)) \
+	X(PublishedFileUpdateHandle_t,	CreatePublishedFileUpdateRequest,		(PublishedFileId_t unPublishedFileId), (unPublishedFileId)) \
+	X(bool,							UpdatePublishedFileFile,				(PublishedFileUpdateHandle_t updateHandle, const char *pchFile), (updateHandle, pchFile)) \
+	X(bool,							UpdatePublishedFilePreviewFile,			(PublishedFileUpdateHandle_t updateHandle, const char *pchPreviewFile), (updateHandle, pchPreviewFile)) \
+	X(bool,							UpdatePublishedFileTitle,				(PublishedFileUpdateHandle_t updateHandle, const char *pchTitle), (updateHandle, pchTitle)) \
+	X(bool,							UpdatePublishedFileDescription,			(PublishedFileUpdateHandle_t updateHandle, const char *pchDescription), (updateHandle, pchDescription)) \
+	X(bool,							UpdatePublishedFileVisibility,			(PublishedFileUpdateHandle_t updateHandle, ERemoteStoragePublishedFileVisibility eVisibility), (updateHandle, eVisibility)) \
+	X(bool,							UpdatePublishedFileTags,				(PublishedFileUpdateHandle_t updateHandle, SteamParamStringArray_t *pTags), (updateHandle, pTags)) \
+	X(SteamAPICall_t,				CommitPublishedFileUpdate,				(PublishedFileUpdateHandle_t updateHandle), (updateHandle)) \
+	X(SteamAPICall_t,				GetPublishedFileDetails,				(PublishedFileId_t unPublishedFileId), (unPublishedFileId)) \
+	X(SteamAPICall_t,				DeletePublishedFile,					(PublishedFileId_t unPublishedFileId), (unPublishedFileId)) \
+	X(SteamAPICall_t,				EnumerateUserPublishedFiles,			(uint32 unStartIndex), (unStartIndex)) \
+	X(SteamAPICall_t,				SubscribePublishedFile,					(PublishedFileId_t unPublishedFileId), (unPublishedFileId)) \
+	X(SteamAPICall_t,				EnumerateUserSubscribedFiles,			(uint32 unStartIndex), (unStartIndex)) \
+	X(SteamAPICall_t,				UnsubscribePublishedFile,				(PublishedFileId_t unPublishedFileId), (unPublishedFileId)) \
+	X(bool,							UpdatePublishedFileSetChangeDescription,	(PublishedFileUpdateHandle_t updateHandle, const char *pchChangeDescription), (updateHandle, pchChangeDescription)) \
+	X(SteamAPICall_t,				GetPublishedItemVoteDetails,			(PublishedFileId_t unPublishedFileId), (unPublishedFileId)) \
+	X(SteamAPICall_t,				UpdateUserPublishedItemVote,			(PublishedFileId_t unPublishedFileId, bool bVoteUp), (unPublishedFileId, bVoteUp)) \
+	X(SteamAPICall_t,				GetUserPublishedItemVoteDetails,		(PublishedFileId_t unPublishedFileId), (unPublishedFileId)) \
+	X(SteamAPICall_t,				EnumerateUserSharedWorkshopFiles,		(CSteamID steamId, uint32 unStartIndex, SteamParamStringArray_t *pRequiredTags, SteamParamStringArray_t *pExcludedTags), (steamId, unStartIndex, pRequiredTags, pExcludedTags)) \
+	X(SteamAPICall_t,				PublishVideo,							(EWorkshopVideoProvider eVideoProvider, const char *pchVideoAccount, const char *pchVideoIdentifier, const char *pchPreviewFile, AppId_t nConsumerAppId, const char *pchTitle, const char *pchDescription, ERemoteStoragePublishedFileVisibility eVisibility, SteamParamStringArray_t *pTags), (eVideoProvider, pchVideoAccount, pchVideoIdentifier, pchPreviewFile, nConsumerAppId, pchTitle, pchDescription, eVisibility, pTags)) \
+	X(SteamAPICall_t,				SetUserPublishedFileAction,				(PublishedFileId_t unPublishedFileId, EWorkshopFileAction eAction), (unPublishedFileId, eAction)) \
+	X(SteamAPICall_t,				EnumeratePublishedFilesByUserAction,	(EWorkshopFileAction eAction, uint32 unStartIndex), (eAction, unStartIndex)) \
+	X(SteamAPICall_t,				EnumeratePublishedWorkshopFiles,		(EWorkshopEnumerationType eEnumerationType, uint32 unStartIndex, uint32 unCount, uint32 unDays, SteamParamStringArray_t *pTags, SteamParamStringArray_t *pUserTags), (eEnumerationType, unStartIndex, unCount, unDays, pTags, pUserTags)) \
+	X(SteamAPICall_t,				UGCDownloadToLocation,					(UGCHandle_t hContent, const char *pchLocation), (hContent, pchLocation))
+
+#define STEAMSCREENSHOTS_INTERFACE_METHODS(X, XO) \
+	X(ScreenshotHandle,				WriteScreenshot,						(void *pubRGB, uint32 cubRGB, int nWidth, int nHeight), (pubRGB, cubRGB, nWidth, nHeight)) \
+	X(ScreenshotHandle,				AddScreenshotToLibrary,					(const char *pchFilename, const char *pchThumbnailFilename, int nWidth, int nHeight), (pchFilename, pchThumbnailFilename, nWidth, nHeight)) \
+	X(void,							TriggerScreenshot,						(), ()) \
+	X(void,							HookScreenshots,						(bool bHook), (bHook)) \
+	X(bool,							SetLocation,							(ScreenshotHandle hScreenshot, const char *pchLocation), (hScreenshot, pchLocation)) \
+	X(bool,							TagUser,								(ScreenshotHandle hScreenshot, CSteamID steamID), (hScreenshot, steamID))
+
+#define STEAMGAMESERVER_INTERFACE_METHODS(X, XO) \
+	X(bool,							InitGameServer,							(uint32 unIP, uint16 usGamePort, uint16 usQueryPort, uint32 unFlags, AppId_t nGameAppId, const char *pchVersionString), (unIP, usGamePort, usQueryPort, unFlags, nGameAppId, pchVersionString)) \
+	X(void,							SetProduct,								(const char *pszProduct), (pszProduct)) \
+	X(void,							SetGameDescription,						(const char *pszGameDescription), (pszGameDescription)) \
+	X(void,							SetModDir,								(const char *pszModDir), (pszModDir)) \
+	X(void,							SetDedicatedServer,						(bool bDedicated), (bDedicated)) \
+	X(void,							LogOn,									(const char *pszAccountName, const char *pszPassword), (pszAccountName, pszPassword)) \
+	X(void,							LogOnAnonymous,							(), ()) \
+	X(void,							LogOff,									(), ()) \
+	X(bool,							BLoggedOn,								(), ()) \
+	X(bool,							BSecure,								(), ()) \
+	X(CSteamID,						GetSteamID,								(), ()) \
+	X(bool,							WasRestartRequested,					(), ()) \
+	X(void,							SetMaxPlayerCount,						(int cPlayersMax), (cPlayersMax)) \
+	X(void,							SetBotPlayerCount,						(int cBotplayers), (cBotplayers)) \
+	X(void,							SetServerName,							(const char *pszServerName), (pszServerName)) \
+	X(void,							SetMapName,								(const char *pszMapName), (pszMapName)) \
+	X(void,							SetPasswordProtected,					(bool bPasswordProtected), (bPasswordProtected)) \
+	X(void,							SetSpectatorPort,						(uint16 unSpectatorPort), (unSpectatorPort)) \
+	X(void,							SetSpectatorServerName,					(const char *pszSpectatorServerName), (pszSpectatorServerName)) \
+	X(void,							ClearAllKeyValues,						(), ()) \
+	X(void,							SetKeyValue,							(const char *pKey, const char *pValue), (pKey, pValue)) \
+	X(void,							SetGameTags,							(const char *pchGameTags), (pchGameTags)) \
+	X(void,							SetGameData,							(const char *pchGameData), (pchGameData)) \
+	X(void,							SetRegion,								(const char *pszRegion), (pszRegion)) \
+	X(bool,							SendUserConnectAndAuthenticate,			(uint32 unIPClient, const void *pvAuthBlob, uint32 cubAuthBlobSize, CSteamID *pSteamIDUser), (unIPClient, pvAuthBlob, cubAuthBlobSize, pSteamIDUser)) \
+	X(CSteamID,						CreateUnauthenticatedUserConnection,	(), ()) \
+	X(void,							SendUserDisconnect,						(CSteamID steamIDUser), (steamIDUser)) \
+	X(bool,							BUpdateUserData,						(CSteamID steamIDUser, const char *pchPlayerName, uint32 uScore), (steamIDUser, pchPlayerName, uScore)) \
+	X(HAuthTicket,					GetAuthSessionTicket,					(void *pTicket, int cbMaxTicket, uint32 *pcbTicket), (pTicket, cbMaxTicket, pcbTicket)) \
+	X(EBeginAuthSessionResult,		BeginAuthSession,						(const void *pAuthTicket, int cbAuthTicket, CSteamID steamID), (pAuthTicket, cbAuthTicket, steamID)) \
+	X(void,							EndAuthSession,							(CSteamID steamID), (steamID)) \
+	X(void,							CancelAuthTicket,						(HAuthTicket hAuthTicket), (hAuthTicket)) \
+	X(EUserHasLicenseForAppResult,	UserHasLicenseForApp,					(CSteamID steamID, AppId_t appID), (steamID, appID)) \
+	X(bool,							RequestUserGroupStatus,					(CSteamID steamIDUser, CSteamID steamIDGroup), (steamIDUser, steamIDGroup)) \
+	X(void,							GetGameplayStats,						(), ()) \
+	X(SteamAPICall_t,				GetServerReputation,					(), ()) \
+	X(uint32,						GetPublicIP,							(), ()) \
+	X(bool,							HandleIncomingPacket,					(const void *pData, int cbData, uint32 srcIP, uint16 srcPort), (pData, cbData, srcIP, srcPort)) \
+	X(int,							GetNextOutgoingPacket,					(void *pOut, int cbMaxOut, uint32 *pNetAdr, uint16 *pPort), (pOut, cbMaxOut, pNetAdr, pPort)) \
+	X(void,							EnableHeartbeats,						(bool bActive), (bActive)) \
+	X(void,							SetHeartbeatInterval,					(int iHeartbeatInterval), (iHeartbeatInterval)) \
+	X(void,							ForceHeartbeat,							(), ()) \
+	X(SteamAPICall_t,				AssociateWithClan,						(CSteamID steamIDClan), (steamIDClan)) \
+	X(SteamAPICall_t,				ComputeNewPlayerCompatibility,			(CSteamID steamIDNewPlayer), (steamIDNewPlayer))
+
+#define STEAMGAMESERVERSTATS_INTERFACE_METHODS(X, XO) \
+	X(SteamAPICall_t,				RequestUserStats,						(CSteamID steamIDUser), (steamIDUser)) \
+	XO(bool,						GetUserStat,							int32, (CSteamID steamIDUser, const char *pchName, int32 *pData), (steamIDUser, pchName, pData)) \
+	XO(bool,						GetUserStat,							float, (CSteamID steamIDUser, const char *pchName, float *pData), (steamIDUser, pchName, pData)) \
+	X(bool,							GetUserAchievement,						(CSteamID steamIDUser, const char *pchName, bool *pbAchieved), (steamIDUser, pchName, pbAchieved)) \
+	XO(bool,						SetUserStat,							int32, (CSteamID steamIDUser, const char *pchName, int32 nData), (steamIDUser, pchName, nData)) \
+	XO(bool,						SetUserStat,							float, (CSteamID steamIDUser, const char *pchName, float fData), (steamIDUser, pchName, fData)) \
+	X(bool,							UpdateUserAvgRateStat,					(CSteamID steamIDUser, const char *pchName, float flCountThisSession, double dSessionLength), (steamIDUser, pchName, flCountThisSession, dSessionLength)) \
+	X(bool,							SetUserAchievement,						(CSteamID steamIDUser, const char *pchName), (steamIDUser, pchName)) \
+	X(bool,							ClearUserAchievement,					(CSteamID steamIDUser, const char *pchName), (steamIDUser, pchName)) \
+	X(SteamAPICall_t,				StoreUserStats,							(CSteamID steamIDUser), (steamIDUser))
+
+#define STEAMHTTP_INTERFACE_METHODS(X, XO) \
+	X(HTTPRequestHandle,			CreateHTTPRequest,						(EHTTPMethod eHTTPRequestMethod, const char *pchAbsoluteURL), (eHTTPRequestMethod, pchAbsoluteURL)) \
+	X(bool,							SetHTTPRequestContextValue,				(HTTPRequestHandle hRequest, uint64 ulContextValue), (hRequest, ulContextValue)) \
+	X(bool,							SetHTTPRequestNetworkActivityTimeout,	(HTTPRequestHandle hRequest, uint32 unTimeoutSeconds), (hRequest, unTimeoutSeconds)) \
+	X(bool,							SetHTTPRequestHeaderValue,				(HTTPRequestHandle hRequest, const char *pchHeaderName, const char *pchHeaderValue), (hRequest, pchHeaderName, pchHeaderValue)) \
+	X(bool,							SetHTTPRequestGetOrPostParameter,		(HTTPRequestHandle hRequest, const char *pchParamName, const char *pchParamValue), (hRequest, pchParamName, pchParamValue)) \
+	X(bool,							SendHTTPRequest,						(HTTPRequestHandle hRequest, SteamAPICall_t *pCallHandle), (hRequest, pCallHandle)) \
+	X(bool,							DeferHTTPRequest,						(HTTPRequestHandle hRequest), (hRequest)) \
+	X(bool,							PrioritizeHTTPRequest,					(HTTPRequestHandle hRequest), (hRequest)) \
+	X(bool,							GetHTTPResponseHeaderSize,				(HTTPRequestHandle hRequest, const char *pchHeaderName, uint32 *unResponseHeaderSize), (hRequest, pchHeaderName, unResponseHeaderSize)) \
+	X(bool,							GetHTTPResponseHeaderValue,				(HTTPRequestHandle hRequest, const char *pchHeaderName, uint8 *pHeaderValueBuffer, uint32 unBufferSize), (hRequest, pchHeaderName, pHeaderValueBuffer, unBufferSize)) \
+	X(bool,							GetHTTPResponseBodySize,				(HTTPRequestHandle hRequest, uint32 *unBodySize), (hRequest, unBodySize)) \
+	X(bool,							GetHTTPResponseBodyData,				(HTTPRequestHandle hRequest, uint8 *pBodyDataBuffer, uint32 unBufferSize), (hRequest, pBodyDataBuffer, unBufferSize)) \
+	X(bool,							ReleaseHTTPRequest,						(HTTPRequestHandle hRequest), (hRequest)) \
+	X(bool,							GetHTTPDownloadProgressPct,				(HTTPRequestHandle hRequest, float *pflPercentOut), (hRequest, pflPercentOut)) \
+	X(bool,							SetHTTPRequestRawPostBody,				(HTTPRequestHandle hRequest, const char *pchContentType, uint8 *pubBody, uint32 unBodyLen), (hRequest, pchContentType, pubBody, unBodyLen))
+
+#endif // STEAM_INTERFACE_METHODS_H
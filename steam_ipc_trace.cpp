@@ -0,0 +1,319 @@
+//========= Copyright � 1996-2001, Valve LLC, All rights reserved. ============
+//
+// Purpose: Proxies counting and timing calls to steamclient interfaces.
+//
+// $NoKeywords: $
+//=============================================================================
+
+#include "steam_api_pch.h"
+#include "steam_interface_methods.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <new>
+
+//-----------------------------------------------------------------------------
+// 
+// Trace counters
+// 
+//-----------------------------------------------------------------------------
+
+// Proxies handed out per interface, one for each distinct interface pointer:
+// the user pipe, the game server, each of its instances and a few restarts
+#define MAX_TRACE_PROXIES	(MAX_GAMESERVER_INSTANCES + 8)
+
+struct TraceCounter_t
+{
+	std::atomic<uint64>	m_nCalls;
+	std::atomic<uint64>	m_nTotalNanoseconds;
+	std::atomic<uint64>	m_nMaxNanoseconds;
+};
+
+struct TracedInterface_t
+{
+	const char*			m_pszInterface;
+	const char* const*	m_ppszMethods;
+	TraceCounter_t*		m_pCounters;
+	int					m_cMethods;
+};
+
+static std::atomic<bool>	s_bIPCTracingEnabled(false);
+static std::mutex			s_TraceProxiesLock;
+
+//-----------------------------------------------------------------------------
+// Purpose: Counts one call of the method and the time spent in it
+//-----------------------------------------------------------------------------
+class CTraceScope
+{
+public:
+	CTraceScope(TraceCounter_t *pCounter) : m_pCounter(pCounter), m_Start(std::chrono::steady_clock::now())
+	{
+	}
+
+	~CTraceScope()
+	{
+		uint64 nNanoseconds;
+		uint64 nMax;
+
+		nNanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_Start).count();
+
+		m_pCounter->m_nCalls.fetch_add(1, std::memory_order_relaxed);
+		m_pCounter->m_nTotalNanoseconds.fetch_add(nNanoseconds, std::memory_order_relaxed);
+
+		nMax = m_pCounter->m_nMaxNanoseconds.load(std::memory_order_relaxed);
+		while (nNanoseconds > nMax && !m_pCounter->m_nMaxNanoseconds.compare_exchange_weak(nMax, nNanoseconds, std::memory_order_relaxed))
+			;
+	}
+
+private:
+	TraceCounter_t*							m_pCounter;
+	std::chrono::steady_clock::time_point	m_Start;
+};
+
+//-----------------------------------------------------------------------------
+// 
+// Trace proxies
+// 
+//-----------------------------------------------------------------------------
+
+#define TRACE_METHOD_INDEX(Ret, Name, Params, Args)	k_e##Name,
+#define TRACE_METHOD_NAME(Ret, Name, Params, Args)	#Name,
+#define TRACE_METHOD_PROXY(Ret, Name, Params, Args) \
+	virtual Ret Name Params override \
+	{ \
+		CTraceScope Scope(&s_rgCounters[k_e##Name]); \
+		return m_pInterface->Name Args; \
+	}
+
+#define TRACE_OVERLOAD_INDEX(Ret, Name, Tag, Params, Args)	k_e##Name##_##Tag,
+#define TRACE_OVERLOAD_NAME(Ret, Name, Tag, Params, Args)	#Name "(" #Tag ")",
+#define TRACE_OVERLOAD_PROXY(Ret, Name, Tag, Params, Args) \
+	virtual Ret Name Params override \
+	{ \
+		CTraceScope Scope(&s_rgCounters[k_e##Name##_##Tag]); \
+		return m_pInterface->Name Args; \
+	}
+
+//-----------------------------------------------------------------------------
+// Purpose: Declares Interface##TraceProxy forwarding every method of the list
+//			to the wrapped interface, and the counters they are traced into.
+//-----------------------------------------------------------------------------
+#define DECLARE_TRACE_PROXY(Interface, Methods) \
+	class Interface##TraceProxy : public Interface \
+	{ \
+	public: \
+		enum { Methods(TRACE_METHOD_INDEX, TRACE_OVERLOAD_INDEX) k_cMethods }; \
+		\
+		Interface##TraceProxy(Interface *pInterface) : m_pInterface(pInterface) {} \
+		\
+		Methods(TRACE_METHOD_PROXY, TRACE_OVERLOAD_PROXY) \
+		\
+		Interface*						m_pInterface; \
+		\
+		static const char* const		s_rgpszMethods[k_cMethods]; \
+		static TraceCounter_t			s_rgCounters[k_cMethods]; \
+		static Interface##TraceProxy*	s_rgpProxies[MAX_TRACE_PROXIES]; \
+		static std::atomic<int>			s_cProxies; \
+		static bool						s_bOutOfProxies; \
+	}; \
+	\
+	const char* const Interface##TraceProxy::s_rgpszMethods[k_cMethods] = { Methods(TRACE_METHOD_NAME, TRACE_OVERLOAD_NAME) }; \
+	TraceCounter_t Interface##TraceProxy::s_rgCounters[k_cMethods]; \
+	Interface##TraceProxy* Interface##TraceProxy::s_rgpProxies[MAX_TRACE_PROXIES]; \
+	std::atomic<int> Interface##TraceProxy::s_cProxies(0); \
+	bool Interface##TraceProxy::s_bOutOfProxies; \
+	\
+	Interface* Steam_TraceInterface(Interface *pInterface) \
+	{ \
+		return WrapTracedInterface<Interface##TraceProxy>(pInterface); \
+	}
+
+//-----------------------------------------------------------------------------
+// Purpose: Looks up the proxy wrapping the interface, or the interface being
+//			a proxy itself, among the first cProxies ones.
+//-----------------------------------------------------------------------------
+template <typename Proxy, typename Interface>
+static Proxy* FindTraceProxy(Interface *pInterface, int iFirst, int cProxies)
+{
+	for (int i = iFirst; i < cProxies; i++)
+	{
+		if (Proxy::s_rgpProxies[i]->m_pInterface == pInterface || Proxy::s_rgpProxies[i] == pInterface)
+			return Proxy::s_rgpProxies[i];
+	}
+
+	return nullptr;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Returns the proxy of the interface, creating it on first use. When
+//			tracing is off the interface is returned, unwrapped if it's one of
+//			the proxies, so accessors stop counting as soon as it's turned off.
+// Note:	Called by the accessors on every call, lookups don't lock. Proxies
+//			are never freed, steamclient may hand out the same pointer again
+//			after shutdown and the proxy is reused for it.
+//-----------------------------------------------------------------------------
+template <typename Proxy, typename Interface>
+static Interface* WrapTracedInterface(Interface *pInterface)
+{
+	Proxy*	pProxy;
+	bool	bEnabled;
+	int		cProxies;
+
+	if (!pInterface)
+		return nullptr;
+
+	bEnabled = s_bIPCTracingEnabled.load(std::memory_order_relaxed);
+	cProxies = Proxy::s_cProxies.load(std::memory_order_acquire);
+
+	if (!bEnabled && !cProxies)
+		return pInterface;
+
+	pProxy = FindTraceProxy<Proxy>(pInterface, 0, cProxies);
+
+	if (pProxy)
+		return bEnabled ? pProxy : pProxy->m_pInterface;
+
+	if (!bEnabled)
+		return pInterface;
+
+	std::lock_guard<std::mutex> Lock(s_TraceProxiesLock);
+
+	// Another thread might have created it meanwhile
+	pProxy = FindTraceProxy<Proxy>(pInterface, cProxies, Proxy::s_cProxies.load(std::memory_order_relaxed));
+
+	if (pProxy)
+		return pProxy;
+
+	cProxies = Proxy::s_cProxies.load(std::memory_order_relaxed);
+
+	if (cProxies >= MAX_TRACE_PROXIES)
+	{
+		if (!Proxy::s_bOutOfProxies)
+		{
+			OutputDebugStringA("[S_API FAIL] IPC tracing is out of proxies, further interfaces are handed out untraced.\n");
+			Proxy::s_bOutOfProxies = true;
+		}
+
+		return pInterface;
+	}
+
+	pProxy = new (std::nothrow) Proxy(pInterface);
+
+	if (!pProxy)
+		return pInterface;
+
+	Proxy::s_rgpProxies[cProxies] = pProxy;
+	Proxy::s_cProxies.store(cProxies + 1, std::memory_order_release);
+
+	return pProxy;
+}
+
+DECLARE_TRACE_PROXY(ISteamUser, STEAMUSER_INTERFACE_METHODS)
+DECLARE_TRACE_PROXY(ISteamFriends, STEAMFRIENDS_INTERFACE_METHODS)
+DECLARE_TRACE_PROXY(ISteamUtils, STEAMUTILS_INTERFACE_METHODS)
+DECLARE_TRACE_PROXY(ISteamMatchmaking, STEAMMATCHMAKING_INTERFACE_METHODS)
+DECLARE_TRACE_PROXY(ISteamMatchmakingServers, STEAMMATCHMAKINGSERVERS_INTERFACE_METHODS)
+DECLARE_TRACE_PROXY(ISteamUserStats, STEAMUSERSTATS_INTERFACE_METHODS)
+DECLARE_TRACE_PROXY(ISteamApps, STEAMAPPS_INTERFACE_METHODS)
+DECLARE_TRACE_PROXY(ISteamNetworking, STEAMNETWORKING_INTERFACE_METHODS)
+DECLARE_TRACE_PROXY(ISteamRemoteStorage, STEAMREMOTESTORAGE_INTERFACE_METHODS)
+DECLARE_TRACE_PROXY(ISteamScreenshots, STEAMSCREENSHOTS_INTERFACE_METHODS)
+DECLARE_TRACE_PROXY(ISteamGameServer, STEAMGAMESERVER_INTERFACE_METHODS)
+DECLARE_TRACE_PROXY(ISteamGameServerStats, STEAMGAMESERVERSTATS_INTERFACE_METHODS)
+DECLARE_TRACE_PROXY(ISteamHTTP, STEAMHTTP_INTERFACE_METHODS)
+
+#define TRACED_INTERFACE(Interface)	{ #Interface, Interface##TraceProxy::s_rgpszMethods, Interface##TraceProxy::s_rgCounters, Interface##TraceProxy::k_cMethods }
+
+static const TracedInterface_t s_rgTracedInterfaces[] =
+{
+	TRACED_INTERFACE(ISteamUser),
+	TRACED_INTERFACE(ISteamFriends),
+	TRACED_INTERFACE(ISteamUtils),
+	TRACED_INTERFACE(ISteamMatchmaking),
+	TRACED_INTERFACE(ISteamMatchmakingServers),
+	TRACED_INTERFACE(ISteamUserStats),
+	TRACED_INTERFACE(ISteamApps),
+	TRACED_INTERFACE(ISteamNetworking),
+	TRACED_INTERFACE(ISteamRemoteStorage),
+	TRACED_INTERFACE(ISteamScreenshots),
+	TRACED_INTERFACE(ISteamGameServer),
+	TRACED_INTERFACE(ISteamGameServerStats),
+	TRACED_INTERFACE(ISteamHTTP),
+};
+
+//-----------------------------------------------------------------------------
+// 
+// IPC tracing interface
+// 
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// Purpose: Turns wrapping of fetched interfaces into trace proxies on or off.
+//			The accessors and the interface cache apply it on each call, 
+//			pointers handed out already are kept and proxies among them keep
+//			counting.
+//-----------------------------------------------------------------------------
+void SteamAPI_SetIPCTracingEnabled(bool bEnabled)
+{
+	s_bIPCTracingEnabled.store(bEnabled, std::memory_order_relaxed);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Fills up to cMaxStats entries, one per method that was called, and
+//			returns how many there are.
+//-----------------------------------------------------------------------------
+int SteamAPI_GetIPCTraceStats(SteamIPCTraceStats_t *pStats, int cMaxStats)
+{
+	const TracedInterface_t*	pTraced;
+	TraceCounter_t*				pCounter;
+	int							cStats;
+
+	cStats = 0;
+
+	for (int i = 0; i < Q_ARRAYSIZE(s_rgTracedInterfaces); i++)
+	{
+		pTraced = &s_rgTracedInterfaces[i];
+
+		for (int iMethod = 0; iMethod < pTraced->m_cMethods; iMethod++)
+		{
+			pCounter = &pTraced->m_pCounters[iMethod];
+
+			if (!pCounter->m_nCalls.load(std::memory_order_relaxed))
+				continue;
+
+			if (pStats && cStats < cMaxStats)
+			{
+				pStats[cStats].m_pszInterface = pTraced->m_pszInterface;
+				pStats[cStats].m_pszMethod = pTraced->m_ppszMethods[iMethod];
+				pStats[cStats].m_nCalls = pCounter->m_nCalls.load(std::memory_order_relaxed);
+				pStats[cStats].m_nTotalNanoseconds = pCounter->m_nTotalNanoseconds.load(std::memory_order_relaxed);
+				pStats[cStats].m_nMaxNanoseconds = pCounter->m_nMaxNanoseconds.load(std::memory_order_relaxed);
+			}
+
+			cStats++;
+		}
+	}
+
+	return cStats;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Zeroes all trace counters
+//-----------------------------------------------------------------------------
+void SteamAPI_ResetIPCTraceStats()
+{
+	TraceCounter_t* pCounter;
+
+	for (int i = 0; i < Q_ARRAYSIZE(s_rgTracedInterfaces); i++)
+	{
+		for (int iMethod = 0; iMethod < s_rgTracedInterfaces[i].m_cMethods; iMethod++)
+		{
+			pCounter = &s_rgTracedInterfaces[i].m_pCounters[iMethod];
+
+			pCounter->m_nCalls.store(0, std::memory_order_relaxed);
+			pCounter->m_nTotalNanoseconds.store(0, std::memory_order_relaxed);
+			pCounter->m_nMaxNanoseconds.store(0, std::memory_order_relaxed);
+		}
+	}
+}
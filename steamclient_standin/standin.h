@@ -0,0 +1,110 @@
+//========= Copyright  1996-2001, Valve LLC, All rights reserved. ============
+//
+// Purpose: Stand-in for steamclient. Exports the SteamClient012 factory and
+//			the routines the callback manager pulls messages and call results
+//			through, and replays a scenario file instead of talking to Steam.
+//			Point SteamClientModuleOverride at the built library to run this
+//			module offline.
+//
+// $NoKeywords: $
+//=============================================================================
+#ifndef STANDIN_H
+#define STANDIN_H
+#pragma once
+
+//-----------------------------------------------------------------------------
+//
+// Scenario file
+//
+// Path is taken from STANDIN_SCENARIO_ENV when the factory is first asked for
+// the client, with no file set nothing but the identity below is replayed.
+// One entry per line, '#' starts a comment:
+//
+//	appid <AppId_t>
+//		Returned by GetAppID(), the SteamAppId environment variable otherwise.
+//
+//	steamid <64-bit SteamID>
+//		Returned by GetSteamID() of users, game servers get the same one.
+//
+//	seed <number>
+//		Seeds call result delays and failures, 1 by default.
+//
+//	callback <iCallback> rate <per second> size <bytes> [pipe client|gameserver] [start <seconds>] [stop <seconds>]
+//		Messages posted on every pipe (or pipes of the given kind) at the rate,
+//		counted from creation of the pipe. Payloads are zero-filled.
+//
+//	callresult <method> <iCallback> size <bytes> delay <ms>[-<ms>] [fail <fraction>]
+//		Makes the interface method of that name return an API call, which is
+//		completed after the delay, uniformly picked from the range. The given
+//		fraction of them completes with an IO failure. Methods without an
+//		entry return k_uAPICallInvalid.
+//
+// Everything due is delivered in one frame, the time is taken when a frame
+// starts pulling messages, so a high rate can't keep a frame running forever.
+//
+//-----------------------------------------------------------------------------
+
+#define STANDIN_SCENARIO_ENV			"SteamClientStandInScenario"
+
+#define MAX_STANDIN_PIPES				64
+#define MAX_STANDIN_CALLBACK_RULES		64
+#define MAX_STANDIN_CALLRESULT_RULES	64
+#define MAX_STANDIN_METHOD_NAME			64
+
+enum EStandInPipeKind
+{
+	k_EStandInPipeAny = 0,
+	k_EStandInPipeClient,
+	k_EStandInPipeGameServer,
+};
+
+struct StandInCallbackRule_t
+{
+	int					m_iCallback;
+	int					m_cubParam;
+	double				m_flRate;				// Messages per second
+	double				m_flStart;				// Seconds since the pipe was created
+	double				m_flStop;				// 0 runs forever
+	EStandInPipeKind	m_ePipeKind;
+};
+
+struct StandInCallResultRule_t
+{
+	char				m_szMethod[MAX_STANDIN_METHOD_NAME];
+	int					m_iCallback;
+	int					m_cubParam;
+	uint32				m_unMinDelayMs;
+	uint32				m_unMaxDelayMs;
+	double				m_flFailRate;
+};
+
+struct StandInScenario_t
+{
+	AppId_t						m_nAppID;
+	uint64						m_ulSteamID;
+	uint32						m_unSeed;
+
+	StandInCallbackRule_t		m_rgCallbacks[MAX_STANDIN_CALLBACK_RULES];
+	int							m_cCallbacks;
+
+	StandInCallResultRule_t		m_rgCallResults[MAX_STANDIN_CALLRESULT_RULES];
+	int							m_cCallResults;
+};
+
+// standin_scenario.cpp
+extern bool StandIn_ParseScenario(const char *pszPath, StandInScenario_t *pScenario);
+extern const StandInScenario_t* StandIn_GetScenario();
+extern bool StandIn_LoadScenario();
+
+// standin_replay.cpp
+extern HSteamPipe StandIn_CreatePipe(EStandInPipeKind eKind);
+extern bool StandIn_ReleasePipe(HSteamPipe hSteamPipe);
+extern void StandIn_SetPipeKind(HSteamPipe hSteamPipe, EStandInPipeKind eKind);
+extern bool StandIn_IsPipeValid(HSteamPipe hSteamPipe);
+extern bool StandIn_AnyPipeOpen();
+extern SteamAPICall_t StandIn_IssueAPICall(HSteamPipe hSteamPipe, const char *pszMethod);
+extern bool StandIn_IsAPICallCompleted(HSteamPipe hSteamPipe, SteamAPICall_t hAPICall, bool *pbFailed);
+extern ESteamAPICallFailure StandIn_GetAPICallFailureReason(HSteamPipe hSteamPipe, SteamAPICall_t hAPICall);
+extern bool StandIn_GetAPICallResult(HSteamPipe hSteamPipe, SteamAPICall_t hAPICall, void *pCallback, int cubCallback, int iCallbackExpected, bool *pbFailed);
+
+#endif // STANDIN_H
@@ -0,0 +1,405 @@
+//========= Copyright  1996-2001, Valve LLC, All rights reserved. ============
+//
+// Purpose: SteamClient012 of the steamclient stand-in and the interfaces it
+//			hands out. Every method of an interface is generated from its list,
+//			the few that initialization and call results depend on answer from
+//			the scenario.
+//
+// $NoKeywords: $
+//=============================================================================
+
+#include "steam_api_pch.h"
+#include "steam_interface_methods.h"
+#include "standin.h"
+
+#include <atomic>
+#include <mutex>
+
+//-----------------------------------------------------------------------------
+// Purpose: Result of a generated method. Methods returning an API call, or
+//			anything else of the same type, return one if the scenario has an
+//			entry for them.
+//-----------------------------------------------------------------------------
+template<class Ret>
+struct StandInResult
+{
+	static Ret Get(HSteamPipe hSteamPipe, const char *pszMethod)
+	{
+		return Ret();
+	}
+};
+
+template<>
+struct StandInResult<void>
+{
+	static void Get(HSteamPipe hSteamPipe, const char *pszMethod)
+	{
+	}
+};
+
+template<>
+struct StandInResult<const char*>
+{
+	static const char* Get(HSteamPipe hSteamPipe, const char *pszMethod)
+	{
+		return "";
+	}
+};
+
+template<>
+struct StandInResult<SteamAPICall_t>
+{
+	static SteamAPICall_t Get(HSteamPipe hSteamPipe, const char *pszMethod)
+	{
+		return StandIn_IssueAPICall(hSteamPipe, pszMethod);
+	}
+};
+
+#define STANDIN_METHOD(Ret, Name, Params, Args) \
+	virtual Ret Name Params \
+	{ \
+		return StandInResult<Ret>::Get(m_hSteamPipe, #Name); \
+	}
+
+#define STANDIN_OVERLOAD(Ret, Name, Tag, Params, Args) \
+	STANDIN_METHOD(Ret, Name, Params, Args)
+
+//-----------------------------------------------------------------------------
+// Purpose: Declares Interface##StandIn implementing every method of the list
+//			for one pipe.
+//-----------------------------------------------------------------------------
+#define DECLARE_STANDIN_INTERFACE(Interface, Methods) \
+	class Interface##StandIn : public Interface \
+	{ \
+	public: \
+		Interface##StandIn(HSteamPipe hSteamPipe) : \
+			m_hSteamPipe(hSteamPipe) \
+		{ \
+		} \
+		\
+		Methods(STANDIN_METHOD, STANDIN_OVERLOAD) \
+		\
+	protected: \
+		HSteamPipe m_hSteamPipe; \
+	};
+
+DECLARE_STANDIN_INTERFACE(ISteamUser, STEAMUSER_INTERFACE_METHODS)
+DECLARE_STANDIN_INTERFACE(ISteamFriends, STEAMFRIENDS_INTERFACE_METHODS)
+DECLARE_STANDIN_INTERFACE(ISteamUtils, STEAMUTILS_INTERFACE_METHODS)
+DECLARE_STANDIN_INTERFACE(ISteamMatchmaking, STEAMMATCHMAKING_INTERFACE_METHODS)
+DECLARE_STANDIN_INTERFACE(ISteamMatchmakingServers, STEAMMATCHMAKINGSERVERS_INTERFACE_METHODS)
+DECLARE_STANDIN_INTERFACE(ISteamUserStats, STEAMUSERSTATS_INTERFACE_METHODS)
+DECLARE_STANDIN_INTERFACE(ISteamApps, STEAMAPPS_INTERFACE_METHODS)
+DECLARE_STANDIN_INTERFACE(ISteamNetworking, STEAMNETWORKING_INTERFACE_METHODS)
+DECLARE_STANDIN_INTERFACE(ISteamRemoteStorage, STEAMREMOTESTORAGE_INTERFACE_METHODS)
+DECLARE_STANDIN_INTERFACE(ISteamScreenshots, STEAMSCREENSHOTS_INTERFACE_METHODS)
+DECLARE_STANDIN_INTERFACE(ISteamGameServer, STEAMGAMESERVER_INTERFACE_METHODS)
+DECLARE_STANDIN_INTERFACE(ISteamGameServerStats, STEAMGAMESERVERSTATS_INTERFACE_METHODS)
+DECLARE_STANDIN_INTERFACE(ISteamHTTP, STEAMHTTP_INTERFACE_METHODS)
+
+//-----------------------------------------------------------------------------
+// Purpose: User of the pipe, logged on with the scenario's SteamID
+//-----------------------------------------------------------------------------
+class CSteamUserStandIn : public ISteamUserStandIn
+{
+public:
+	CSteamUserStandIn(HSteamPipe hSteamPipe) :
+		ISteamUserStandIn(hSteamPipe)
+	{
+	}
+
+	virtual HSteamUser GetHSteamUser()
+	{
+		return m_hSteamPipe;
+	}
+
+	virtual bool BLoggedOn()
+	{
+		return true;
+	}
+
+	virtual CSteamID GetSteamID()
+	{
+		return CSteamID(StandIn_GetScenario()->m_ulSteamID);
+	}
+};
+
+//-----------------------------------------------------------------------------
+// Purpose: Utils of the pipe, API calls are looked up on the pipe
+//-----------------------------------------------------------------------------
+class CSteamUtilsStandIn : public ISteamUtilsStandIn
+{
+public:
+	CSteamUtilsStandIn(HSteamPipe hSteamPipe) :
+		ISteamUtilsStandIn(hSteamPipe)
+	{
+	}
+
+	virtual EUniverse GetConnectedUniverse()
+	{
+		return k_EUniversePublic;
+	}
+
+	virtual uint32 GetAppID()
+	{
+		return StandIn_GetScenario()->m_nAppID;
+	}
+
+	virtual bool IsAPICallCompleted(SteamAPICall_t hSteamAPICall, bool *pbFailed)
+	{
+		return StandIn_IsAPICallCompleted(m_hSteamPipe, hSteamAPICall, pbFailed);
+	}
+
+	virtual ESteamAPICallFailure GetAPICallFailureReason(SteamAPICall_t hSteamAPICall)
+	{
+		return StandIn_GetAPICallFailureReason(m_hSteamPipe, hSteamAPICall);
+	}
+
+	virtual bool GetAPICallResult(SteamAPICall_t hSteamAPICall, void *pCallback, int cubCallback, int iCallbackExpected, bool *pbFailed)
+	{
+		return StandIn_GetAPICallResult(m_hSteamPipe, hSteamAPICall, pCallback, cubCallback, iCallbackExpected, pbFailed);
+	}
+};
+
+//-----------------------------------------------------------------------------
+// Purpose: Game server of the pipe, logged on with the scenario's SteamID
+//-----------------------------------------------------------------------------
+class CSteamGameServerStandIn : public ISteamGameServerStandIn
+{
+public:
+	CSteamGameServerStandIn(HSteamPipe hSteamPipe) :
+		ISteamGameServerStandIn(hSteamPipe)
+	{
+	}
+
+	virtual bool BLoggedOn()
+	{
+		return true;
+	}
+
+	virtual CSteamID GetSteamID()
+	{
+		return CSteamID(StandIn_GetScenario()->m_ulSteamID);
+	}
+};
+
+//-----------------------------------------------------------------------------
+// Purpose: HTTP of the pipe. Requests get handles, sending one issues the API
+//			call of the "SendHTTPRequest" scenario entry.
+//-----------------------------------------------------------------------------
+class CSteamHTTPStandIn : public ISteamHTTPStandIn
+{
+public:
+	CSteamHTTPStandIn(HSteamPipe hSteamPipe) :
+		ISteamHTTPStandIn(hSteamPipe)
+	{
+	}
+
+	virtual HTTPRequestHandle CreateHTTPRequest(EHTTPMethod eHTTPRequestMethod, const char *pchAbsoluteURL)
+	{
+		static std::atomic<HTTPRequestHandle> s_hNextRequest(1);
+
+		return s_hNextRequest.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	virtual bool SendHTTPRequest(HTTPRequestHandle hRequest, SteamAPICall_t *pCallHandle)
+	{
+		SteamAPICall_t hAPICall;
+
+		hAPICall = StandIn_IssueAPICall(m_hSteamPipe, "SendHTTPRequest");
+
+		if (pCallHandle)
+			*pCallHandle = hAPICall;
+
+		return hAPICall != k_uAPICallInvalid;
+	}
+
+	virtual bool ReleaseHTTPRequest(HTTPRequestHandle hRequest)
+	{
+		return true;
+	}
+};
+
+//-----------------------------------------------------------------------------
+// Purpose: Interface of the pipe, created on first use. Kept for good, pipe
+//			handles are reused and pointers handed out stay valid.
+//-----------------------------------------------------------------------------
+static std::mutex s_InterfacesLock;
+
+template<class StandIn>
+static StandIn* GetStandInInterface(HSteamPipe hSteamPipe)
+{
+	static StandIn* s_rgpInterfaces[MAX_STANDIN_PIPES];
+
+	if (!StandIn_IsPipeValid(hSteamPipe))
+		return nullptr;
+
+	std::lock_guard<std::mutex> Lock(s_InterfacesLock);
+
+	if (!s_rgpInterfaces[hSteamPipe - 1])
+		s_rgpInterfaces[hSteamPipe - 1] = new StandIn(hSteamPipe);
+
+	return s_rgpInterfaces[hSteamPipe - 1];
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: SteamClient012 handing out stand-in interfaces. Interface versions
+//			aren't looked at, the lists match the ones this module fetches.
+// Note:	Must declare every method of SteamClient012, in the same order.
+//-----------------------------------------------------------------------------
+class CSteamClientStandIn : public ISteamClient
+{
+public:
+	virtual HSteamPipe CreateSteamPipe()
+	{
+		return StandIn_CreatePipe(k_EStandInPipeClient);
+	}
+
+	virtual bool BReleaseSteamPipe(HSteamPipe hSteamPipe)
+	{
+		return StandIn_ReleasePipe(hSteamPipe);
+	}
+
+	virtual HSteamUser ConnectToGlobalUser(HSteamPipe hSteamPipe)
+	{
+		if (!StandIn_IsPipeValid(hSteamPipe))
+			return 0;
+
+		StandIn_SetPipeKind(hSteamPipe, k_EStandInPipeClient);
+		return hSteamPipe;
+	}
+
+	virtual HSteamUser CreateLocalUser(HSteamPipe *phSteamPipe, EAccountType eAccountType)
+	{
+		EStandInPipeKind eKind;
+
+		eKind = (eAccountType == k_EAccountTypeGameServer) ? k_EStandInPipeGameServer : k_EStandInPipeClient;
+
+		if (!*phSteamPipe)
+			*phSteamPipe = StandIn_CreatePipe(eKind);
+		else if (StandIn_IsPipeValid(*phSteamPipe))
+			StandIn_SetPipeKind(*phSteamPipe, eKind);
+		else
+			return 0;
+
+		return *phSteamPipe;
+	}
+
+	virtual void ReleaseUser(HSteamPipe hSteamPipe, HSteamUser hUser)
+	{
+	}
+
+	virtual ISteamUser* GetISteamUser(HSteamUser hSteamUser, HSteamPipe hSteamPipe, const char *pchVersion)
+	{
+		return GetStandInInterface<CSteamUserStandIn>(hSteamPipe);
+	}
+
+	virtual ISteamGameServer* GetISteamGameServer(HSteamUser hSteamUser, HSteamPipe hSteamPipe, const char *pchVersion)
+	{
+		return GetStandInInterface<CSteamGameServerStandIn>(hSteamPipe);
+	}
+
+	virtual void SetLocalIPBinding(uint32 unIP, uint16 usPort)
+	{
+	}
+
+	virtual ISteamFriends* GetISteamFriends(HSteamUser hSteamUser, HSteamPipe hSteamPipe, const char *pchVersion)
+	{
+		return GetStandInInterface<ISteamFriendsStandIn>(hSteamPipe);
+	}
+
+	virtual ISteamUtils* GetISteamUtils(HSteamPipe hSteamPipe, const char *pchVersion)
+	{
+		return GetStandInInterface<CSteamUtilsStandIn>(hSteamPipe);
+	}
+
+	virtual ISteamMatchmaking* GetISteamMatchmaking(HSteamUser hSteamUser, HSteamPipe hSteamPipe, const char *pchVersion)
+	{
+		return GetStandInInterface<ISteamMatchmakingStandIn>(hSteamPipe);
+	}
+
+	virtual ISteamMatchmakingServers* GetISteamMatchmakingServers(HSteamUser hSteamUser, HSteamPipe hSteamPipe, const char *pchVersion)
+	{
+		return GetStandInInterface<ISteamMatchmakingServersStandIn>(hSteamPipe);
+	}
+
+	virtual void* GetISteamGenericInterface(HSteamUser hSteamUser, HSteamPipe hSteamPipe, const char *pchVersion)
+	{
+		return nullptr;
+	}
+
+	virtual ISteamUserStats* GetISteamUserStats(HSteamUser hSteamUser, HSteamPipe hSteamPipe, const char *pchVersion)
+	{
+		return GetStandInInterface<ISteamUserStatsStandIn>(hSteamPipe);
+	}
+
+	virtual ISteamGameServerStats* GetISteamGameServerStats(HSteamUser hSteamUser, HSteamPipe hSteamPipe, const char *pchVersion)
+	{
+		return GetStandInInterface<ISteamGameServerStatsStandIn>(hSteamPipe);
+	}
+
+	virtual ISteamApps* GetISteamApps(HSteamUser hSteamUser, HSteamPipe hSteamPipe, const char *pchVersion)
+	{
+		return GetStandInInterface<ISteamAppsStandIn>(hSteamPipe);
+	}
+
+	virtual ISteamNetworking* GetISteamNetworking(HSteamUser hSteamUser, HSteamPipe hSteamPipe, const char *pchVersion)
+	{
+		return GetStandInInterface<ISteamNetworkingStandIn>(hSteamPipe);
+	}
+
+	virtual ISteamRemoteStorage* GetISteamRemoteStorage(HSteamUser hSteamUser, HSteamPipe hSteamPipe, const char *pchVersion)
+	{
+		return GetStandInInterface<ISteamRemoteStorageStandIn>(hSteamPipe);
+	}
+
+	virtual ISteamScreenshots* GetISteamScreenshots(HSteamUser hSteamUser, HSteamPipe hSteamPipe, const char *pchVersion)
+	{
+		return GetStandInInterface<ISteamScreenshotsStandIn>(hSteamPipe);
+	}
+
+	virtual void RunFrame()
+	{
+	}
+
+	virtual uint32 GetIPCCallCount()
+	{
+		return 0;
+	}
+
+	virtual void SetWarningMessageHook(SteamAPIWarningMessageHook_t pFunction)
+	{
+	}
+
+	virtual bool BShutdownIfAllPipesClosed()
+	{
+		return !StandIn_AnyPipeOpen();
+	}
+
+	virtual ISteamHTTP* GetISteamHTTP(HSteamUser hSteamUser, HSteamPipe hSteamPipe, const char *pchVersion)
+	{
+		return GetStandInInterface<CSteamHTTPStandIn>(hSteamPipe);
+	}
+};
+
+static CSteamClientStandIn s_SteamClient;
+
+//-----------------------------------------------------------------------------
+// Purpose: Factory resolved by Sys_GetFactory(). Hands out SteamClient012 once
+//			the scenario is loaded, nothing if it's broken.
+//-----------------------------------------------------------------------------
+S_API void* CreateInterface(const char *pName, int *pReturnCode)
+{
+	if (!strcmp(pName, "SteamClient012") && StandIn_LoadScenario())
+	{
+		if (pReturnCode)
+			*pReturnCode = IFACE_OK;
+
+		return &s_SteamClient;
+	}
+
+	if (pReturnCode)
+		*pReturnCode = IFACE_FAILED;
+
+	return nullptr;
+}
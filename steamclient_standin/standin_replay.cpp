@@ -0,0 +1,457 @@
+//========= Copyright  1996-2001, Valve LLC, All rights reserved. ============
+//
+// Purpose: Replays the scenario on pipes of the steamclient stand-in and
+//			exports the routines the callback manager pulls messages and call
+//			results through.
+//
+// $NoKeywords: $
+//=============================================================================
+
+#include "steam_api_pch.h"
+#include "standin.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+typedef std::chrono::steady_clock::time_point StandInTime_t;
+
+struct StandInAPICall_t
+{
+	int		m_iCallback;
+	int		m_cubParam;
+	bool	m_bFailed;
+	bool	m_bCompleted;
+	bool	m_bMismatched;
+};
+
+struct StandInDueCall_t
+{
+	StandInTime_t	m_Due;
+	SteamAPICall_t	m_hAPICall;
+
+	// Earliest on top of the heap
+	bool operator<(const StandInDueCall_t &Other) const
+	{
+		return m_Due > Other.m_Due;
+	}
+};
+
+//-----------------------------------------------------------------------------
+// Purpose: Replay state of one pipe. Its user has the same handle.
+//-----------------------------------------------------------------------------
+struct StandInPipe_t
+{
+	std::mutex								m_Lock;
+	std::atomic<bool>						m_bOpen;
+	EStandInPipeKind						m_eKind;
+
+	StandInTime_t							m_Created;
+
+	// Taken when a frame starts pulling messages, everything due by then is
+	// delivered in that frame
+	StandInTime_t							m_FrameTime;
+	bool									m_bInFrame;
+
+	// Messages of each callback rule delivered so far
+	uint64									m_rgnDelivered[MAX_STANDIN_CALLBACK_RULES];
+	int										m_iNextRule;
+
+	// Calls waiting for their delay to pass, and all calls not fetched yet
+	std::vector<StandInDueCall_t>			m_DueCalls;
+	std::unordered_map<SteamAPICall_t,
+					   StandInAPICall_t>	m_APICalls;
+
+	std::mt19937							m_Random;
+
+	// Zero-filled payload of every message, and the completion message
+	std::vector<uint8>						m_Payload;
+	SteamAPICallCompleted_t					m_Completed;
+};
+
+static StandInPipe_t				s_rgPipes[MAX_STANDIN_PIPES];
+static std::mutex					s_PipesLock;
+static std::atomic<SteamAPICall_t>	s_hNextAPICall(1);
+
+//-----------------------------------------------------------------------------
+// Purpose: Returns the open pipe, nullptr for unknown handles
+//-----------------------------------------------------------------------------
+static StandInPipe_t* FindPipe(HSteamPipe hSteamPipe)
+{
+	StandInPipe_t* pPipe;
+
+	if (hSteamPipe <= 0 || hSteamPipe > MAX_STANDIN_PIPES)
+		return nullptr;
+
+	pPipe = &s_rgPipes[hSteamPipe - 1];
+
+	if (!pPipe->m_bOpen.load(std::memory_order_acquire))
+		return nullptr;
+
+	return pPipe;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Number of messages of the rule due by the time
+//-----------------------------------------------------------------------------
+static uint64 GetMessagesDue(const StandInCallbackRule_t &Rule, double flElapsed)
+{
+	if (Rule.m_flStop && flElapsed > Rule.m_flStop)
+		flElapsed = Rule.m_flStop;
+
+	if (flElapsed <= Rule.m_flStart)
+		return 0;
+
+	return (uint64)((flElapsed - Rule.m_flStart) * Rule.m_flRate);
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Opens a pipe, messages of the scenario are counted from now
+//-----------------------------------------------------------------------------
+HSteamPipe StandIn_CreatePipe(EStandInPipeKind eKind)
+{
+	const StandInScenario_t*	pScenario;
+	StandInPipe_t*				pPipe;
+	int							cubPayload;
+	int							i;
+
+	pScenario = StandIn_GetScenario();
+
+	std::lock_guard<std::mutex> Lock(s_PipesLock);
+
+	for (i = 0; i < MAX_STANDIN_PIPES; i++)
+	{
+		if (!s_rgPipes[i].m_bOpen.load(std::memory_order_relaxed))
+			break;
+	}
+
+	if (i == MAX_STANDIN_PIPES)
+		return 0;
+
+	pPipe = &s_rgPipes[i];
+
+	cubPayload = 0;
+	for (int iRule = 0; iRule < pScenario->m_cCallbacks; iRule++)
+		cubPayload = std::max(cubPayload, pScenario->m_rgCallbacks[iRule].m_cubParam);
+
+	{
+		std::lock_guard<std::mutex> PipeLock(pPipe->m_Lock);
+
+		pPipe->m_eKind = eKind;
+		pPipe->m_Created = std::chrono::steady_clock::now();
+		pPipe->m_bInFrame = false;
+		pPipe->m_iNextRule = 0;
+		memset(pPipe->m_rgnDelivered, 0, sizeof(pPipe->m_rgnDelivered));
+
+		pPipe->m_DueCalls.clear();
+		pPipe->m_APICalls.clear();
+
+		// Same scenario replays the same way on the same pipe
+		pPipe->m_Random.seed(pScenario->m_unSeed + i);
+
+		pPipe->m_Payload.assign(cubPayload, 0);
+	}
+
+	pPipe->m_bOpen.store(true, std::memory_order_release);
+
+	return i + 1;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Closes the pipe, its outstanding calls are dropped
+//-----------------------------------------------------------------------------
+bool StandIn_ReleasePipe(HSteamPipe hSteamPipe)
+{
+	StandInPipe_t* pPipe;
+
+	std::lock_guard<std::mutex> Lock(s_PipesLock);
+
+	pPipe = FindPipe(hSteamPipe);
+	if (!pPipe)
+		return false;
+
+	std::lock_guard<std::mutex> PipeLock(pPipe->m_Lock);
+
+	pPipe->m_DueCalls.clear();
+	pPipe->m_APICalls.clear();
+	pPipe->m_bOpen.store(false, std::memory_order_release);
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Tells which callback rules apply to the pipe, set once its user is
+//			known.
+//-----------------------------------------------------------------------------
+void StandIn_SetPipeKind(HSteamPipe hSteamPipe, EStandInPipeKind eKind)
+{
+	StandInPipe_t* pPipe;
+
+	pPipe = FindPipe(hSteamPipe);
+	if (!pPipe)
+		return;
+
+	std::lock_guard<std::mutex> Lock(pPipe->m_Lock);
+
+	pPipe->m_eKind = eKind;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose:
+//-----------------------------------------------------------------------------
+bool StandIn_IsPipeValid(HSteamPipe hSteamPipe)
+{
+	return FindPipe(hSteamPipe) != nullptr;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose:
+//-----------------------------------------------------------------------------
+bool StandIn_AnyPipeOpen()
+{
+	for (int i = 0; i < MAX_STANDIN_PIPES; i++)
+	{
+		if (s_rgPipes[i].m_bOpen.load(std::memory_order_acquire))
+			return true;
+	}
+
+	return false;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Returns a new API call if the scenario has an entry for the method,
+//			k_uAPICallInvalid otherwise. It's completed once its delay passes.
+//-----------------------------------------------------------------------------
+SteamAPICall_t StandIn_IssueAPICall(HSteamPipe hSteamPipe, const char *pszMethod)
+{
+	const StandInScenario_t*		pScenario;
+	const StandInCallResultRule_t*	pRule;
+	StandInPipe_t*					pPipe;
+	StandInAPICall_t				APICall;
+	StandInDueCall_t				DueCall;
+	uint32							unDelayMs;
+
+	pScenario = StandIn_GetScenario();
+	pRule = nullptr;
+
+	for (int i = 0; i < pScenario->m_cCallResults; i++)
+	{
+		if (!strcmp(pScenario->m_rgCallResults[i].m_szMethod, pszMethod))
+		{
+			pRule = &pScenario->m_rgCallResults[i];
+			break;
+		}
+	}
+
+	if (!pRule)
+		return k_uAPICallInvalid;
+
+	pPipe = FindPipe(hSteamPipe);
+	if (!pPipe)
+		return k_uAPICallInvalid;
+
+	std::lock_guard<std::mutex> Lock(pPipe->m_Lock);
+
+	unDelayMs = std::uniform_int_distribution<uint32>(pRule->m_unMinDelayMs, pRule->m_unMaxDelayMs)(pPipe->m_Random);
+
+	APICall.m_iCallback = pRule->m_iCallback;
+	APICall.m_cubParam = pRule->m_cubParam;
+	APICall.m_bFailed = std::uniform_real_distribution<double>(0.0, 1.0)(pPipe->m_Random) < pRule->m_flFailRate;
+	APICall.m_bCompleted = false;
+	APICall.m_bMismatched = false;
+
+	DueCall.m_Due = std::chrono::steady_clock::now() + std::chrono::milliseconds(unDelayMs);
+	DueCall.m_hAPICall = s_hNextAPICall.fetch_add(1, std::memory_order_relaxed);
+
+	pPipe->m_APICalls.emplace(DueCall.m_hAPICall, APICall);
+	pPipe->m_DueCalls.push_back(DueCall);
+	std::push_heap(pPipe->m_DueCalls.begin(), pPipe->m_DueCalls.end());
+
+	return DueCall.m_hAPICall;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: ISteamUtils::IsAPICallCompleted() of the pipe
+//-----------------------------------------------------------------------------
+bool StandIn_IsAPICallCompleted(HSteamPipe hSteamPipe, SteamAPICall_t hAPICall, bool *pbFailed)
+{
+	StandInPipe_t* pPipe;
+
+	pPipe = FindPipe(hSteamPipe);
+	if (!pPipe)
+		return false;
+
+	std::lock_guard<std::mutex> Lock(pPipe->m_Lock);
+
+	auto it = pPipe->m_APICalls.find(hAPICall);
+	if (it == pPipe->m_APICalls.end() || !it->second.m_bCompleted)
+		return false;
+
+	if (pbFailed)
+		*pbFailed = it->second.m_bFailed;
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: ISteamUtils::GetAPICallFailureReason() of the pipe
+//-----------------------------------------------------------------------------
+ESteamAPICallFailure StandIn_GetAPICallFailureReason(HSteamPipe hSteamPipe, SteamAPICall_t hAPICall)
+{
+	StandInPipe_t* pPipe;
+
+	pPipe = FindPipe(hSteamPipe);
+	if (!pPipe)
+		return k_ESteamAPICallFailureInvalidHandle;
+
+	std::lock_guard<std::mutex> Lock(pPipe->m_Lock);
+
+	auto it = pPipe->m_APICalls.find(hAPICall);
+	if (it == pPipe->m_APICalls.end())
+		return k_ESteamAPICallFailureInvalidHandle;
+
+	if (it->second.m_bMismatched)
+		return k_ESteamAPICallFailureMismatchedCallback;
+
+	if (it->second.m_bCompleted && it->second.m_bFailed)
+		return k_ESteamAPICallFailureNetworkFailure;
+
+	return k_ESteamAPICallFailureNone;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Hands out the zero-filled result of a completed call and forgets
+//			it. Like Steam, the expected callback and size must match the ones
+//			the call was issued with.
+//-----------------------------------------------------------------------------
+bool StandIn_GetAPICallResult(HSteamPipe hSteamPipe, SteamAPICall_t hAPICall, void *pCallback, int cubCallback, int iCallbackExpected, bool *pbFailed)
+{
+	StandInPipe_t* pPipe;
+
+	pPipe = FindPipe(hSteamPipe);
+	if (!pPipe)
+		return false;
+
+	std::lock_guard<std::mutex> Lock(pPipe->m_Lock);
+
+	auto it = pPipe->m_APICalls.find(hAPICall);
+	if (it == pPipe->m_APICalls.end() || !it->second.m_bCompleted)
+		return false;
+
+	if (it->second.m_iCallback != iCallbackExpected || it->second.m_cubParam != cubCallback)
+	{
+		it->second.m_bMismatched = true;
+
+		if (pbFailed)
+			*pbFailed = true;
+
+		return false;
+	}
+
+	memset(pCallback, 0, cubCallback);
+
+	if (pbFailed)
+		*pbFailed = it->second.m_bFailed;
+
+	pPipe->m_APICalls.erase(it);
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+//
+// Callback routines resolved by the callback manager
+//
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// Purpose: Next message of the pipe. Completions of due calls go first, then
+//			callback rules take turns. The message is valid until the next one
+//			is asked for.
+//-----------------------------------------------------------------------------
+S_API bool Steam_BGetCallback(HSteamPipe hSteamPipe, CallbackMsg_t *pCallbackMsg)
+{
+	const StandInScenario_t*		pScenario;
+	const StandInCallbackRule_t*	pRule;
+	StandInPipe_t*					pPipe;
+	double							flElapsed;
+	int								iRule;
+
+	pPipe = FindPipe(hSteamPipe);
+	if (!pPipe)
+		return false;
+
+	pScenario = StandIn_GetScenario();
+
+	std::lock_guard<std::mutex> Lock(pPipe->m_Lock);
+
+	if (!pPipe->m_bInFrame)
+	{
+		pPipe->m_FrameTime = std::chrono::steady_clock::now();
+		pPipe->m_bInFrame = true;
+	}
+
+	pCallbackMsg->m_hSteamUser = hSteamPipe;
+
+	if (!pPipe->m_DueCalls.empty() && pPipe->m_DueCalls.front().m_Due <= pPipe->m_FrameTime)
+	{
+		std::pop_heap(pPipe->m_DueCalls.begin(), pPipe->m_DueCalls.end());
+
+		memset(&pPipe->m_Completed, 0, sizeof(pPipe->m_Completed));
+		pPipe->m_Completed.m_hAsyncCall = pPipe->m_DueCalls.back().m_hAPICall;
+		pPipe->m_DueCalls.pop_back();
+
+		pPipe->m_APICalls[pPipe->m_Completed.m_hAsyncCall].m_bCompleted = true;
+
+		pCallbackMsg->m_iCallback = SteamAPICallCompleted_t::k_iCallback;
+		pCallbackMsg->m_pubParam = reinterpret_cast<uint8*>(&pPipe->m_Completed);
+		pCallbackMsg->m_cubParam = sizeof(pPipe->m_Completed);
+		return true;
+	}
+
+	flElapsed = std::chrono::duration<double>(pPipe->m_FrameTime - pPipe->m_Created).count();
+
+	for (int i = 0; i < pScenario->m_cCallbacks; i++)
+	{
+		iRule = (pPipe->m_iNextRule + i) % pScenario->m_cCallbacks;
+		pRule = &pScenario->m_rgCallbacks[iRule];
+
+		if (pRule->m_ePipeKind != k_EStandInPipeAny && pRule->m_ePipeKind != pPipe->m_eKind)
+			continue;
+
+		if (pPipe->m_rgnDelivered[iRule] >= GetMessagesDue(*pRule, flElapsed))
+			continue;
+
+		pPipe->m_rgnDelivered[iRule]++;
+		pPipe->m_iNextRule = iRule + 1;
+
+		pCallbackMsg->m_iCallback = pRule->m_iCallback;
+		pCallbackMsg->m_pubParam = pPipe->m_Payload.data();
+		pCallbackMsg->m_cubParam = pRule->m_cubParam;
+		return true;
+	}
+
+	// Nothing left for this frame
+	pPipe->m_bInFrame = false;
+
+	return false;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Messages point into pipe state that is reused, nothing to free
+//-----------------------------------------------------------------------------
+S_API void Steam_FreeLastCallback(HSteamPipe hSteamPipe)
+{
+}
+
+//-----------------------------------------------------------------------------
+// Purpose:
+//-----------------------------------------------------------------------------
+S_API bool Steam_GetAPICallResult(HSteamPipe hSteamPipe, SteamAPICall_t hSteamAPICall, void *pCallback, int cubCallback, int iCallbackExpected, bool *pbFailed)
+{
+	return StandIn_GetAPICallResult(hSteamPipe, hSteamAPICall, pCallback, cubCallback, iCallbackExpected, pbFailed);
+}
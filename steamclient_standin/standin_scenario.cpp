@@ -0,0 +1,338 @@
+//========= Copyright  1996-2001, Valve LLC, All rights reserved. ============
+//
+// Purpose: Scenario file parser of the steamclient stand-in.
+//
+// $NoKeywords: $
+//=============================================================================
+
+#include "steam_api_pch.h"
+#include "standin.h"
+
+#include <mutex>
+
+static StandInScenario_t	s_Scenario;
+static bool					s_bScenarioLoaded = false;
+static bool					s_bScenarioValid = false;
+static std::mutex			s_ScenarioLock;
+
+//-----------------------------------------------------------------------------
+// Purpose: Reports a malformed line of the scenario file
+//-----------------------------------------------------------------------------
+static bool ScenarioError(const char *pszPath, int nLine, const char *pszReason)
+{
+	char DebugBuffer[1024];
+
+	snprintf(DebugBuffer, sizeof(DebugBuffer), "[S_API FAIL] steamclient stand-in: %s:%d: %s\n", pszPath, nLine, pszReason);
+	OutputDebugStringA(DebugBuffer);
+
+	return false;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Parses a non-negative number, returns false if the token isn't one
+//-----------------------------------------------------------------------------
+static bool ParseNumber(const char *pszToken, double *pflValue)
+{
+	char* pszEnd;
+
+	if (!pszToken)
+		return false;
+
+	*pflValue = strtod(pszToken, &pszEnd);
+
+	return pszEnd != pszToken && *pszEnd == '\0' && *pflValue >= 0.0;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Parses an integer, returns false if the token isn't one
+//-----------------------------------------------------------------------------
+static bool ParseInteger(const char *pszToken, uint64 *pulValue)
+{
+	char* pszEnd;
+
+	if (!pszToken || *pszToken == '-')
+		return false;
+
+	*pulValue = strtoull(pszToken, &pszEnd, 0);
+
+	return pszEnd != pszToken && *pszEnd == '\0';
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Parses "callback <iCallback> rate <per second> size <bytes> ..."
+//-----------------------------------------------------------------------------
+static bool ParseCallbackRule(char **ppszContext, StandInCallbackRule_t *pRule)
+{
+	const char*	pszKey;
+	const char*	pszValue;
+	uint64		ulValue;
+	bool		bRate;
+	bool		bSize;
+
+	if (!ParseInteger(strtok_r(nullptr, " \t", ppszContext), &ulValue) || ulValue > INT_MAX)
+		return false;
+
+	pRule->m_iCallback = (int)ulValue;
+	pRule->m_flStart = 0.0;
+	pRule->m_flStop = 0.0;
+	pRule->m_ePipeKind = k_EStandInPipeAny;
+
+	bRate = false;
+	bSize = false;
+
+	while ((pszKey = strtok_r(nullptr, " \t", ppszContext)) != nullptr)
+	{
+		pszValue = strtok_r(nullptr, " \t", ppszContext);
+
+		if (!strcmp(pszKey, "rate"))
+		{
+			if (!ParseNumber(pszValue, &pRule->m_flRate))
+				return false;
+
+			bRate = true;
+		}
+		else if (!strcmp(pszKey, "size"))
+		{
+			if (!ParseInteger(pszValue, &ulValue) || ulValue > INT_MAX)
+				return false;
+
+			pRule->m_cubParam = (int)ulValue;
+			bSize = true;
+		}
+		else if (!strcmp(pszKey, "pipe"))
+		{
+			if (pszValue && !strcmp(pszValue, "client"))
+				pRule->m_ePipeKind = k_EStandInPipeClient;
+			else if (pszValue && !strcmp(pszValue, "gameserver"))
+				pRule->m_ePipeKind = k_EStandInPipeGameServer;
+			else
+				return false;
+		}
+		else if (!strcmp(pszKey, "start"))
+		{
+			if (!ParseNumber(pszValue, &pRule->m_flStart))
+				return false;
+		}
+		else if (!strcmp(pszKey, "stop"))
+		{
+			if (!ParseNumber(pszValue, &pRule->m_flStop))
+				return false;
+		}
+		else
+		{
+			return false;
+		}
+	}
+
+	if (pRule->m_flStop && pRule->m_flStop <= pRule->m_flStart)
+		return false;
+
+	return bRate && bSize;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Parses "callresult <method> <iCallback> size <bytes> delay <ms>..."
+//-----------------------------------------------------------------------------
+static bool ParseCallResultRule(char **ppszContext, StandInCallResultRule_t *pRule)
+{
+	const char*	pszKey;
+	char*		pszValue;
+	const char*	pszMethod;
+	char*		pszMaxDelay;
+	uint64		ulValue;
+	bool		bSize;
+	bool		bDelay;
+
+	pszMethod = strtok_r(nullptr, " \t", ppszContext);
+	if (!pszMethod || strlen(pszMethod) >= sizeof(pRule->m_szMethod))
+		return false;
+
+	snprintf(pRule->m_szMethod, sizeof(pRule->m_szMethod), "%s", pszMethod);
+
+	if (!ParseInteger(strtok_r(nullptr, " \t", ppszContext), &ulValue) || ulValue > INT_MAX)
+		return false;
+
+	pRule->m_iCallback = (int)ulValue;
+	pRule->m_flFailRate = 0.0;
+
+	bSize = false;
+	bDelay = false;
+
+	while ((pszKey = strtok_r(nullptr, " \t", ppszContext)) != nullptr)
+	{
+		pszValue = strtok_r(nullptr, " \t", ppszContext);
+
+		if (!strcmp(pszKey, "size"))
+		{
+			if (!ParseInteger(pszValue, &ulValue) || ulValue > INT_MAX)
+				return false;
+
+			pRule->m_cubParam = (int)ulValue;
+			bSize = true;
+		}
+		else if (!strcmp(pszKey, "delay"))
+		{
+			if (!pszValue)
+				return false;
+
+			// Either a single value or a range
+			pszMaxDelay = strchr(pszValue, '-');
+			if (pszMaxDelay)
+				*pszMaxDelay++ = '\0';
+
+			if (!ParseInteger(pszValue, &ulValue) || ulValue > UINT32_MAX)
+				return false;
+
+			pRule->m_unMinDelayMs = (uint32)ulValue;
+			pRule->m_unMaxDelayMs = (uint32)ulValue;
+
+			if (pszMaxDelay)
+			{
+				if (!ParseInteger(pszMaxDelay, &ulValue) || ulValue > UINT32_MAX || ulValue < pRule->m_unMinDelayMs)
+					return false;
+
+				pRule->m_unMaxDelayMs = (uint32)ulValue;
+			}
+
+			bDelay = true;
+		}
+		else if (!strcmp(pszKey, "fail"))
+		{
+			if (!ParseNumber(pszValue, &pRule->m_flFailRate) || pRule->m_flFailRate > 1.0)
+				return false;
+		}
+		else
+		{
+			return false;
+		}
+	}
+
+	return bSize && bDelay;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Reads the scenario file, reports the first malformed line and
+//			returns false if there's one.
+//-----------------------------------------------------------------------------
+bool StandIn_ParseScenario(const char *pszPath, StandInScenario_t *pScenario)
+{
+	char		szLine[1024];
+	char*		pszContext;
+	char*		pszComment;
+	const char*	pszKeyword;
+	const char*	pszValue;
+	FILE*		pFile;
+	uint64		ulValue;
+	int			nLine;
+	bool		bValid;
+
+	pFile = fopen(pszPath, "r");
+	if (!pFile)
+		return ScenarioError(pszPath, 0, "can't be opened");
+
+	bValid = true;
+	nLine = 0;
+
+	while (bValid && fgets(szLine, sizeof(szLine), pFile))
+	{
+		nLine++;
+
+		szLine[strcspn(szLine, "\r\n")] = '\0';
+
+		pszComment = strchr(szLine, '#');
+		if (pszComment)
+			*pszComment = '\0';
+
+		pszKeyword = strtok_r(szLine, " \t", &pszContext);
+		if (!pszKeyword)
+			continue;
+
+		if (!strcmp(pszKeyword, "appid"))
+		{
+			if (!ParseInteger(strtok_r(nullptr, " \t", &pszContext), &ulValue) || ulValue > UINT32_MAX)
+				bValid = ScenarioError(pszPath, nLine, "appid expects an AppId");
+			else
+				pScenario->m_nAppID = (AppId_t)ulValue;
+		}
+		else if (!strcmp(pszKeyword, "steamid"))
+		{
+			if (!ParseInteger(strtok_r(nullptr, " \t", &pszContext), &pScenario->m_ulSteamID))
+				bValid = ScenarioError(pszPath, nLine, "steamid expects a 64-bit SteamID");
+		}
+		else if (!strcmp(pszKeyword, "seed"))
+		{
+			if (!ParseInteger(strtok_r(nullptr, " \t", &pszContext), &ulValue) || ulValue > UINT32_MAX)
+				bValid = ScenarioError(pszPath, nLine, "seed expects a 32-bit number");
+			else
+				pScenario->m_unSeed = (uint32)ulValue;
+		}
+		else if (!strcmp(pszKeyword, "callback"))
+		{
+			if (pScenario->m_cCallbacks == MAX_STANDIN_CALLBACK_RULES)
+				bValid = ScenarioError(pszPath, nLine, "too many callback entries");
+			else if (!ParseCallbackRule(&pszContext, &pScenario->m_rgCallbacks[pScenario->m_cCallbacks]))
+				bValid = ScenarioError(pszPath, nLine, "expected callback <iCallback> rate <per second> size <bytes> [pipe client|gameserver] [start <seconds>] [stop <seconds>]");
+			else
+				pScenario->m_cCallbacks++;
+		}
+		else if (!strcmp(pszKeyword, "callresult"))
+		{
+			if (pScenario->m_cCallResults == MAX_STANDIN_CALLRESULT_RULES)
+				bValid = ScenarioError(pszPath, nLine, "too many callresult entries");
+			else if (!ParseCallResultRule(&pszContext, &pScenario->m_rgCallResults[pScenario->m_cCallResults]))
+				bValid = ScenarioError(pszPath, nLine, "expected callresult <method> <iCallback> size <bytes> delay <ms>[-<ms>] [fail <fraction>]");
+			else
+				pScenario->m_cCallResults++;
+		}
+		else
+		{
+			bValid = ScenarioError(pszPath, nLine, "unknown keyword");
+		}
+
+		// Values left over
+		pszValue = strtok_r(nullptr, " \t", &pszContext);
+		if (bValid && pszValue)
+			bValid = ScenarioError(pszPath, nLine, "unexpected value");
+	}
+
+	fclose(pFile);
+
+	return bValid;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Loads the scenario named by STANDIN_SCENARIO_ENV, once. Returns
+//			false if the file is broken, the client isn't handed out then.
+//-----------------------------------------------------------------------------
+bool StandIn_LoadScenario()
+{
+	const char* pszPath;
+	const char* pszAppID;
+
+	std::lock_guard<std::mutex> Lock(s_ScenarioLock);
+
+	if (s_bScenarioLoaded)
+		return s_bScenarioValid;
+
+	memset(&s_Scenario, 0, sizeof(s_Scenario));
+	s_Scenario.m_unSeed = 1;
+
+	pszAppID = getenv("SteamAppId");
+	if (pszAppID)
+		s_Scenario.m_nAppID = (AppId_t)strtoul(pszAppID, nullptr, 10);
+
+	pszPath = getenv(STANDIN_SCENARIO_ENV);
+
+	s_bScenarioValid = !pszPath || !*pszPath || StandIn_ParseScenario(pszPath, &s_Scenario);
+	s_bScenarioLoaded = true;
+
+	return s_bScenarioValid;
+}
+
+//-----------------------------------------------------------------------------
+// Purpose: Scenario being replayed, valid once StandIn_LoadScenario() succeeded
+//-----------------------------------------------------------------------------
+const StandInScenario_t* StandIn_GetScenario()
+{
+	return &s_Scenario;
+}